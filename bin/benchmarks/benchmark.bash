@@ -122,6 +122,46 @@ echo "   Started benchmark for potentials ..."
 potentials_perf=$(benchmark_run potentials $DECAYM_DEF $PART_DEF)
 echo "$potentials_perf" | grep -E "time elapsed"
 
+echo "   Started benchmark for Pauli blocking ..."
+pauli_perf=$(benchmark_run pauli_blocking $DECAYM_DEF $PART_DEF)
+echo "$pauli_perf" | grep -E "time elapsed"
+
+echo "   Started benchmark for lattice densities ..."
+lattice_perf=""
+lattice_time_1=""
+for threads in 1 2 4 8; do
+  perf_out=$(benchmark_run lattice $DECAYM_DEF $PART_DEF "Lattice: { Threads: ${threads} }")
+  time_elapsed=$(echo "$perf_out" | grep -E "time elapsed" | awk '{print $1}')
+  if [[ -z $lattice_time_1 ]]; then
+    lattice_time_1=$time_elapsed
+  fi
+  speedup=$(awk -v t1="$lattice_time_1" -v t="$time_elapsed" 'BEGIN {printf "%.2f", t1 / t}')
+  echo "      ${threads} threads: ${time_elapsed} s, speedup ${speedup}"
+  lattice_perf+="${threads} threads: ${time_elapsed} s elapsed, speedup ${speedup}"$'\n'
+done
+
+echo "   Started benchmark for the hadron gas EoS table ..."
+# The table file is removed before each run, such that the table is compiled
+rm -f eos_table.log
+eos_perf=$(perf stat -B -r3 --pre "rm -f hadgas_eos.bin" \
+           ./smash \
+           -i ${SCRIPTPATH}/configs/eos_table/config.yaml \
+           -d ${DECAYM_DEF}/decaymodes.txt \
+           -p ${PART_DEF}/particles.txt \
+           2>&1 >>eos_table.log)
+rm -f hadgas_eos.bin
+eos_time=$(echo "$eos_perf" | grep -E "time elapsed" | awk '{print $1}')
+# The rate only counts the points of the table, for which the EoS is solved,
+# and the time spent compiling the table, which SMASH logs for every run
+eos_rate=$(awk '/^Compiled EoS table:/ {n += $4; t += $7}
+                END {printf "%.0f", n / t}' eos_table.log)
+rm -f eos_table.log
+echo "      ${eos_time} s, ${eos_rate} EoS solutions per second"
+
+echo "   Started benchmark for OSCAR output ..."
+oscar_perf=$(benchmark_run oscar_output $DECAYM_DEF $PART_DEF)
+echo "$oscar_perf" | grep -E "time elapsed"
+
 echo "   Started benchmark for high-energy collisions ..."
 high_energy_perf=$(benchmark_run high_energy $DECAYM_DEF $PART_DEF)
 echo "$high_energy_perf" | grep -E "time elapsed"
@@ -199,6 +239,39 @@ Same setup as with Testparticles, but also with potentials.
 $potentials_perf
 \`\`\`
 
+### Pauli Blocking Run (AuAu@0.6)
+20 testparticles, default Pauli blocking parameters.
+\`\`\`
+$pauli_perf
+\`\`\`
+
+### Lattice Densities (CuCu@1.23)
+Same setup as Potentials Run, but without collisions, such that the lattice
+densities dominate. Speedup of the run versus the number of
+\`Lattice: Threads\`.
+\`\`\`
+$lattice_perf
+\`\`\`
+
+### Hadron Gas EoS Table
+Short collider run with forced thermalization, such that the compilation of
+the equation of state table with all hardware threads dominates. The table
+has 90 x 90 x 90 entries, of which the equation of state is solved for the
+physical ones. Counting only these and the time of the table compilation
+gives ${eos_rate} EoS solutions per second.
+\`\`\`
+$eos_perf
+\`\`\`
+
+### OSCAR Output Run (AuAu@1.23)
+Particles written every 0.5 fm in the OSCAR2013 and OSCAR1999 formats and
+the extended OSCAR2013 collisions output, such that formatting the output
+dominates. Compare the results of two SMASH versions to compare the
+formatting.
+\`\`\`
+$oscar_perf
+\`\`\`
+
 ### High-energy collision Run
 \`\`\`
 $high_energy_perf
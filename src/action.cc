@@ -33,6 +33,26 @@ bool Action::is_valid(const Particles &particles) const {
 
 bool Action::is_pauli_blocked(const std::vector<Particles> &ensembles,
                               const PauliBlocker &p_bl) const {
+  return is_pauli_blocked([&](const ParticleData &p) {
+    return p_bl.phasespace_dens(p.position().threevec(),
+                                p.momentum().threevec(), ensembles,
+                                p.pdgcode(), incoming_particles_);
+  });
+}
+
+bool Action::is_pauli_blocked(const Particles &own_ensemble,
+                              int i_own_ensemble,
+                              const std::vector<ParticleList> &frozen_ensembles,
+                              const PauliBlocker &p_bl) const {
+  return is_pauli_blocked([&](const ParticleData &p) {
+    return p_bl.phasespace_dens(
+        p.position().threevec(), p.momentum().threevec(), own_ensemble,
+        i_own_ensemble, frozen_ensembles, p.pdgcode(), incoming_particles_);
+  });
+}
+
+bool Action::is_pauli_blocked(
+    const std::function<double(const ParticleData &)> &phasespace_dens) const {
   // Wall-crossing actions should never be blocked: currently
   // if the action is blocked, a particle continues to propagate in a straight
   // line. This would simply bring it out of the box.
@@ -41,9 +61,7 @@ bool Action::is_pauli_blocked(const std::vector<Particles> &ensembles,
   }
   for (const auto &p : outgoing_particles_) {
     if (p.is_baryon()) {
-      const auto f =
-          p_bl.phasespace_dens(p.position().threevec(), p.momentum().threevec(),
-                               ensembles, p.pdgcode(), incoming_particles_);
+      const auto f = phasespace_dens(p);
       if (f > random::uniform(0., 1.)) {
         logg[LPauliBlocking].debug("Action ", *this,
                                    " is pauli-blocked with f = ", f);
@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/actionarena.h"
+
+#include <new>
+
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LAction = LogArea::Action::id;
+
+constexpr std::size_t ActionArena::block_size;
+constexpr std::size_t ActionArena::max_object_size;
+
+struct alignas(std::max_align_t) ActionArena::Header {
+  /// Arena of the object, nullptr if it is allocated on the heap
+  ActionArena *arena;
+  /// Size of the object plus its header [bytes]
+  std::size_t size;
+};
+
+namespace {
+/// The arena used for allocations in this thread, nullptr for the heap
+thread_local ActionArena *current_arena = nullptr;
+
+/**
+ * \param[in] size Number of bytes.
+ * \return The smallest multiple of the alignment of all types, which is not
+ *         smaller than the given size.
+ */
+constexpr std::size_t round_up(std::size_t size) {
+  return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+         alignof(std::max_align_t);
+}
+}  // unnamed namespace
+
+ActionArena::Scope::Scope(ActionArena *arena) : previous_(current_arena) {
+  current_arena = arena;
+}
+
+ActionArena::Scope::~Scope() { current_arena = previous_; }
+
+void ActionArena::release() {
+  if (stats_.allocations > 0) {
+    logg[LAction].debug("Action arena: ", stats_.allocations, " allocations (",
+                        stats_.reused, " reused) with ", stats_.bytes,
+                        " bytes, capacity ", capacity(), " bytes");
+  }
+  current_block_ = 0;
+  offset_ = 0;
+  free_lists_.assign(free_lists_.size(), nullptr);
+  stats_ = Stats();
+}
+
+void *ActionArena::allocate(std::size_t size) {
+  const std::size_t total = round_up(size) + sizeof(Header);
+  Header *header;
+  if (current_arena != nullptr && total <= max_object_size) {
+    header = current_arena->take(total);
+    header->arena = current_arena;
+  } else {
+    header = static_cast<Header *>(::operator new(total));
+    header->arena = nullptr;
+  }
+  header->size = total;
+  return header + 1;
+}
+
+void ActionArena::deallocate(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  Header *header = static_cast<Header *>(ptr) - 1;
+  if (header->arena != nullptr) {
+    header->arena->recycle(header);
+  } else {
+    ::operator delete(header);
+  }
+}
+
+ActionArena::Header *ActionArena::take(std::size_t total) {
+  stats_.allocations++;
+  stats_.bytes += total;
+  const std::size_t size_class = total / alignof(std::max_align_t);
+  if (size_class < free_lists_.size() && free_lists_[size_class] != nullptr) {
+    Header *header = free_lists_[size_class];
+    // The next free object is stored in place of the freed object
+    free_lists_[size_class] = *reinterpret_cast<Header **>(header + 1);
+    stats_.reused++;
+    return header;
+  }
+  if (blocks_.empty() || offset_ + total > block_size) {
+    if (!blocks_.empty()) {
+      current_block_++;
+    }
+    if (current_block_ == blocks_.size()) {
+      blocks_.emplace_back(new char[block_size]);
+    }
+    offset_ = 0;
+  }
+  char *memory = blocks_[current_block_].get() + offset_;
+  offset_ += total;
+  return reinterpret_cast<Header *>(memory);
+}
+
+void ActionArena::recycle(Header *header) {
+  const std::size_t size_class = header->size / alignof(std::max_align_t);
+  if (size_class >= free_lists_.size()) {
+    free_lists_.resize(size_class + 1, nullptr);
+  }
+  *reinterpret_cast<Header **>(header + 1) = free_lists_[size_class];
+  free_lists_[size_class] = header;
+}
+
+}  // namespace smash
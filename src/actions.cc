@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/actions.h"
+
+#include "smash/particles.h"
+
+namespace smash {
+
+constexpr double Actions::compaction_threshold;
+constexpr std::size_t Actions::min_compaction_size;
+
+ActionPtr Actions::pop() {
+  if (data_.empty()) {
+    throw std::runtime_error("Empty actions list!");
+  }
+  std::pop_heap(data_.begin(), data_.end(), cmp);
+  Entry entry = std::move(data_.back());
+  data_.pop_back();
+  free_slot(entry.slot);
+  drop_invalidated_top();
+  return std::move(entry.action);
+}
+
+std::size_t Actions::invalidate(const ParticleList& incoming,
+                                const Particles& particles,
+                                double count_until) {
+  std::size_t n_invalidated = 0, n_counted = 0;
+  for (const ParticleData& p : incoming) {
+    if (particles.is_valid(p)) {
+      continue;
+    }
+    const auto found = index_.find(p.id());
+    if (found == index_.end()) {
+      continue;
+    }
+    for (const SlotRef& ref : found->second) {
+      Slot& slot = slots_[ref.slot];
+      if (slot.generation == ref.generation && !slot.invalidated) {
+        slot.invalidated = true;
+        n_invalidated++;
+        if (slot.time <= count_until) {
+          n_counted++;
+        }
+      }
+    }
+    index_.erase(found);
+  }
+  n_invalidated_ += n_invalidated;
+  stats_.invalidated += n_invalidated;
+  drop_invalidated_top();
+  if (n_invalidated_ >= min_compaction_size &&
+      n_invalidated_ > compaction_threshold * data_.size()) {
+    compact();
+  }
+  return n_counted;
+}
+
+void Actions::compact() {
+  if (n_invalidated_ == 0) {
+    return;
+  }
+  const auto end =
+      std::remove_if(data_.begin(), data_.end(), [this](const Entry& entry) {
+        if (slots_[entry.slot].invalidated) {
+          free_slot(entry.slot);
+          return true;
+        }
+        return false;
+      });
+  data_.erase(end, data_.end());
+  std::make_heap(data_.begin(), data_.end(), cmp);
+  stats_.compactions++;
+}
+
+void Actions::clear() {
+  data_.clear();
+  slots_.clear();
+  free_slots_.clear();
+  index_.clear();
+  n_invalidated_ = 0;
+  stats_ = Stats();
+  if (arena_) {
+    arena_->release();
+  }
+}
+
+void Actions::push_back(ActionPtr&& action) {
+  std::uint32_t slot;
+  if (free_slots_.empty()) {
+    slot = static_cast<std::uint32_t>(slots_.size());
+    slots_.emplace_back();
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  slots_[slot].time = action->time_of_execution();
+  const SlotRef ref{slot, slots_[slot].generation};
+  for (const ParticleData& p : action->incoming_particles()) {
+    index_[p.id()].push_back(ref);
+  }
+  data_.push_back(Entry{std::move(action), slot});
+  stats_.inserted++;
+  stats_.max_heap_size = std::max(stats_.max_heap_size, data_.size());
+}
+
+void Actions::free_slot(std::uint32_t slot) {
+  Slot& state = slots_[slot];
+  if (state.invalidated) {
+    state.invalidated = false;
+    n_invalidated_--;
+  }
+  state.generation++;
+  free_slots_.push_back(slot);
+}
+
+void Actions::drop_invalidated_top() {
+  while (!data_.empty() && slots_[data_.front().slot].invalidated) {
+    std::pop_heap(data_.begin(), data_.end(), cmp);
+    free_slot(data_.back().slot);
+    data_.pop_back();
+  }
+}
+
+}  // namespace smash
@@ -0,0 +1,220 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/asciibuffer.h"
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace smash {
+
+constexpr std::size_t AsciiBuffer::capacity;
+
+namespace {
+/// Powers of ten, which are exactly representable as doubles
+constexpr double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+/// Largest exponent in exact_powers_of_ten
+constexpr int max_exact_exponent = 22;
+/// Largest precision of the fast path of format_g
+constexpr int max_fast_precision = 9;
+/**
+ * Fractional parts closer to 0.5 are not rounded by format_g, since the
+ * rounding error of the scaling (at most 10^9 * 2^-53) could change the
+ * result.
+ */
+constexpr double rounding_margin = 1e-6;
+
+/**
+ * Write the decimal digits of a number.
+ *
+ * \param[in] n The number.
+ * \param[out] out Memory for the digits.
+ * \return Pointer behind the last digit.
+ */
+char *write_digits(std::uint64_t n, char *out) {
+  char digits[20];
+  int length = 0;
+  do {
+    digits[length++] = static_cast<char>('0' + n % 10);
+    n /= 10;
+  } while (n > 0);
+  while (length > 0) {
+    *out++ = digits[--length];
+  }
+  return out;
+}
+
+/**
+ * \param[in] x A positive number.
+ * \param[in] k Exponent with |k| <= max_exact_exponent.
+ * \return x * 10^k with a single rounding.
+ */
+double scale(double x, int k) {
+  return k >= 0 ? x * exact_powers_of_ten[k] : x / exact_powers_of_ten[-k];
+}
+
+/// Slow path of format_g, see there.
+char *printf_g(double x, int precision, char *out) {
+  return out + std::snprintf(out, max_formatted_length, "%.*g", precision, x);
+}
+}  // unnamed namespace
+
+char *format_g(double x, int precision, char *out) {
+  if (precision == 0) {
+    precision = 1;
+  }
+  if (x == 0.) {
+    if (std::signbit(x)) {
+      *out++ = '-';
+    }
+    *out++ = '0';
+    return out;
+  }
+  const double ax = std::abs(x);
+  int exponent = 0;
+  std::frexp(ax, &exponent);
+  // floor(log10(ax)) is either this estimate or the next larger integer
+  int e = static_cast<int>(std::floor((exponent - 1) * 0.30102999566398120));
+  const bool fast = std::isfinite(x) && precision > 0 &&
+                    precision <= max_fast_precision &&
+                    std::abs(precision - 1 - e) < max_exact_exponent;
+  if (!fast) {
+    return printf_g(x, precision, out);
+  }
+  double m = scale(ax, precision - 1 - e);
+  if (m >= exact_powers_of_ten[precision]) {
+    e++;
+    m = scale(ax, precision - 1 - e);
+  }
+  const double integral = std::floor(m);
+  const double fraction = m - integral;
+  if (std::abs(fraction - 0.5) < rounding_margin) {
+    return printf_g(x, precision, out);
+  }
+  std::uint64_t n = static_cast<std::uint64_t>(integral) + (fraction > 0.5);
+  if (n == static_cast<std::uint64_t>(exact_powers_of_ten[precision])) {
+    n /= 10;
+    e++;
+  } else if (n < static_cast<std::uint64_t>(
+                     exact_powers_of_ten[precision - 1])) {
+    return printf_g(x, precision, out);
+  }
+
+  char digits[max_fast_precision];
+  write_digits(n, digits);
+  // Trailing zeros are removed, as for %g
+  int n_digits = precision;
+  while (n_digits > 1 && digits[n_digits - 1] == '0') {
+    n_digits--;
+  }
+
+  if (std::signbit(x)) {
+    *out++ = '-';
+  }
+  if (e < -4 || e >= precision) {
+    *out++ = digits[0];
+    if (n_digits > 1) {
+      *out++ = '.';
+      std::memcpy(out, digits + 1, n_digits - 1);
+      out += n_digits - 1;
+    }
+    *out++ = 'e';
+    *out++ = e < 0 ? '-' : '+';
+    const int abs_e = std::abs(e);
+    if (abs_e < 10) {
+      *out++ = '0';
+    }
+    out = write_digits(abs_e, out);
+  } else if (e >= 0) {
+    std::memcpy(out, digits, e + 1);
+    out += e + 1;
+    if (n_digits > e + 1) {
+      *out++ = '.';
+      std::memcpy(out, digits + e + 1, n_digits - e - 1);
+      out += n_digits - e - 1;
+    }
+  } else {
+    *out++ = '0';
+    *out++ = '.';
+    for (int i = 0; i < -e - 1; i++) {
+      *out++ = '0';
+    }
+    std::memcpy(out, digits, n_digits);
+    out += n_digits;
+  }
+  return out;
+}
+
+char *format_int(int x, char *out) {
+  std::int64_t n = x;
+  if (n < 0) {
+    *out++ = '-';
+    n = -n;
+  }
+  return write_digits(static_cast<std::uint64_t>(n), out);
+}
+
+AsciiBuffer::AsciiBuffer(std::FILE *file)
+    : file_(file), data_(new char[capacity]) {}
+
+AsciiBuffer::~AsciiBuffer() { write_out(); }
+
+void AsciiBuffer::append(const std::string &s) {
+  if (s.size() > capacity) {
+    write_out();
+    std::fwrite(s.data(), 1, s.size(), file_);
+    return;
+  }
+  std::memcpy(reserve(s.size()), s.data(), s.size());
+  size_ += s.size();
+}
+
+void AsciiBuffer::printf(const char *format, ...) {
+  std::va_list args;
+  va_start(args, format);
+  std::va_list args_copy;
+  va_copy(args_copy, args);
+  std::size_t available = capacity - size_;
+  int length = std::vsnprintf(data_.get() + size_, available, format, args);
+  va_end(args);
+  if (length >= 0 && static_cast<std::size_t>(length) >= available) {
+    write_out();
+    if (static_cast<std::size_t>(length) < capacity) {
+      std::vsnprintf(data_.get(), capacity, format, args_copy);
+    } else {
+      std::vector<char> text(length + 1);
+      std::vsnprintf(text.data(), text.size(), format, args_copy);
+      std::fwrite(text.data(), 1, length, file_);
+      length = 0;
+    }
+  }
+  va_end(args_copy);
+  if (length > 0) {
+    size_ += length;
+  }
+}
+
+void AsciiBuffer::flush() {
+  write_out();
+  std::fflush(file_);
+}
+
+void AsciiBuffer::write_out() {
+  if (size_ > 0) {
+    std::fwrite(data_.get(), 1, size_, file_);
+    size_ = 0;
+  }
+}
+
+}  // namespace smash
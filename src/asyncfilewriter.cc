@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/asyncfilewriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LOutput = LogArea::Output::id;
+
+constexpr std::size_t AsyncFileWriter::default_block_size;
+constexpr std::size_t AsyncFileWriter::default_max_pending_blocks;
+
+AsyncFileWriter::AsyncFileWriter(std::FILE *file, std::size_t block_size,
+                                 std::size_t max_pending_blocks)
+    : file_(file),
+      block_size_(block_size),
+      max_pending_blocks_(max_pending_blocks) {
+  if (block_size_ == 0 || max_pending_blocks_ == 0) {
+    throw std::invalid_argument(
+        "AsyncFileWriter needs a positive block size and number of blocks.");
+  }
+  current_.reserve(block_size_);
+  thread_ = std::thread(&AsyncFileWriter::writer_loop, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  try {
+    sync();
+  } catch (const std::exception &e) {
+    logg[LOutput].error(e.what());
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_condition_.notify_one();
+  thread_.join();
+}
+
+void AsyncFileWriter::flush() { submit(true); }
+
+void AsyncFileWriter::sync() {
+  submit(true);
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_condition_.wait(lock,
+                          [this] { return pending_.empty() && !busy_; });
+  rethrow_error();
+}
+
+void AsyncFileWriter::write_across_blocks(const void *data,
+                                          std::size_t size) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    if (current_.size() == block_size_) {
+      submit(false);
+    }
+    const std::size_t n = std::min(size, block_size_ - current_.size());
+    current_.insert(current_.end(), bytes, bytes + n);
+    bytes += n;
+    size -= n;
+  }
+}
+
+void AsyncFileWriter::submit(bool flush) {
+  std::vector<char> next;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_condition_.wait(lock, [this] {
+      return pending_.size() < max_pending_blocks_ || error_;
+    });
+    rethrow_error();
+    pending_.push_back({std::move(current_), flush});
+    if (!spare_.empty()) {
+      next = std::move(spare_.back());
+      spare_.pop_back();
+    }
+  }
+  work_condition_.notify_one();
+  current_ = std::move(next);
+  current_.reserve(block_size_);
+}
+
+void AsyncFileWriter::rethrow_error() {
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncFileWriter::writer_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_condition_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+    Block block = std::move(pending_.front());
+    pending_.pop_front();
+    busy_ = true;
+    lock.unlock();
+    const std::size_t size = block.data.size();
+    const bool written =
+        std::fwrite(block.data.data(), 1, size, file_) == size &&
+        (!block.flush || std::fflush(file_) == 0);
+    block.data.clear();
+    lock.lock();
+    busy_ = false;
+    if (!written && !error_) {
+      error_ = std::make_exception_ptr(
+          std::runtime_error("Writing to an output file failed."));
+    }
+    spare_.push_back(std::move(block.data));
+    written_condition_.notify_all();
+  }
+}
+
+}  // namespace smash
@@ -135,31 +135,22 @@ BinaryOutputBase::BinaryOutputBase(const bf::path &path,
                                    const std::string &mode,
                                    const std::string &name,
                                    bool extended_format)
-    : OutputInterface(name), file_{path, mode}, extended_(extended_format) {
-  std::fwrite("SMSH", 4, 1, file_.get());  // magic number
-  write(format_version_);                  // file format version number
+    : OutputInterface(name),
+      file_{path, mode},
+      writer_(file_.get()),
+      extended_(extended_format) {
+  writer_.write("SMSH", 4);  // magic number
+  write(format_version_);    // file format version number
   std::uint16_t format_variant = static_cast<uint16_t>(extended_);
   write(format_variant);
   write(SMASH_VERSION);
 }
 
 // write functions:
-void BinaryOutputBase::write(const char c) {
-  std::fwrite(&c, sizeof(char), 1, file_.get());
-}
-
 void BinaryOutputBase::write(const std::string &s) {
   const auto size = boost::numeric_cast<uint32_t>(s.size());
-  std::fwrite(&size, sizeof(std::uint32_t), 1, file_.get());
-  std::fwrite(s.c_str(), s.size(), 1, file_.get());
-}
-
-void BinaryOutputBase::write(const double x) {
-  std::fwrite(&x, sizeof(x), 1, file_.get());
-}
-
-void BinaryOutputBase::write(const FourVector &v) {
-  std::fwrite(v.begin(), sizeof(*v.begin()), 4, file_.get());
+  write(size);
+  writer_.write(s.c_str(), s.size());
 }
 
 void BinaryOutputBase::write(const Particles &particles) {
@@ -176,8 +167,7 @@ void BinaryOutputBase::write(const ParticleList &particles) {
 
 void BinaryOutputBase::write_particledata(const ParticleData &p) {
   write(p.position());
-  double mass = p.effective_mass();
-  std::fwrite(&mass, sizeof(mass), 1, file_.get());
+  write(p.effective_mass());
   write(p.momentum());
   write(p.pdgcode().get_decimal());
   write(p.id());
@@ -195,6 +185,19 @@ void BinaryOutputBase::write_particledata(const ParticleData &p) {
   }
 }
 
+void BinaryOutputBase::write_event_end(const int32_t event_number,
+                                       const EventInfo &event) {
+  const char fchar = 'f';
+  write(fchar);
+  write(event_number);
+  write(event.impact_parameter);
+  const char empty = event.empty_event;
+  write(empty);
+
+  // Flush to disk
+  writer_.flush();
+}
+
 BinaryOutputCollisions::BinaryOutputCollisions(const bf::path &path,
                                                std::string name,
                                                const OutputParameters &out_par)
@@ -207,7 +210,7 @@ void BinaryOutputCollisions::at_eventstart(const Particles &particles,
                                            const int, const EventInfo &) {
   const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
@@ -218,36 +221,25 @@ void BinaryOutputCollisions::at_eventend(const Particles &particles,
                                          const EventInfo &event) {
   const char pchar = 'p';
   if (print_start_end_) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
 
   // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
-  write(event_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
-
-  // Flush to disk
-  std::fflush(file_.get());
+  write_event_end(event_number, event);
 }
 
 void BinaryOutputCollisions::at_interaction(const Action &action,
                                             const double density) {
   const char ichar = 'i';
-  std::fwrite(&ichar, sizeof(char), 1, file_.get());
+  write(ichar);
   write(action.incoming_particles().size());
   write(action.outgoing_particles().size());
-  std::fwrite(&density, sizeof(double), 1, file_.get());
-  const double weight = action.get_total_weight();
-  std::fwrite(&weight, sizeof(double), 1, file_.get());
-  const double partial_weight = action.get_partial_weight();
-  std::fwrite(&partial_weight, sizeof(double), 1, file_.get());
-  const auto type = static_cast<uint32_t>(action.get_type());
-  std::fwrite(&type, sizeof(uint32_t), 1, file_.get());
+  write(density);
+  write(action.get_total_weight());
+  write(action.get_partial_weight());
+  write(static_cast<uint32_t>(action.get_type()));
   write(action.incoming_particles());
   write(action.outgoing_particles());
 }
@@ -263,7 +255,7 @@ void BinaryOutputParticles::at_eventstart(const Particles &particles, const int,
                                           const EventInfo &) {
   const char pchar = 'p';
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
@@ -274,21 +266,13 @@ void BinaryOutputParticles::at_eventend(const Particles &particles,
                                         const EventInfo &event) {
   const char pchar = 'p';
   if (!(event.empty_event && only_final_ == OutputOnlyFinal::IfNotEmpty)) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
 
   // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
-  write(event_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
-
-  // Flush to disk
-  std::fflush(file_.get());
+  write_event_end(event_number, event);
 }
 
 void BinaryOutputParticles::at_intermediate_time(const Particles &particles,
@@ -297,7 +281,7 @@ void BinaryOutputParticles::at_intermediate_time(const Particles &particles,
                                                  const EventInfo &) {
   const char pchar = 'p';
   if (only_final_ == OutputOnlyFinal::No) {
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(particles.size());
     write(particles);
   }
@@ -315,15 +299,7 @@ void BinaryOutputInitialConditions::at_eventend(const Particles &particles,
                                                 const int event_number,
                                                 const EventInfo &event) {
   // Event end line
-  const char fchar = 'f';
-  std::fwrite(&fchar, sizeof(char), 1, file_.get());
-  write(event_number);
-  write(event.impact_parameter);
-  const char empty = event.empty_event;
-  write(empty);
-
-  // Flush to disk
-  std::fflush(file_.get());
+  write_event_end(event_number, event);
 
   // If the runtime is too short some particles might not yet have
   // reached the hypersurface. Warning is printed.
@@ -339,7 +315,7 @@ void BinaryOutputInitialConditions::at_interaction(const Action &action,
                                                    const double) {
   if (action.get_type() == ProcessType::HyperSurfaceCrossing) {
     const char pchar = 'p';
-    std::fwrite(&pchar, sizeof(char), 1, file_.get());
+    write(pchar);
     write(action.incoming_particles().size());
     write(action.incoming_particles());
   }
@@ -0,0 +1,87 @@
+/*
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ */
+
+#include "smash/cachefile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace smash {
+
+CacheFileHeader CacheFileHeader::create(const char (&magic)[8],
+                                        std::uint32_t version,
+                                        std::uint32_t element_size,
+                                        const sha256::Hash &hash) {
+  CacheFileHeader header;
+  std::copy(magic, magic + 8, header.magic);
+  header.version = version;
+  header.element_size = element_size;
+  header.hash = hash;
+  return header;
+}
+
+bool CacheFileHeader::operator==(const CacheFileHeader &other) const {
+  return std::equal(magic, magic + 8, other.magic) &&
+         version == other.version && element_size == other.element_size &&
+         hash == other.hash;
+}
+
+std::shared_ptr<const void> map_cache_file(const std::string &file_name,
+                                           const CacheFileHeader &header,
+                                           std::size_t min_size,
+                                           std::size_t *size) {
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) <
+          std::max(min_size, sizeof(CacheFileHeader))) {
+    close(fd);
+    return nullptr;
+  }
+  const std::size_t file_size = status.st_size;
+  void *data = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  std::shared_ptr<const void> mapping(data, [file_size](const void *p) {
+    munmap(const_cast<void *>(p), file_size);
+  });
+  if (!(*static_cast<const CacheFileHeader *>(data) == header)) {
+    return nullptr;
+  }
+  *size = file_size;
+  return mapping;
+}
+
+bool save_cache_file(const std::string &file_name,
+                     const std::function<void(std::ofstream &)> &write) {
+  const std::string temporary_name =
+      file_name + ".tmp" + std::to_string(getpid());
+  bool written;
+  {
+    std::ofstream file(temporary_name, std::ios::binary);
+    write(file);
+    file.close();
+    written = static_cast<bool>(file);
+  }
+  if (!written || std::rename(temporary_name.c_str(), file_name.c_str())) {
+    std::remove(temporary_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace smash
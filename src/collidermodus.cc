@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -25,6 +26,7 @@
 #include "smash/fourvector.h"
 #include "smash/logging.h"
 #include "smash/random.h"
+#include "smash/threadpool.h"
 
 namespace smash {
 static constexpr int LCollider = LogArea::Collider::id;
@@ -94,6 +96,28 @@ static constexpr int LCollider = LogArea::Collider::id;
  * to the chosen calculation frame, and thus the actual distance may be
  * different.
  *
+ * \key Nucleus_Pool: \n
+ * Section to sample the nucleon positions of the projectile and the target in
+ * advance. Every event draws one of the configurations, rotates it randomly
+ * and then generates the Fermi momenta and boosts the nucleus as usual. This
+ * saves the repeated sampling of the Woods-Saxon distribution, which matters
+ * for large nuclei with many testparticles and short events. The pool is
+ * sampled from a random number sequence derived from the seed of the run,
+ * which is independent of the sequences of the events. With \key
+ * Event_Threads, all threads share one pool. Custom nuclei are not pooled.
+ * \li \key Size (int, required): \n
+ * Number of configurations per nucleus. Drawing the same configuration again
+ * gives a rotated copy of it, so the pool should not be much smaller than the
+ * number of events.
+ * \li \key Threads (int, optional, default = 1): \n
+ * Number of threads sampling the pool. A value of 0 uses all available
+ * hardware threads. The pool is identical for any number of threads.
+ * \li \key Directory (string, optional, no default): \n
+ * Directory, in which the pools are cached as binary files, named after a
+ * hash of the parameters of the nucleus and the size of the pool. Later runs
+ * with the same nuclei read these files instead of sampling the pools, also
+ * if they use another random seed.
+ *
  * To further configure the projectile, target and the impact parameter, see \n
  * \li \subpage projectile_and_target
  * \li \subpage input_impact_parameter_
@@ -332,11 +356,13 @@ ColliderModus::ColliderModus(Configuration modus_config,
   /* Needed to check if projectile and target in customnucleus are read from
    * the same input file.*/
   bool same_file = false;
+  projectile_is_custom_ = proj_cfg.has_value({"Custom"});
+  target_is_custom_ = targ_cfg.has_value({"Custom"});
   // Set up the projectile nucleus
   if (proj_cfg.has_value({"Deformed"})) {
     projectile_ =
         create_deformed_nucleus(proj_cfg, params.testparticles, "projectile");
-  } else if (proj_cfg.has_value({"Custom"})) {
+  } else if (projectile_is_custom_) {
     same_file = same_inputfile(proj_cfg, targ_cfg);
     projectile_ =
         make_unique<CustomNucleus>(proj_cfg, params.testparticles, same_file);
@@ -351,7 +377,7 @@ ColliderModus::ColliderModus(Configuration modus_config,
   // Set up the target nucleus
   if (targ_cfg.has_value({"Deformed"})) {
     target_ = create_deformed_nucleus(targ_cfg, params.testparticles, "target");
-  } else if (targ_cfg.has_value({"Custom"})) {
+  } else if (target_is_custom_) {
     target_ =
         make_unique<CustomNucleus>(targ_cfg, params.testparticles, same_file);
   } else {
@@ -362,6 +388,20 @@ ColliderModus::ColliderModus(Configuration modus_config,
   }
   target_->set_label(BelongsTo::Target);
 
+  // Configurations of the nuclei to be sampled in advance
+  if (modus_cfg.has_value({"Nucleus_Pool"})) {
+    pool_size_ = modus_cfg.take({"Nucleus_Pool", "Size"});
+    pool_threads_ = modus_cfg.take({"Nucleus_Pool", "Threads"}, 1);
+    pool_directory_ =
+        modus_cfg.take({"Nucleus_Pool", "Directory"}, std::string());
+    if (pool_size_ < 1) {
+      throw std::invalid_argument(
+          "The size of the nucleus pool has to be positive.");
+    }
+    // Check the number of threads early, the pools are created later
+    number_of_threads(pool_threads_, "Nucleus_Pool: Threads");
+  }
+
   // Get the Fermi-Motion input (off, on, frozen)
   if (modus_cfg.has_value({"Fermi_Motion"})) {
     // We only read the value, because it is still required by the experiment
@@ -662,6 +702,39 @@ double ColliderModus::initial_conditions(Particles *particles,
   return simulation_time;
 }
 
+/// Distinguishes the random number sequence of the nucleus pools
+constexpr uint32_t nucleus_pool_stream = 0x6e75636c;
+
+void ColliderModus::create_nucleus_pools(int64_t seed) {
+  if (pool_size_ == 0) {
+    return;
+  }
+  std::unique_ptr<ThreadPool> threads =
+      make_thread_pool(pool_threads_, "Nucleus_Pool: Threads");
+  /* The pools get their own random number sequence. Seeding the engine with
+   * the run seed itself would reuse the sequence of the events, which are
+   * seeded from the same engine. */
+  const auto unsigned_seed = static_cast<uint64_t>(seed);
+  std::seed_seq pool_seeds = {static_cast<uint32_t>(unsigned_seed),
+                              static_cast<uint32_t>(unsigned_seed >> 32),
+                              nucleus_pool_stream};
+  random::engine.seed(pool_seeds);
+  // Custom nuclei already draw their configurations from a file
+  if (!projectile_is_custom_) {
+    projectile_->create_configuration_pool(pool_size_, threads.get(),
+                                           pool_directory_);
+  }
+  if (!target_is_custom_) {
+    target_->create_configuration_pool(pool_size_, threads.get(),
+                                       pool_directory_);
+  }
+}
+
+void ColliderModus::share_nucleus_pools(const ColliderModus &other) {
+  projectile_->share_configuration_pool(*other.projectile_);
+  target_->share_configuration_pool(*other.target_);
+}
+
 void ColliderModus::rotate_reaction_plane(double phi, Particles *particles) {
   for (ParticleData &p : *particles) {
     ThreeVector pos = p.position().threevec();
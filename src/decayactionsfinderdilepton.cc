@@ -9,6 +9,9 @@
 
 #include "smash/decayactionsfinderdilepton.h"
 
+#include <utility>
+#include <vector>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decayactiondilepton.h"
@@ -22,38 +25,54 @@ void DecayActionsFinderDilepton::shine(const Particles &search_list,
   if (!output->is_dilepton_output()) {
     return;
   }
+  /* The shining weights of all dilepton decays are computed first, such that
+   * the decay branches and actions are only created for them. */
+  struct Shining {
+    /// The shining particle
+    const ParticleData *particle;
+    /// Index of the dilepton mode in the decay mode list
+    std::size_t mode_index;
+    /// Partial width of the mode
+    double width;
+    /// Shining weight of the decay
+    double weight;
+  };
+  std::vector<Shining> shinings;
+  std::vector<std::pair<std::size_t, double>> dil_widths;
   for (const auto &p : search_list) {
-    const auto n_all_modes =
-        p.type()
-            .get_partial_widths(p.momentum(), p.position().threevec(),
-                                WhichDecaymodes::All)
-            .size();
-    if (n_all_modes == 0) {
+    const ParticleType &type = p.type();
+    /* If particle is stable or has no dilepton decays, there is nothing to
+     * shine, also unformed resonances cannot decay */
+    if (type.is_stable() || !type.decay_modes().has_dilepton_modes() ||
+        (p.formation_time() > p.position().x0())) {
       continue;
     }
 
-    const double inv_gamma = p.inverse_gamma();
-    DecayBranchList dil_modes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
-
-    /* If particle can only decay into dileptons or is stable, use shining only
-     * in find_final_actions and ignore them here, also unformed
-     * resonances cannot decay */
-    if (dil_modes.size() == n_all_modes || p.type().is_stable() ||
-        (p.formation_time() > p.position().x0())) {
+    /* If particle can only decay into dileptons, use shining only in
+     * find_final_actions and ignore them here */
+    const bool has_hadronic_modes = type.get_dilepton_widths(
+        p.momentum(), p.position().threevec(), &dil_widths);
+    if (!has_hadronic_modes) {
       continue;
     }
 
-    for (DecayBranchPtr &mode : dil_modes) {
+    const double inv_gamma = p.inverse_gamma();
+    for (const auto &mode : dil_widths) {
       // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
-      const double shining_weight = dt * inv_gamma * mode->weight() / hbarc;
+      const double shining_weight = dt * inv_gamma * mode.second / hbarc;
+      shinings.push_back({&p, mode.first, mode.second, shining_weight});
+    }
+  }
 
-      if (shining_weight > 0.0) {  // decays that can happen
-        DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
-        act.generate_final_state();
-        output->at_interaction(act, 0.0);
-      }
+  for (const Shining &shining : shinings) {
+    if (shining.weight > 0.0) {  // decays that can happen
+      const ParticleData &p = *shining.particle;
+      const DecayBranchList &modes = p.type().decay_modes().decay_mode_list();
+      DecayActionDilepton act(p, 0., shining.weight);
+      act.add_decay(make_unique<DecayBranch>(
+          modes[shining.mode_index]->type(), shining.width));
+      act.generate_final_state();
+      output->at_interaction(act, 0.0);
     }
   }
 }
@@ -66,7 +85,7 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
   }
   for (const auto &p : search_list) {
     const ParticleType &t = p.type();
-    if (t.decay_modes().decay_mode_list().empty() ||
+    if (!t.decay_modes().has_dilepton_modes() ||
         (only_res && t.is_stable())) {
       continue;
     }
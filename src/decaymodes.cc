@@ -38,7 +38,7 @@ void DecayModes::add_mode(ParticleTypePtr mother, double ratio, int L,
     }
   }
   // Add new mode.
-  decay_modes_.push_back(make_unique<DecayBranch>(*type, ratio));
+  add_mode(make_unique<DecayBranch>(*type, ratio));
 }
 
 DecayType *DecayModes::get_decay_type(ParticleTypePtr mother,
@@ -0,0 +1,287 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/deferredoutput.h"
+
+#include "smash/clock.h"
+#include "smash/cxx14compat.h"
+
+namespace smash {
+
+namespace {
+/**
+ * \param[in] target The output to be imitated.
+ * \return The output name, which leads to the same output category
+ *         (dileptons, photons, initial conditions or other) as the target.
+ */
+std::string name_of_category(const OutputInterface &target) {
+  if (target.is_dilepton_output()) {
+    return "Dileptons";
+  } else if (target.is_photon_output()) {
+    return "Photons";
+  } else if (target.is_IC_output()) {
+    return "SMASH_IC";
+  }
+  return "Deferred";
+}
+
+/**
+ * Fill a Particles object with copies of the given particles, keeping their
+ * ids.
+ *
+ * \param[in] list The particles to be copied.
+ * \param[out] particles The Particles object to be filled. It has to be empty.
+ */
+void fill_particles(const ParticleList &list, Particles *particles) {
+  for (const ParticleData &p : list) {
+    particles->insert(p);
+  }
+  auto original = list.begin();
+  for (ParticleData &p : *particles) {
+    p.set_id((original++)->id());
+  }
+}
+
+/**
+ * \param[in] ensembles The particles of all ensembles.
+ * \return Copies of the particles of all ensembles.
+ */
+std::vector<ParticleList> copy_ensembles(
+    const std::vector<Particles> &ensembles) {
+  std::vector<ParticleList> copy;
+  copy.reserve(ensembles.size());
+  for (const Particles &particles : ensembles) {
+    copy.emplace_back(particles.copy_to_vector());
+  }
+  return copy;
+}
+
+/**
+ * Fill Particles objects with copies of the particles of all ensembles.
+ *
+ * \param[in] lists The particles of all ensembles.
+ * \param[out] ensembles Particles objects for all ensembles.
+ */
+void fill_ensembles(const std::vector<ParticleList> &lists,
+                    std::vector<Particles> *ensembles) {
+  for (size_t i = 0; i < lists.size(); i++) {
+    fill_particles(lists[i], &(*ensembles)[i]);
+  }
+}
+}  // unnamed namespace
+
+DeferredOutput::DeferredOutput(OutputInterface *target)
+    : OutputInterface(name_of_category(*target)), target_(target) {}
+
+void DeferredOutput::at_interaction(const Action &action,
+                                    const double density) {
+  recorded_.emplace_back(make_unique<RecordedAction>(action), density);
+}
+
+void DeferredOutput::flush() {
+  for (const auto &interaction : recorded_) {
+    target_->at_interaction(*interaction.first, interaction.second);
+  }
+  recorded_.clear();
+}
+
+RecordingOutput::RecordingOutput(const OutputInterface &target)
+    : OutputInterface(name_of_category(target)) {}
+
+void RecordingOutput::at_eventstart(const Particles &particles,
+                                    const int event_number,
+                                    const EventInfo &info) {
+  const ParticleList list = particles.copy_to_vector();
+  recorded_.emplace_back([=](OutputInterface &out) {
+    Particles copy;
+    fill_particles(list, &copy);
+    out.at_eventstart(copy, event_number, info);
+  });
+}
+
+void RecordingOutput::at_eventstart(const std::vector<Particles> &ensembles,
+                                    int event_number) {
+  const std::vector<ParticleList> lists = copy_ensembles(ensembles);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    std::vector<Particles> copy(lists.size());
+    fill_ensembles(lists, &copy);
+    out.at_eventstart(copy, event_number);
+  });
+}
+
+void RecordingOutput::at_eventstart(
+    const int event_number, const ThermodynamicQuantity tq,
+    const DensityType dens_type, RectangularLattice<DensityOnLattice> lattice) {
+  const auto copy =
+      std::make_shared<RectangularLattice<DensityOnLattice>>(lattice);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    out.at_eventstart(event_number, tq, dens_type, *copy);
+  });
+}
+
+void RecordingOutput::at_eventstart(
+    const int event_number, const ThermodynamicQuantity tq,
+    const DensityType dens_type,
+    RectangularLattice<EnergyMomentumTensor> lattice) {
+  const auto copy =
+      std::make_shared<RectangularLattice<EnergyMomentumTensor>>(lattice);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    out.at_eventstart(event_number, tq, dens_type, *copy);
+  });
+}
+
+void RecordingOutput::at_eventend(const int event_number,
+                                  const ThermodynamicQuantity tq,
+                                  const DensityType dens_type) {
+  recorded_.emplace_back([=](OutputInterface &out) {
+    out.at_eventend(event_number, tq, dens_type);
+  });
+}
+
+void RecordingOutput::at_eventend(const ThermodynamicQuantity tq) {
+  recorded_.emplace_back([=](OutputInterface &out) { out.at_eventend(tq); });
+}
+
+void RecordingOutput::at_eventend(const Particles &particles,
+                                  const int event_number,
+                                  const EventInfo &info) {
+  const ParticleList list = particles.copy_to_vector();
+  recorded_.emplace_back([=](OutputInterface &out) {
+    Particles copy;
+    fill_particles(list, &copy);
+    out.at_eventend(copy, event_number, info);
+  });
+}
+
+void RecordingOutput::at_eventend(const std::vector<Particles> &ensembles,
+                                  const int event_number) {
+  const std::vector<ParticleList> lists = copy_ensembles(ensembles);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    std::vector<Particles> copy(lists.size());
+    fill_ensembles(lists, &copy);
+    out.at_eventend(copy, event_number);
+  });
+}
+
+void RecordingOutput::at_interaction(const Action &action,
+                                     const double density) {
+  const std::shared_ptr<const RecordedAction> copy =
+      std::make_shared<RecordedAction>(action);
+  recorded_.emplace_back(
+      [=](OutputInterface &out) { out.at_interaction(*copy, density); });
+}
+
+void RecordingOutput::at_intermediate_time(const Particles &particles,
+                                           const std::unique_ptr<Clock> &clock,
+                                           const DensityParameters &dens_param,
+                                           const EventInfo &info) {
+  const ParticleList list = particles.copy_to_vector();
+  const double time = clock->current_time();
+  const double dt = clock->timestep_duration();
+  recorded_.emplace_back([=](OutputInterface &out) {
+    Particles copy;
+    fill_particles(list, &copy);
+    const std::unique_ptr<Clock> replayed_clock =
+        make_unique<UniformClock>(time, dt);
+    out.at_intermediate_time(copy, replayed_clock, dens_param, info);
+  });
+}
+
+void RecordingOutput::at_intermediate_time(
+    const std::vector<Particles> &ensembles,
+    const std::unique_ptr<Clock> &clock, const DensityParameters &dens_param) {
+  const std::vector<ParticleList> lists = copy_ensembles(ensembles);
+  const double time = clock->current_time();
+  const double dt = clock->timestep_duration();
+  recorded_.emplace_back([=](OutputInterface &out) {
+    std::vector<Particles> copy(lists.size());
+    fill_ensembles(lists, &copy);
+    const std::unique_ptr<Clock> replayed_clock =
+        make_unique<UniformClock>(time, dt);
+    out.at_intermediate_time(copy, replayed_clock, dens_param);
+  });
+}
+
+void RecordingOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dt,
+    RectangularLattice<DensityOnLattice> &lattice) {
+  const auto copy =
+      std::make_shared<RectangularLattice<DensityOnLattice>>(lattice);
+  recorded_.emplace_back(
+      [=](OutputInterface &out) { out.thermodynamics_output(tq, dt, *copy); });
+}
+
+void RecordingOutput::thermodynamics_output(
+    const ThermodynamicQuantity tq, const DensityType dt,
+    RectangularLattice<EnergyMomentumTensor> &lattice) {
+  const auto copy =
+      std::make_shared<RectangularLattice<EnergyMomentumTensor>>(lattice);
+  recorded_.emplace_back(
+      [=](OutputInterface &out) { out.thermodynamics_output(tq, dt, *copy); });
+}
+
+void RecordingOutput::thermodynamics_lattice_output(
+    RectangularLattice<DensityOnLattice> &lattice, const double current_time) {
+  const auto copy =
+      std::make_shared<RectangularLattice<DensityOnLattice>>(lattice);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    out.thermodynamics_lattice_output(*copy, current_time);
+  });
+}
+
+void RecordingOutput::thermodynamics_lattice_output(
+    RectangularLattice<DensityOnLattice> &lattice, const double current_time,
+    const std::vector<Particles> &ensembles,
+    const DensityParameters &dens_param) {
+  const auto copy =
+      std::make_shared<RectangularLattice<DensityOnLattice>>(lattice);
+  const std::vector<ParticleList> lists = copy_ensembles(ensembles);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    std::vector<Particles> ensembles_copy(lists.size());
+    fill_ensembles(lists, &ensembles_copy);
+    out.thermodynamics_lattice_output(*copy, current_time, ensembles_copy,
+                                      dens_param);
+  });
+}
+
+void RecordingOutput::thermodynamics_lattice_output(
+    const ThermodynamicQuantity tq,
+    RectangularLattice<EnergyMomentumTensor> &lattice,
+    const double current_time) {
+  const auto copy =
+      std::make_shared<RectangularLattice<EnergyMomentumTensor>>(lattice);
+  recorded_.emplace_back([=](OutputInterface &out) {
+    out.thermodynamics_lattice_output(tq, *copy, current_time);
+  });
+}
+
+void RecordingOutput::fields_output(
+    const std::string name1, const std::string name2,
+    RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lat) {
+  const auto copy = std::make_shared<
+      RectangularLattice<std::pair<ThreeVector, ThreeVector>>>(lat);
+  recorded_.emplace_back(
+      [=](OutputInterface &out) { out.fields_output(name1, name2, *copy); });
+}
+
+std::vector<RecordingOutput::RecordedCall>
+RecordingOutput::release_recorded() {
+  std::vector<RecordedCall> calls;
+  calls.swap(recorded_);
+  return calls;
+}
+
+void RecordingOutput::replay(const std::vector<RecordedCall> &calls,
+                             OutputInterface *target) {
+  for (const RecordedCall &call : calls) {
+    call(*target);
+  }
+}
+
+}  // namespace smash
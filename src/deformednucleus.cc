@@ -7,8 +7,11 @@
 #include "smash/deformednucleus.h"
 
 #include <cmath>
+#include <iomanip>
 #include <map>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 
 #include "smash/configuration.h"
 #include "smash/constants.h"
@@ -289,6 +292,23 @@ void DeformedNucleus::rotate() {
   }
 }
 
+void DeformedNucleus::rotate_randomly() {
+  const double phi = twopi * random::uniform(0., 1.);
+  for (auto &particle : *this) {
+    ThreeVector three_pos = particle.position().threevec();
+    three_pos.rotate_around_z(phi);
+    particle.set_3position(three_pos);
+  }
+}
+
+std::string DeformedNucleus::position_distribution_parameters() const {
+  std::ostringstream parameters;
+  parameters << std::setprecision(17)
+             << Nucleus::position_distribution_parameters() << " deformed "
+             << beta2_ << " " << beta4_;
+  return parameters.str();
+}
+
 double y_l_0(int l, double cosx) {
   if (l == 2) {
     return (1. / 4) * std::sqrt(5 / M_PI) * (3. * (cosx * cosx) - 1);
@@ -186,7 +186,7 @@ void update_lattice(
     RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
-    const double time_step, const bool compute_gradient) {
+    const double time_step, const bool compute_gradient, ThreadPool *pool) {
   // Do not proceed if lattice does not exists/update not required
   if (lat == nullptr || lat->when_update() != update) {
     return;
@@ -209,7 +209,8 @@ void update_lattice(
     }
   }
 
-  update_lattice(lat, update, dens_type, par, ensembles, compute_gradient);
+  update_lattice(lat, update, dens_type, par, ensembles, compute_gradient,
+                 pool);
 
   // calculate the gradients for finite difference derivatives
   if (par.derivatives() == DerivativesMode::FiniteDifference) {
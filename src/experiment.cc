@@ -107,6 +107,77 @@ ExperimentPtr ExperimentBase::create(Configuration config,
  * ensemble* method (see below). Because of this, the parallel ensembles
  * technique is computationally faster than the full ensemble technique.
  *
+ * \key Ensemble_Threads (int, optional, default = 1): \n
+ * Number of threads used to evolve the parallel ensembles within one time
+ * step. A value of 0 uses all available hardware threads.
+ *
+ * Between two time steps, the ensembles only interact via the densities and
+ * mean-field potentials, so the collisions, decays and propagation of the
+ * different ensembles within one time step are performed concurrently. The
+ * densities, potentials, output and thermalization are then computed serially.
+ * Every ensemble draws its random numbers from its own generator, which is
+ * seeded from the event seed, so that the results do not depend on the number
+ * of threads or on their scheduling. Note that the random number sequences
+ * differ from the single-threaded evolution, which is used for the default
+ * value of 1.
+ *
+ * Pauli blocking in the threaded mode uses the particles of the own ensemble
+ * at the time of the reaction, but the particles of the other ensembles as
+ * they were at the beginning of the time step (or of the last output time
+ * within the time step). For small time steps, this is a good approximation.
+ * String processes are serialized between the threads, since the Pythia
+ * objects are shared. The process ids in the collision output are unique, but
+ * not consecutive, because every ensemble takes every n-th id for n
+ * ensembles. The adaptive maxima of the rejection sampling of resonance masses
+ * are kept per ensemble and start anew in every event. This option has no
+ * effect for a single ensemble.
+ *
+ * \key Event_Threads (int, optional, default = 1): \n
+ * Number of threads used to run complete events concurrently. A value of 0
+ * uses all available hardware threads.
+ *
+ * The particle and decay mode tables and the tabulated integrals are set up
+ * once and shared by all threads, each of which runs its own copy of the
+ * experiment. Every event is run with the same seed as in a serial run and its
+ * output is written to the usual output files only after all previous events
+ * have been written, so the output does not depend on the number of threads.
+ * Since every thread keeps one copy of the experiment and the output of
+ * finished events is kept in memory until it can be written, the memory usage
+ * grows with the number of threads. If parallel ensembles are evolved with
+ * several \key Ensemble_Threads, every event thread uses that many threads.
+ * This option cannot be used with the \key List and \key ListBox modi or
+ * together with the VTK thermodynamics output of the forced thermalization.
+ *
+ * \key Width_Tabulation: \n
+ * The mass-dependent total and partial decay widths of the unstable particle
+ * types are tabulated on a mass grid from the decay thresholds up to the pole
+ * mass plus ten times the pole width (at least 2 GeV). The grid of a particle
+ * type is created when its widths are needed for the first time and is cached
+ * together with the tabulated integrals, unless \key --no-cache is used.
+ * Masses outside of the grid and grid intervals, where the linear
+ * interpolation is not accurate enough, are evaluated directly.
+ * \li \key Mass_Step (double, optional, default = 0.005): \n
+ * Spacing of the mass grid in GeV. A value of 0 disables the tabulation.
+ * \li \key Max_Error (double, optional, default = 0.001): \n
+ * Maximal interpolation error, relative to the larger of the exact width and
+ * the width at the pole mass. It is checked at the center of every interval of
+ * the grid.
+ *
+ * \key Mass_Sampling_Tabulation: \n
+ * The masses of resonances, which are produced together with a stable
+ * particle, are sampled by inverting tabulated mass distributions instead of
+ * rejection sampling. A table is created on first use for each resonance, mass
+ * of the stable particle and angular momentum. It covers the center-of-mass
+ * energies, at which the resonance mass can reach the pole mass plus ten times
+ * the pole width (at least 2 GeV); outside of it, rejection sampling is used.
+ * The sampled distribution is an interpolation, which is not exact.
+ * \li \key Sqrts_Step (double, optional, default = 0): \n
+ * Largest spacing of the center-of-mass energy grid in GeV. The grid is
+ * refined, where the largest possible mass crosses the pole mass. A value of 0
+ * disables the tabulation.
+ * \li \key Mass_Intervals (int, optional, default = 128): \n
+ * Number of mass intervals per center-of-mass energy.
+ *
  * \key Testparticles (int, optional, default = 1): \n
  * Number of test-particles per real particle in the simulation.
  *
@@ -661,6 +732,7 @@ ExperimentParameters create_experiment_parameters(Configuration config) {
   return {make_unique<UniformClock>(0.0, dt),
           std::move(output_clock),
           config.take({"General", "Ensembles"}, 1),
+          config.take({"General", "Ensemble_Threads"}, 1),
           ntest,
           config.take({"General", "Derivatives_Mode"},
                       DerivativesMode::CovariantGaussian),
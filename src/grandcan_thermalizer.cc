@@ -9,6 +9,8 @@
 
 #include <time.h>
 
+#include <algorithm>
+
 #include "smash/angles.h"
 #include "smash/cxx14compat.h"
 #include "smash/forwarddeclarations.h"
@@ -40,29 +42,44 @@ void ThermLatticeNode::add_particle(const ParticleData &part, double factor) {
   nq_ += static_cast<double>(part.type().charge()) * factor;
 }
 
-void ThermLatticeNode::compute_rest_frame_quantities(HadronGasEos &eos) {
-  /// \todo(oliiny): use Newton's method instead of these iterations
+void ThermLatticeNode::compute_rest_frame_quantities(
+    HadronGasEos &eos, std::array<double, 4> *eos_guess) {
   const int max_iter = 50;
-  v_ = ThreeVector(0.0, 0.0, 0.0);
-  double e_previous_step = 0.0;
   const double tolerance = 5.e-4;
+  const double T00 = Tmu0_.x0();
+  const ThreeVector T0i = Tmu0_.threevec();
+  std::array<double, 4> guess = {0.0, 0.0, 0.0, 0.0};
+  if (eos_guess) {
+    guess = *eos_guess;
+  }
+  /* For a trial pressure p, the rest frame moves with v = T0i / (T00 + p) and
+   * has the energy density e = T00 - T0i v. The pressure is the root of
+   * g(p) = p_eos(e, n) - p, where the derivative of g is between -1 and 0.
+   * The first step is a fixed-point iteration from p = 0, the following ones
+   * use the secant method. */
+  double p_trial = 0.0;
+  double p_previous = 0.0;
+  double g_previous = 0.0;
+  double e_previous_step = 0.0;
   int iter;
   for (iter = 0; iter < max_iter; iter++) {
+    const double w = T00 + p_trial;
+    v_ = w > 0.0 ? T0i / w : ThreeVector(0.0, 0.0, 0.0);
     e_previous_step = e_;
-    e_ = Tmu0_.x0() - Tmu0_.threevec() * v_;
-    if (std::abs(e_ - e_previous_step) < tolerance) {
+    e_ = T00 - T0i * v_;
+    if (iter > 0 && std::abs(e_ - e_previous_step) < tolerance) {
       break;
     }
     const double gamma_inv = std::sqrt(1.0 - v_.sqr());
     EosTable::table_element tabulated;
     eos.from_table(tabulated, e_, gamma_inv * nb_, nq_);
     if (!eos.is_tabulated() || tabulated.p < 0.0) {
-      auto T_mub_mus_muq =
-          eos.solve_eos(e_, gamma_inv * nb_, gamma_inv * ns_, nq_);
-      T_ = T_mub_mus_muq[0];
-      mub_ = T_mub_mus_muq[1];
-      mus_ = T_mub_mus_muq[2];
-      muq_ = T_mub_mus_muq[3];
+      guess = eos.solve_eos_warm_start(e_, gamma_inv * nb_, gamma_inv * ns_,
+                                       nq_, guess);
+      T_ = guess[0];
+      mub_ = guess[1];
+      mus_ = guess[2];
+      muq_ = guess[3];
       p_ = HadronGasEos::pressure(T_, mub_, mus_, muq_);
     } else {
       p_ = tabulated.p;
@@ -70,13 +87,29 @@ void ThermLatticeNode::compute_rest_frame_quantities(HadronGasEos &eos) {
       mub_ = tabulated.mub;
       mus_ = tabulated.mus;
       muq_ = tabulated.muq;
+      if (T_ > 0.0) {
+        guess = {T_, mub_, mus_, muq_};
+      }
+    }
+    const double g = p_ - p_trial;
+    double p_next = p_;
+    if (iter > 0 && p_trial != p_previous) {
+      const double slope = (g - g_previous) / (p_trial - p_previous);
+      if (slope < 0.0) {
+        p_next = p_trial - g / slope;
+      }
     }
-    v_ = Tmu0_.threevec() / (Tmu0_.x0() + p_);
+    p_previous = p_trial;
+    g_previous = g;
+    p_trial = std::max(0.0, p_next);
   }
   if (iter == max_iter) {
-    std::cout << "Warning from solver: max iterations exceeded."
-              << " Accuracy: " << std::abs(e_ - e_previous_step)
-              << " is less than tolerance " << tolerance << std::endl;
+    logg[LGrandcanThermalizer].warn(
+        "Warning from solver: max iterations exceeded. Accuracy: ",
+        std::abs(e_ - e_previous_step), " is less than tolerance ", tolerance);
+  }
+  if (eos_guess && guess[0] > 0.0) {
+    *eos_guess = guess;
   }
 }
 
@@ -109,7 +142,8 @@ GrandCanThermalizer::GrandCanThermalizer(const std::array<double, 3> lat_sizes,
                                          bool periodicity, double e_critical,
                                          double t_start, double delta_t,
                                          ThermalizationAlgorithm algo,
-                                         bool BF_microcanonical)
+                                         bool BF_microcanonical,
+                                         int n_threads)
     : eos_typelist_(list_eos_particles()),
       N_sorts_(eos_typelist_.size()),
       e_crit_(e_critical),
@@ -125,6 +159,11 @@ GrandCanThermalizer::GrandCanThermalizer(const std::array<double, 3> lat_sizes,
   cells_to_sample_.resize(50000);
   mult_sort_.resize(N_sorts_);
   mult_int_.resize(N_sorts_);
+  pool_ = make_thread_pool(n_threads, "Forced_Thermalization: Threads");
+  if (pool_) {
+    logg[LGrandcanThermalizer].info("Updating the thermalizer lattice with ",
+                                    pool_->size(), " threads.");
+  }
 }
 
 void GrandCanThermalizer::update_thermalizer_lattice(
@@ -132,18 +171,37 @@ void GrandCanThermalizer::update_thermalizer_lattice(
     bool ignore_cells_under_treshold) {
   const DensityType dens_type = DensityType::Hadron;
   const LatticeUpdate update = LatticeUpdate::EveryFixedInterval;
-  update_lattice(lat_.get(), update, dens_type, dens_par, ensembles, false);
-  for (auto &node : *lat_) {
-    /* If energy density is definitely below e_crit -
-       no need to find T, mu, etc. So if e = T00 - T0i*vi <=
-       T00 + sum abs(T0i) < e_crit, no efforts are necessary. */
-    if (!ignore_cells_under_treshold ||
-        node.Tmu0().x0() + std::abs(node.Tmu0().x1()) +
-                std::abs(node.Tmu0().x2()) + std::abs(node.Tmu0().x3()) >=
-            e_crit_) {
-      node.compute_rest_frame_quantities(eos_);
-    } else {
-      node = ThermLatticeNode();
+  update_lattice(lat_.get(), update, dens_type, dens_par, ensembles, false,
+                 pool_.get());
+  /* The nodes of a row along x are solved in order, each starting from the
+   * solution of the previous one. The rows are independent, so they can be
+   * solved concurrently without changing the result. Every row needs its own
+   * solver workspace, while the EoS table is shared. */
+  const int n_x = lat_->n_cells()[0];
+  const int n_rows = static_cast<int>(lat_->size()) / n_x;
+  auto solve_row = [&](int row) {
+    HadronGasEos eos(eos_);
+    std::array<double, 4> eos_guess = {0.0, 0.0, 0.0, 0.0};
+    for (int ix = 0; ix < n_x; ix++) {
+      ThermLatticeNode &node = (*lat_)[row * n_x + ix];
+      /* If energy density is definitely below e_crit -
+         no need to find T, mu, etc. So if e = T00 - T0i*vi <=
+         T00 + sum abs(T0i) < e_crit, no efforts are necessary. */
+      if (!ignore_cells_under_treshold ||
+          node.Tmu0().x0() + std::abs(node.Tmu0().x1()) +
+                  std::abs(node.Tmu0().x2()) + std::abs(node.Tmu0().x3()) >=
+              e_crit_) {
+        node.compute_rest_frame_quantities(eos, &eos_guess);
+      } else {
+        node = ThermLatticeNode();
+      }
+    }
+  };
+  if (pool_) {
+    pool_->parallel_for(n_rows, solve_row);
+  } else {
+    for (int row = 0; row < n_rows; row++) {
+      solve_row(row);
     }
   }
 }
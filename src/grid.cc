@@ -118,17 +118,52 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
               const Particles &particles, double max_interaction_length,
               double timestep_duration, CellNumberLimitation limit,
               const bool include_unformed_particles, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
-  const auto min_position = min_and_length.first;
+    : min_position_(min_and_length.first),
+      length_(min_and_length.second),
+      limit_(limit),
+      strategy_(strategy) {
+  build(particles, max_interaction_length, timestep_duration,
+        include_unformed_particles);
+}
+
+template <GridOptions O>
+void Grid<O>::update(const Particles &particles, double max_interaction_length,
+                     double timestep_duration,
+                     const bool include_unformed_particles) {
+  // The box of a grid with periodic boundaries is fixed
+  if (O == GridOptions::Normal) {
+    const auto min_and_length = find_min_and_length(particles);
+    min_position_ = min_and_length.first;
+    length_ = min_and_length.second;
+  }
+  build(particles, max_interaction_length, timestep_duration,
+        include_unformed_particles);
+}
+
+template <GridOptions O>
+void Grid<O>::reset_cells(std::size_t n) {
+  // clearing keeps the memory, which is reused when the cells are filled
+  for (ParticleList &cell : cells_) {
+    cell.clear();
+  }
+  cells_.resize(n);
+}
+
+template <GridOptions O>
+void Grid<O>::build(const Particles &particles, double max_interaction_length,
+                    double timestep_duration,
+                    const bool include_unformed_particles) {
+  const auto &min_position = min_position_;
+  const CellNumberLimitation limit = limit_;
+  const CellSizeStrategy strategy = strategy_;
   const SizeType particle_count = particles.size();
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
   if (O == GridOptions::Normal && strategy == CellSizeStrategy::Largest) {
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.clear();
-    cells_.reserve(1);
-    cells_.emplace_back(particles.copy_to_vector());
+    reset_cells(1);
+    cells_.front().assign(particles.begin(), particles.end());
     return;
   }
 
@@ -207,13 +242,11 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
         "particle list.");
     number_of_cells_ = {1, 1, 1};
     cell_volume_ = length_[0] * length_[1] * length_[2];
+    reset_cells(1);
     if (include_unformed_particles) {
-      cells_.clear();
-      cells_.reserve(1);
-      cells_.emplace_back(particles.copy_to_vector());
+      cells_.front().assign(particles.begin(), particles.end());
     } else {
       // filter out the particles that can not interact
-      cells_.resize(1);
       cells_.front().reserve(particles.size());
       std::copy_if(particles.begin(), particles.end(),
                    std::back_inserter(cells_.front()),
@@ -235,8 +268,8 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
 
     // After the grid parameters are determined, we can start placing the
     // particles in cells.
-    cells_.resize(number_of_cells_[0] * number_of_cells_[1] *
-                  number_of_cells_[2]);
+    reset_cells(number_of_cells_[0] * number_of_cells_[1] *
+                number_of_cells_[2]);
 
     // Returns the one-dimensional cell-index from the position vector inside
     // the grid.
@@ -365,6 +398,9 @@ void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
   SizeType &z = search_index[2];
   SizeType search_cell_index = 0;
 
+  // copy of the search cell, which is translated for the wrapped neighbors
+  ParticleList search;
+
   // defaults:
   std::array<NeighborLookup, 2> dz_list;
   std::array<NeighborLookup, 3> dy_list;
@@ -412,7 +448,8 @@ void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
         assert(search_cell_index == make_index(search_index));
         assert(search_cell_index >= 0);
         assert(search_cell_index < SizeType(cells_.size()));
-        ParticleList search = cells_[search_cell_index];
+        search.assign(cells_[search_cell_index].begin(),
+                      cells_[search_cell_index].end());
         search_cell_callback(search);
 
         auto virtual_search_index = search_index;
@@ -490,4 +527,10 @@ template Grid<GridOptions::PeriodicBoundaries>::Grid(
     const Particles &particles, double max_interaction_length,
     double timestep_duration, CellNumberLimitation limit,
     const bool include_unformed_particles, CellSizeStrategy strategy);
+template void Grid<GridOptions::Normal>::update(
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, const bool include_unformed_particles);
+template void Grid<GridOptions::PeriodicBoundaries>::update(
+    const Particles &particles, double max_interaction_length,
+    double timestep_duration, const bool include_unformed_particles);
 }  // namespace smash
@@ -9,18 +9,24 @@
 
 #include <gsl/gsl_sf_bessel.h>
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 
 #include <boost/filesystem.hpp>
 
+#include "smash/cachefile.h"
 #include "smash/constants.h"
 #include "smash/hadgas_eos.h"
 #include "smash/integrate.h"
 #include "smash/interpolation.h"
 #include "smash/logging.h"
 #include "smash/random.h"
+#include "smash/threadpool.h"
 
 namespace smash {
 static constexpr int LResonances = LogArea::Resonances::id;
@@ -31,132 +37,227 @@ EosTable::EosTable(double de, double dnb, double dq, size_t n_e, size_t n_nb,
   table_.resize(n_e_ * n_nb_ * n_q_);
 }
 
+namespace {
+/// Identifies EoS table files
+constexpr char eos_table_magic[8] = {'S', 'M', 'A', 'S', 'H', 'E', 'O', 'S'};
+/// Version of the EoS table file format and solver
+constexpr std::uint32_t eos_table_version = 2;
+
+/// Header of an EoS table file, which is followed by the table elements
+struct EosTableHeader {
+  /// Common header with eos_table_magic and eos_table_version
+  CacheFileHeader common;
+  /// Steps in energy, net baryon and net charge density
+  double steps[3];
+  /// Numbers of steps in energy, net baryon and net charge density
+  std::uint64_t n_steps[3];
+};
+static_assert(sizeof(EosTableHeader) % sizeof(double) == 0,
+              "The table elements in the file have to be aligned.");
+
+/**
+ * Hash of the SMASH version, the particles and decaymodes, on which the table
+ * depends through the hadrons in the EoS and their spectral functions
+ */
+sha256::Hash eos_particles_hash;
+
+/**
+ * \param[in] account_for_width Whether the EoS takes the spectral functions
+ *            into account.
+ * \return Hash of the particles and decaymodes, the properties of the hadrons
+ *         in the EoS and the EoS flags.
+ */
+sha256::Hash eos_table_hash(bool account_for_width) {
+  sha256::Context hash_context;
+  hash_context.update(eos_particles_hash.data(), eos_particles_hash.size());
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    if (!HadronGasEos::is_eos_particle(ptype)) {
+      continue;
+    }
+    const std::int32_t pdg = ptype.pdgcode().get_decimal();
+    const double properties[] = {ptype.mass(), ptype.width_at_pole()};
+    hash_context.update(reinterpret_cast<const uint8_t *>(&pdg), sizeof(pdg));
+    hash_context.update(reinterpret_cast<const uint8_t *>(properties),
+                        sizeof(properties));
+  }
+  const uint8_t width = account_for_width;
+  hash_context.update(&width, sizeof(width));
+  return hash_context.finalize();
+}
+}  // unnamed namespace
+
 void EosTable::compile_table(HadronGasEos &eos,
-                             const std::string &eos_savefile_name) {
-  bool table_read_success = false, table_consistency = true;
-  if (boost::filesystem::exists(eos_savefile_name)) {
-    std::cout << "Reading table from file " << eos_savefile_name << std::endl;
-    std::ifstream file;
-    file.open(eos_savefile_name, std::ios::in);
-    file >> de_ >> dnb_ >> dq_;
-    file >> n_e_ >> n_nb_ >> n_q_;
-    table_.resize(n_e_ * n_nb_ * n_q_);
-    for (size_t ie = 0; ie < n_e_; ie++) {
-      for (size_t inb = 0; inb < n_nb_; inb++) {
-        for (size_t iq = 0; iq < n_q_; iq++) {
-          double p, T, mub, mus, muq;
-          file >> p >> T >> mub >> mus >> muq;
-          table_[index(ie, inb, iq)] = {p, T, mub, mus, muq};
-        }
-      }
+                             const std::string &eos_savefile_name,
+                             int n_threads) {
+  const sha256::Hash hash = eos_table_hash(eos.account_for_resonance_widths());
+  if (map_file(eos_savefile_name, hash)) {
+    std::cout << "Mapped table from file " << eos_savefile_name << std::endl;
+    if (is_consistent(eos)) {
+      // The table in memory is not needed anymore
+      std::vector<table_element>().swap(table_);
+      return;
     }
-    table_read_success = true;
-    std::cout << "Table consumed successfully." << std::endl;
-  }
-
-  if (table_read_success) {
-    // Check if the saved table is consistent with the current particle table
-    std::cout << "Checking consistency of the table... " << std::endl;
-    constexpr size_t number_of_steps = 50;
-    const size_t ie_step = 1 + n_e_ / number_of_steps;
-    const size_t inb_step = 1 + n_nb_ / number_of_steps;
-    const size_t iq_step = 1 + n_q_ / number_of_steps;
-    for (size_t ie = 0; ie < n_e_; ie += ie_step) {
-      for (size_t inb = 0; inb < n_nb_; inb += inb_step) {
-        for (size_t iq = 0; iq < n_q_; iq += iq_step) {
-          const table_element x = table_[index(ie, inb, iq)];
-          const bool w = eos.account_for_resonance_widths();
-          const double e_comp = eos.energy_density(x.T, x.mub, x.mus, x.muq);
-          const double nb_comp =
-              eos.net_baryon_density(x.T, x.mub, x.mus, x.muq, w);
-          const double ns_comp =
-              eos.net_strange_density(x.T, x.mub, x.mus, x.muq, w);
-          const double p_comp = eos.pressure(x.T, x.mub, x.mus, x.muq, w);
-          const double nq_comp =
-              eos.net_charge_density(x.T, x.mub, x.mus, x.muq, w);
-          // Precision is just 10^-3, this is precision of saved data in the
-          // file
-          const double eps = 1.e-3;
-          // Only check the physical region, hence T > 0 condition
-          if ((std::abs(de_ * ie - e_comp) > eps ||
-               std::abs(dnb_ * inb - nb_comp) > eps ||
-               std::abs(ns_comp) > eps || std::abs(x.p - p_comp) > eps ||
-               std::abs(dq_ * iq - nq_comp) > eps) &&
-              (x.T > 0.0)) {
-            std::cout << "discrepancy: " << de_ * ie << " = " << e_comp << ", "
-                      << dnb_ * inb << " = " << nb_comp << ", " << x.p << " = "
-                      << p_comp << ", 0 = " << ns_comp << ", " << dq_ * iq
-                      << " = " << nq_comp << std::endl;
-            table_consistency = false;
-            goto finish_consistency_check;
-          }
+    mapping_.reset();
+    mapped_ = nullptr;
+  }
+
+  std::cout << "Compiling an EoS table..." << std::endl;
+  const auto start = std::chrono::steady_clock::now();
+  table_.resize(n_e_ * n_nb_ * n_q_);
+  /* The slabs of fixed energy density are independent, so they are computed
+   * concurrently, each with its own copy of the EoS for the solver workspace.
+   * The result does not depend on the number of threads. */
+  std::vector<size_t> n_solutions(n_e_);
+  ThreadPool pool(n_threads);
+  pool.parallel_for(static_cast<int>(n_e_), [&](int ie) {
+    HadronGasEos slab_eos(eos);
+    n_solutions[ie] = compile_slab(slab_eos, ie);
+  });
+  const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+  // The number of solutions and the time are read by the benchmark script
+  std::cout << "Compiled EoS table: "
+            << std::accumulate(n_solutions.begin(), n_solutions.end(),
+                               size_t{0})
+            << " solutions in " << duration.count() << " s" << std::endl;
+  std::cout << "Saving table to file " << eos_savefile_name << std::endl;
+  save_file(eos_savefile_name, hash);
+}
+
+void EosTable::set_particles_hash(sha256::Hash hash) {
+  eos_particles_hash = hash;
+}
+
+bool EosTable::is_consistent(const HadronGasEos &eos) const {
+  std::cout << "Checking consistency of the table... " << std::endl;
+  constexpr size_t number_of_steps = 50;
+  const size_t ie_step = 1 + n_e_ / number_of_steps;
+  const size_t inb_step = 1 + n_nb_ / number_of_steps;
+  const size_t iq_step = 1 + n_q_ / number_of_steps;
+  const bool w = eos.account_for_resonance_widths();
+  for (size_t ie = 0; ie < n_e_; ie += ie_step) {
+    for (size_t inb = 0; inb < n_nb_; inb += inb_step) {
+      for (size_t iq = 0; iq < n_q_; iq += iq_step) {
+        const table_element x = element(index(ie, inb, iq));
+        // Only check the physical region
+        if (x.T <= 0.0) {
+          continue;
+        }
+        const double e_comp = eos.energy_density(x.T, x.mub, x.mus, x.muq);
+        const double nb_comp =
+            eos.net_baryon_density(x.T, x.mub, x.mus, x.muq, w);
+        const double ns_comp =
+            eos.net_strange_density(x.T, x.mub, x.mus, x.muq, w);
+        const double p_comp = eos.pressure(x.T, x.mub, x.mus, x.muq, w);
+        const double nq_comp =
+            eos.net_charge_density(x.T, x.mub, x.mus, x.muq, w);
+        const double eps = 1.e-3;
+        if (std::abs(de_ * ie - e_comp) > eps ||
+            std::abs(dnb_ * inb - nb_comp) > eps || std::abs(ns_comp) > eps ||
+            std::abs(x.p - p_comp) > eps ||
+            std::abs(dq_ * iq - nq_comp) > eps) {
+          std::cout << "discrepancy: " << de_ * ie << " = " << e_comp << ", "
+                    << dnb_ * inb << " = " << nb_comp << ", " << x.p << " = "
+                    << p_comp << ", 0 = " << ns_comp << ", " << dq_ * iq
+                    << " = " << nq_comp << std::endl;
+          return false;
         }
       }
     }
   }
-finish_consistency_check:
-
-  if (!table_read_success || !table_consistency) {
-    std::cout << "Compiling an EoS table..." << std::endl;
-    const double ns = 0.0;
-    for (size_t ie = 0; ie < n_e_; ie++) {
-      std::cout << ie << "/" << n_e_ << "\r" << std::flush;
-      const double e = de_ * ie;
-      for (size_t inb = 0; inb < n_nb_; inb++) {
-        const double nb = dnb_ * inb;
-        for (size_t iq = 0; iq < n_q_; iq++) {
-          const double q = dq_ * iq;
-          // It is physically impossible to have energy density > nucleon
-          // mass*nb, therefore eqns have no solutions.
-          if (nb >= e || q >= e) {
-            table_[index(ie, inb, iq)] = {0.0, 0.0, 0.0, 0.0, 0.0};
-            continue;
-          }
-          // Take extrapolated (T, mub, mus, muq) as initial approximation
-          std::array<double, 4> init_approx;
-          if (inb >= 2) {
-            const table_element y = table_[index(ie, inb - 2, iq)];
-            const table_element x = table_[index(ie, inb - 1, iq)];
-            init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
-                           2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
-          } else if (iq >= 2) {
-            const table_element y = table_[index(ie, inb, iq - 2)];
-            const table_element x = table_[index(ie, inb, iq - 1)];
-            init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
-                           2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
-          } else {
-            init_approx = eos.solve_eos_initial_approximation(e, nb, q);
-          }
-          const std::array<double, 4> res =
-              eos.solve_eos(e, nb, ns, q, init_approx);
-          const double T = res[0];
-          const double mub = res[1];
-          const double mus = res[2];
-          const double muq = res[3];
-          const bool w = eos.account_for_resonance_widths();
-          table_[index(ie, inb, iq)] = {eos.pressure(T, mub, mus, muq, w), T,
-                                        mub, mus, muq};
-        }
+  return true;
+}
+
+size_t EosTable::compile_slab(HadronGasEos &eos, size_t ie) {
+  size_t n_solutions = 0;
+  const double ns = 0.0;
+  const double e = de_ * ie;
+  for (size_t inb = 0; inb < n_nb_; inb++) {
+    const double nb = dnb_ * inb;
+    for (size_t iq = 0; iq < n_q_; iq++) {
+      const double q = dq_ * iq;
+      // It is physically impossible to have energy density > nucleon
+      // mass*nb, therefore eqns have no solutions.
+      if (nb >= e || q >= e) {
+        table_[index(ie, inb, iq)] = {0.0, 0.0, 0.0, 0.0, 0.0};
+        continue;
       }
-    }
-    // Save table to file
-    std::cout << "Saving table to file " << eos_savefile_name << std::endl;
-    std::ofstream file;
-    file.open(eos_savefile_name, std::ios::out);
-    file << de_ << " " << dnb_ << " " << dq_ << std::endl;
-    file << n_e_ << " " << n_nb_ << " " << n_q_ << std::endl;
-    file << std::setprecision(7);
-    file << std::fixed;
-    for (size_t ie = 0; ie < n_e_; ie++) {
-      for (size_t inb = 0; inb < n_nb_; inb++) {
-        for (size_t iq = 0; iq < n_q_; iq++) {
-          const EosTable::table_element x = table_[index(ie, inb, iq)];
-          file << x.p << " " << x.T << " " << x.mub << " " << x.mus << " "
-               << x.muq << std::endl;
-        }
+      // Take extrapolated (T, mub, mus, muq) as initial approximation
+      std::array<double, 4> init_approx;
+      if (inb >= 2) {
+        const table_element y = table_[index(ie, inb - 2, iq)];
+        const table_element x = table_[index(ie, inb - 1, iq)];
+        init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
+                       2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
+      } else if (iq >= 2) {
+        const table_element y = table_[index(ie, inb, iq - 2)];
+        const table_element x = table_[index(ie, inb, iq - 1)];
+        init_approx = {2.0 * x.T - y.T, 2.0 * x.mub - y.mub,
+                       2.0 * x.mus - y.mus, 2.0 * x.muq - y.muq};
+      } else {
+        init_approx = eos.solve_eos_initial_approximation(e, nb, q);
       }
+      const std::array<double, 4> res =
+          eos.solve_eos(e, nb, ns, q, init_approx);
+      n_solutions++;
+      const double T = res[0];
+      const double mub = res[1];
+      const double mus = res[2];
+      const double muq = res[3];
+      const bool w = eos.account_for_resonance_widths();
+      table_[index(ie, inb, iq)] = {eos.pressure(T, mub, mus, muq, w), T, mub,
+                                    mus, muq};
     }
   }
+  return n_solutions;
+}
+
+bool EosTable::map_file(const std::string &file_name,
+                        const sha256::Hash &hash) {
+  const std::size_t size_expected =
+      sizeof(EosTableHeader) + n_e_ * n_nb_ * n_q_ * sizeof(table_element);
+  std::size_t size;
+  std::shared_ptr<const void> mapping = map_cache_file(
+      file_name,
+      CacheFileHeader::create(eos_table_magic, eos_table_version,
+                              sizeof(table_element), hash),
+      size_expected, &size);
+  if (!mapping || size != size_expected) {
+    return false;
+  }
+  const EosTableHeader *header =
+      static_cast<const EosTableHeader *>(mapping.get());
+  const bool matches =
+      header->steps[0] == de_ && header->steps[1] == dnb_ &&
+      header->steps[2] == dq_ && header->n_steps[0] == n_e_ &&
+      header->n_steps[1] == n_nb_ && header->n_steps[2] == n_q_;
+  if (!matches) {
+    return false;
+  }
+  mapping_ = mapping;
+  mapped_ = reinterpret_cast<const table_element *>(header + 1);
+  return true;
+}
+
+void EosTable::save_file(const std::string &file_name,
+                         const sha256::Hash &hash) const {
+  EosTableHeader header;
+  header.common = CacheFileHeader::create(eos_table_magic, eos_table_version,
+                                          sizeof(table_element), hash);
+  header.steps[0] = de_;
+  header.steps[1] = dnb_;
+  header.steps[2] = dq_;
+  header.n_steps[0] = n_e_;
+  header.n_steps[1] = n_nb_;
+  header.n_steps[2] = n_q_;
+  const bool saved = save_cache_file(file_name, [&](std::ofstream &file) {
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(table_.data()),
+               table_.size() * sizeof(table_element));
+  });
+  if (!saved) {
+    logg[LResonances].warn("Could not save the EoS table to ", file_name);
+  }
 }
 
 void EosTable::get(EosTable::table_element &res, double e, double nb,
@@ -172,14 +273,14 @@ void EosTable::get(EosTable::table_element &res, double e, double nb,
     const double ae = e / de_ - ie;
     const double an = nb / dnb_ - inb;
     const double aq = q / dq_ - iq;
-    const EosTable::table_element s1 = table_[index(ie, inb, iq)];
-    const EosTable::table_element s2 = table_[index(ie + 1, inb, iq)];
-    const EosTable::table_element s3 = table_[index(ie, inb + 1, iq)];
-    const EosTable::table_element s4 = table_[index(ie + 1, inb + 1, iq)];
-    const EosTable::table_element s5 = table_[index(ie, inb, iq + 1)];
-    const EosTable::table_element s6 = table_[index(ie + 1, inb, iq + 1)];
-    const EosTable::table_element s7 = table_[index(ie, inb + 1, iq + 1)];
-    const EosTable::table_element s8 = table_[index(ie + 1, inb + 1, iq + 1)];
+    const EosTable::table_element s1 = element(index(ie, inb, iq));
+    const EosTable::table_element s2 = element(index(ie + 1, inb, iq));
+    const EosTable::table_element s3 = element(index(ie, inb + 1, iq));
+    const EosTable::table_element s4 = element(index(ie + 1, inb + 1, iq));
+    const EosTable::table_element s5 = element(index(ie, inb, iq + 1));
+    const EosTable::table_element s6 = element(index(ie + 1, inb, iq + 1));
+    const EosTable::table_element s7 = element(index(ie, inb + 1, iq + 1));
+    const EosTable::table_element s8 = element(index(ie + 1, inb + 1, iq + 1));
 
     res.p = interpolate_trilinear(ae, an, aq, s1.p, s2.p, s3.p, s4.p, s5.p,
                                   s6.p, s7.p, s8.p);
@@ -194,6 +295,91 @@ void EosTable::get(EosTable::table_element &res, double e, double nb,
   }
 }
 
+namespace {
+/// Smallest \f$ z = m/T \f$ in the table of Bessel functions
+constexpr double bessel_z_min = 0.05;
+/// Largest \f$ z = m/T \f$ in the table of Bessel functions
+constexpr double bessel_z_max = 500.0;
+/// Distance of the points of the table of Bessel functions in \f$ \ln z \f$
+constexpr double bessel_step = 0.01;
+
+/**
+ * Table of \f$ z^2 e^z K_2(z) \f$ and \f$ z^3 e^z K_1(z) \f$, which appear
+ * in the thermodynamic sums. The points are equidistant in \f$ \ln z \f$
+ * and the functions are interpolated by cubic Hermite polynomials with the
+ * exact derivatives, which gives a relative error of about \f$ 10^{-9} \f$.
+ */
+class ScaledBesselTable {
+ public:
+  /// Tabulate the functions.
+  ScaledBesselTable()
+      : u_min_(std::log(bessel_z_min)),
+        n_points_(static_cast<size_t>(std::ceil(
+                      (std::log(bessel_z_max) - u_min_) / bessel_step)) +
+                  1),
+        values_(4 * n_points_) {
+    for (size_t i = 0; i < n_points_; i++) {
+      const double z = std::exp(u_min_ + i * bessel_step);
+      const double k0 = gsl_sf_bessel_K0_scaled(z);
+      const double k1 = gsl_sf_bessel_K1_scaled(z);
+      const double k2 = gsl_sf_bessel_Kn_scaled(2, z);
+      const double z2 = z * z;
+      // Derivatives with respect to ln z, using K_2' = -K_1 - 2 K_2 / z and
+      // K_1' = -K_0 - K_1 / z
+      values_[4 * i] = z2 * k2;
+      values_[4 * i + 1] = z * (z2 * k2 - z2 * k1);
+      values_[4 * i + 2] = z2 * z * k1;
+      values_[4 * i + 3] = z * z2 * (2 * k1 + z * k1 - z * k0);
+    }
+  }
+
+  /**
+   * \param[in] z mass to temperature ratio \f$ m/T \f$
+   * \param[out] z2_k2 \f$ z^2 e^z K_2(z) \f$
+   * \param[out] z3_k1 \f$ z^3 e^z K_1(z) \f$
+   */
+  void get(double z, double *z2_k2, double *z3_k1) const {
+    if (z < really_small) {
+      // K_n(z) -> (n-1)!/2 *(2/z)^n, z -> 0
+      *z2_k2 = 2.0;
+      *z3_k1 = 0.0;
+      return;
+    }
+    if (z < bessel_z_min || z >= bessel_z_max) {
+      *z2_k2 = z * z * gsl_sf_bessel_Kn_scaled(2, z);
+      *z3_k1 = z * z * z * gsl_sf_bessel_K1_scaled(z);
+      return;
+    }
+    const double t = (std::log(z) - u_min_) * (1.0 / bessel_step);
+    const size_t i = static_cast<size_t>(t);
+    const double s = t - i;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2 * s3 - 3 * s2 + 1;
+    const double h01 = 3 * s2 - 2 * s3;
+    const double h10 = (s3 - 2 * s2 + s) * bessel_step;
+    const double h11 = (s3 - s2) * bessel_step;
+    const double *v = &values_[4 * i];
+    *z2_k2 = h00 * v[0] + h10 * v[1] + h01 * v[4] + h11 * v[5];
+    *z3_k1 = h00 * v[2] + h10 * v[3] + h01 * v[6] + h11 * v[7];
+  }
+
+ private:
+  /// \f$ \ln z \f$ of the first point
+  const double u_min_;
+  /// Number of points
+  const size_t n_points_;
+  /// Both functions and their derivatives with respect to \f$ \ln z \f$
+  std::vector<double> values_;
+};
+
+/// The table of Bessel functions, created at the first use
+const ScaledBesselTable &scaled_bessel_table() {
+  static const ScaledBesselTable table;
+  return table;
+}
+}  // unnamed namespace
+
 HadronGasEos::HadronGasEos(bool tabulate, bool account_for_width)
     : x_(gsl_vector_alloc(n_equations_)),
       tabulate_(tabulate),
@@ -210,11 +396,35 @@ HadronGasEos::HadronGasEos(bool tabulate, bool account_for_width)
         "implemented for energy density computation, so the computed"
         " table will be inconsistent anyways.");
   }
+  auto hadrons = std::make_shared<HadronTable>();
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    if (!is_eos_particle(ptype)) {
+      continue;
+    }
+    hadrons->mass.push_back(ptype.mass());
+    hadrons->degeneracy.push_back(ptype.spin() + 1);
+    hadrons->baryon_number.push_back(ptype.baryon_number());
+    hadrons->strangeness.push_back(ptype.strangeness());
+    hadrons->charge.push_back(ptype.charge());
+  }
+  hadrons_ = hadrons;
   if (tabulate_) {
-    eos_table_.compile_table(*this);
+    auto table =
+        std::make_shared<EosTable>(1.e-1, 1.e-1, 1.e-1, 90, 90, 90);
+    table->compile_table(*this);
+    eos_table_ = table;
   }
 }
 
+HadronGasEos::HadronGasEos(const HadronGasEos &other)
+    : eos_table_(other.eos_table_),
+      hadrons_(other.hadrons_),
+      x_(gsl_vector_alloc(n_equations_)),
+      solver_(gsl_multiroot_fsolver_alloc(gsl_multiroot_fsolver_hybrid,
+                                          n_equations_)),
+      tabulate_(other.tabulate_),
+      account_for_resonance_widths_(other.account_for_resonance_widths_) {}
+
 HadronGasEos::~HadronGasEos() {
   gsl_multiroot_fsolver_free(solver_);
   gsl_vector_free(x_);
@@ -293,7 +503,7 @@ double HadronGasEos::energy_density(double T, double mub, double mus,
     double x = beta * (mub * ptype.baryon_number() + mus * ptype.strangeness() +
                        muq * ptype.charge() - ptype.mass());
     if (x < -500.0) {
-      return 0.0;
+      continue;
     }
     x = std::exp(x);
     const size_t g = ptype.spin() + 1;
@@ -307,6 +517,45 @@ double HadronGasEos::energy_density(double T, double mub, double mus,
   return e;
 }
 
+HadronGasEos::ThermodynamicSums HadronGasEos::thermodynamic_sums(
+    double T, double mub, double mus, double muq) const {
+  ThermodynamicSums sums = {0.0, 0.0, 0.0, 0.0};
+  if (T < really_small) {
+    return sums;
+  }
+  const double beta = 1.0 / T;
+  const ScaledBesselTable &bessel = scaled_bessel_table();
+  const HadronTable &h = *hadrons_;
+  const size_t n_hadrons = h.mass.size();
+  /* This loop is not vectorized, even with -march=native: it calls std::exp
+   * and std::log, which the compiler only vectorizes with -ffast-math, and
+   * the table lookup depends on the data. It is fast, because it needs no
+   * Bessel functions of GSL within the tabulated range. */
+  for (size_t i = 0; i < n_hadrons; i++) {
+    const double z = h.mass[i] * beta;
+    const double x = beta * (mub * h.baryon_number[i] +
+                             mus * h.strangeness[i] + muq * h.charge[i]) -
+                     z;
+    if (x < -500.0) {
+      continue;
+    }
+    double z2_k2, z3_k1;
+    bessel.get(z, &z2_k2, &z3_k1);
+    const double weight = h.degeneracy[i] * std::exp(x);
+    const double n = weight * z2_k2;
+    sums.e += weight * (3.0 * z2_k2 + z3_k1);
+    sums.nb += h.baryon_number[i] * n;
+    sums.ns += h.strangeness[i] * n;
+    sums.nq += h.charge[i] * n;
+  }
+  const double n_factor = prefactor_ * T * T * T;
+  sums.e *= n_factor * T;
+  sums.nb *= n_factor;
+  sums.ns *= n_factor;
+  sums.nq *= n_factor;
+  return sums;
+}
+
 double HadronGasEos::density(double T, double mub, double mus, double muq,
                              bool account_for_width) {
   if (T < really_small) {
@@ -479,28 +728,33 @@ double HadronGasEos::mus_net_strangeness0(double T, double mub, double muq) {
 
 int HadronGasEos::set_eos_solver_equations(const gsl_vector *x, void *params,
                                            gsl_vector *f) {
-  double e = reinterpret_cast<struct rparams *>(params)->e;
-  double nb = reinterpret_cast<struct rparams *>(params)->nb;
-  double ns = reinterpret_cast<struct rparams *>(params)->ns;
-  double nq = reinterpret_cast<struct rparams *>(params)->nq;
-  bool w = reinterpret_cast<struct rparams *>(params)->account_for_width;
+  const rparams *p = reinterpret_cast<const rparams *>(params);
 
   const double T = gsl_vector_get(x, 0);
   const double mub = gsl_vector_get(x, 1);
   const double mus = gsl_vector_get(x, 2);
   const double muq = gsl_vector_get(x, 3);
 
-  gsl_vector_set(f, 0, energy_density(T, mub, mus, muq) - e);
-  gsl_vector_set(f, 1, net_baryon_density(T, mub, mus, muq, w) - nb);
-  gsl_vector_set(f, 2, net_strange_density(T, mub, mus, muq, w) - ns);
-  gsl_vector_set(f, 3, net_charge_density(T, mub, mus, muq, w) - nq);
+  if (p->account_for_width) {
+    const bool w = true;
+    gsl_vector_set(f, 0, energy_density(T, mub, mus, muq) - p->e);
+    gsl_vector_set(f, 1, net_baryon_density(T, mub, mus, muq, w) - p->nb);
+    gsl_vector_set(f, 2, net_strange_density(T, mub, mus, muq, w) - p->ns);
+    gsl_vector_set(f, 3, net_charge_density(T, mub, mus, muq, w) - p->nq);
+  } else {
+    const ThermodynamicSums sums = p->eos->thermodynamic_sums(T, mub, mus, muq);
+    gsl_vector_set(f, 0, sums.e - p->e);
+    gsl_vector_set(f, 1, sums.nb - p->nb);
+    gsl_vector_set(f, 2, sums.ns - p->ns);
+    gsl_vector_set(f, 3, sums.nq - p->nq);
+  }
 
   return GSL_SUCCESS;
 }
 
 double HadronGasEos::e_equation(double T, void *params) {
-  const double edens = reinterpret_cast<struct eparams *>(params)->edens;
-  return edens - energy_density(T, 0.0, 0.0, 0.0);
+  const eparams *p = reinterpret_cast<const eparams *>(params);
+  return p->edens - p->eos->thermodynamic_sums(T, 0.0, 0.0, 0.0).e;
 }
 
 std::array<double, 4> HadronGasEos::solve_eos_initial_approximation(double e,
@@ -519,7 +773,7 @@ std::array<double, 4> HadronGasEos::solve_eos_initial_approximation(double e,
   // Simply assume that the temperature is not higher than 2 GeV.
   const double T_max = 2.0;
 
-  struct eparams parameters = {e};
+  struct eparams parameters = {e, this};
   gsl_function F = {&e_equation, &parameters};
   const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
   gsl_root_fsolver *e_solver;
@@ -586,10 +840,32 @@ std::array<double, 4> HadronGasEos::solve_eos_initial_approximation(double e,
 std::array<double, 4> HadronGasEos::solve_eos(
     double e, double nb, double ns, double nq,
     std::array<double, 4> initial_approximation) {
+  std::array<double, 4> solution;
+  run_eos_solver(e, nb, ns, nq, initial_approximation, true, &solution);
+  return solution;
+}
+
+std::array<double, 4> HadronGasEos::solve_eos_warm_start(
+    double e, double nb, double ns, double nq,
+    const std::array<double, 4> &guess) {
+  if (guess[0] > 0.0) {
+    std::array<double, 4> solution;
+    const int status = run_eos_solver(e, nb, ns, nq, guess, false, &solution);
+    if (status == GSL_SUCCESS && solution[0] > 0.0) {
+      return solution;
+    }
+  }
+  return solve_eos(e, nb, ns, nq);
+}
+
+int HadronGasEos::run_eos_solver(
+    double e, double nb, double ns, double nq,
+    const std::array<double, 4> &initial_approximation, bool warn,
+    std::array<double, 4> *solution) {
   int residual_status = GSL_SUCCESS;
   size_t iter = 0;
 
-  struct rparams p = {e, nb, ns, nq, account_for_resonance_widths_};
+  struct rparams p = {e, nb, ns, nq, account_for_resonance_widths_, this};
   gsl_multiroot_function f = {&HadronGasEos::set_eos_solver_equations,
                               n_equations_, &p};
 
@@ -606,17 +882,19 @@ std::array<double, 4> HadronGasEos::solve_eos(
 
     // Avoiding too low temperature
     if (gsl_vector_get(solver_->x, 0) < 0.015) {
-      return {0.0, 0.0, 0.0, 0.0};
+      *solution = {0.0, 0.0, 0.0, 0.0};
+      return GSL_SUCCESS;
     }
 
     // check if solver is stuck
     if (iterate_status) {
+      residual_status = gsl_multiroot_test_residual(solver_->f, tolerance_);
       break;
     }
     residual_status = gsl_multiroot_test_residual(solver_->f, tolerance_);
   } while (residual_status == GSL_CONTINUE && iter < 1000);
 
-  if (residual_status != GSL_SUCCESS) {
+  if (residual_status != GSL_SUCCESS && warn) {
     std::stringstream solver_parameters;
     solver_parameters << "\nSolver run with "
                       << "e = " << e << ", nb = " << nb << ", ns = " << ns
@@ -629,8 +907,9 @@ std::array<double, 4> HadronGasEos::solve_eos(
                            solver_parameters.str() + print_solver_state(iter));
   }
 
-  return {gsl_vector_get(solver_->x, 0), gsl_vector_get(solver_->x, 1),
-          gsl_vector_get(solver_->x, 2), gsl_vector_get(solver_->x, 3)};
+  *solution = {gsl_vector_get(solver_->x, 0), gsl_vector_get(solver_->x, 1),
+               gsl_vector_get(solver_->x, 2), gsl_vector_get(solver_->x, 3)};
+  return residual_status;
 }
 
 std::string HadronGasEos::print_solver_state(size_t iter) const {
@@ -10,10 +10,12 @@
 #ifndef SRC_INCLUDE_SMASH_ACTION_H_
 #define SRC_INCLUDE_SMASH_ACTION_H_
 
+#include <functional>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "actionarena.h"
 #include "lattice.h"
 #include "particles.h"
 #include "pauliblocking.h"
@@ -88,6 +90,24 @@ class Action {
    */
   virtual ~Action();
 
+  /**
+   * Allocate an action from the ActionArena of the current scope, or from the
+   * heap if there is none.
+   *
+   * \param[in] size Size of the action [bytes].
+   * \return Pointer to the memory of the action.
+   */
+  static void *operator new(std::size_t size) {
+    return ActionArena::allocate(size);
+  }
+
+  /**
+   * Free the memory of an action.
+   *
+   * \param[in] ptr Pointer to the memory of the action.
+   */
+  static void operator delete(void *ptr) { ActionArena::deallocate(ptr); }
+
   /**
    * Determine whether one action takes place before another in time
    *
@@ -222,6 +242,24 @@ class Action {
   bool is_pauli_blocked(const std::vector<Particles> &ensembles,
                         const PauliBlocker &p_bl) const;
 
+  /**
+   * Check if the action is Pauli-blocked, where only the particles of the
+   * ensemble of the action are taken from their current state and the ones of
+   * the other ensembles from an earlier state. This is used if the ensembles
+   * are evolved concurrently.
+   *
+   * \param[in] own_ensemble current particle list of the ensemble, in which
+   *                         the action is performed
+   * \param[in] i_own_ensemble index of this ensemble
+   * \param[in] frozen_ensembles earlier particle lists of all ensembles
+   * \param[in] p_bl PauliBlocker that stores the configurations concerning
+   *                                                              Pauli-blocking.
+   * \return true, if the action is Pauli-blocked, false otherwise
+   */
+  bool is_pauli_blocked(const Particles &own_ensemble, int i_own_ensemble,
+                        const std::vector<ParticleList> &frozen_ensembles,
+                        const PauliBlocker &p_bl) const;
+
   /**
    * Get the list of particles that go into the action.
    *
@@ -485,6 +523,18 @@ class Action {
   }
 
  private:
+  /**
+   * Decide whether the action is Pauli-blocked, given the phase-space density
+   * at the outgoing particles.
+   *
+   * \param[in] phasespace_dens Calculates the phase-space density of the
+   *                            species of the given particle at its position
+   *                            and momentum.
+   * \return true, if the action is Pauli-blocked, false otherwise
+   */
+  bool is_pauli_blocked(
+      const std::function<double(const ParticleData &)> &phasespace_dens) const;
+
   /**
    * Get the type of a given particle
    *
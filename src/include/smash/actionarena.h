@@ -0,0 +1,151 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ACTIONARENA_H_
+#define SRC_INCLUDE_SMASH_ACTIONARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * Memory arena for the actions and process branches of one ensemble within
+ * one time step.
+ *
+ * While a Scope of the arena is active in a thread, all actions (see Action)
+ * and their collision and decay branches (see ProcessBranch) created by this
+ * thread are allocated from the arena instead of the heap. The memory is cut
+ * from large blocks. Freed objects are kept in free lists by their size and
+ * reused for later objects of the same size. release() frees all objects at
+ * once, keeping the blocks for the next time step. Since the objects remember
+ * where they have been allocated, ActionPtr and the branch pointers are used
+ * as usual, no matter whether their objects live in an arena or on the heap.
+ *
+ * An arena must only be used by one thread at a time and all objects
+ * allocated from it have to be destroyed before it is released.
+ */
+class ActionArena {
+ public:
+  /// Allocation statistics of an arena since its last release
+  struct Stats {
+    /// Number of allocated objects
+    std::size_t allocations = 0;
+    /// Number of allocations reusing the memory of a freed object
+    std::size_t reused = 0;
+    /// Number of allocated bytes, including the bookkeeping
+    std::size_t bytes = 0;
+  };
+
+  /**
+   * Guard making an arena the current one of this thread during its lifetime.
+   * The previous arena is restored by the destructor, so scopes can be nested.
+   */
+  class Scope {
+   public:
+    /**
+     * \param[in] arena The arena used for allocations, or nullptr to use the
+     *            heap.
+     */
+    explicit Scope(ActionArena *arena);
+    /// Restore the previous arena
+    ~Scope();
+    /// Cannot be copied
+    Scope(const Scope &) = delete;
+    /// Cannot be copied
+    Scope &operator=(const Scope &) = delete;
+
+   private:
+    /// The arena, which was current before this scope
+    ActionArena *previous_;
+  };
+
+  /// Size of the memory blocks [bytes]
+  static constexpr std::size_t block_size = 1 << 16;
+  /// Larger objects are always allocated on the heap [bytes]
+  static constexpr std::size_t max_object_size = block_size / 16;
+
+  /// Create an empty arena, which allocates its first block when needed.
+  ActionArena() = default;
+  /// Cannot be copied
+  ActionArena(const ActionArena &) = delete;
+  /// Cannot be copied
+  ActionArena &operator=(const ActionArena &) = delete;
+  /// Move constructor
+  ActionArena(ActionArena &&) = default;
+  /// Move assignment
+  ActionArena &operator=(ActionArena &&) = default;
+
+  /**
+   * Free all objects allocated from the arena at once and reset the
+   * statistics, which are logged before.
+   */
+  void release();
+
+  /// \return Allocation statistics since the last release.
+  const Stats &stats() const { return stats_; }
+
+  /// \return Memory held by the arena [bytes].
+  std::size_t capacity() const { return blocks_.size() * block_size; }
+
+  /**
+   * Allocate the memory of an object from the current arena of this thread,
+   * or from the heap if there is none.
+   *
+   * \param[in] size Size of the object [bytes].
+   * \return Pointer to the memory, which is aligned for any type.
+   */
+  static void *allocate(std::size_t size);
+
+  /**
+   * Free memory obtained by allocate. Memory from an arena is reused by the
+   * arena, which it was allocated from.
+   *
+   * \param[in] ptr Pointer returned by allocate or nullptr.
+   */
+  static void deallocate(void *ptr) noexcept;
+
+ private:
+  /// Bookkeeping in front of every allocated object
+  struct Header;
+
+  /**
+   * Take memory from a free list or from the current block.
+   *
+   * \param[in] total Size of the object plus its header [bytes], which is a
+   *            multiple of the alignment.
+   * \return Header of the memory.
+   */
+  Header *take(std::size_t total);
+
+  /**
+   * Put the memory of a freed object into the free list of its size.
+   *
+   * \param[in] header Header of the memory.
+   */
+  void recycle(Header *header);
+
+  /// Memory blocks
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  /// Index of the block, from which memory is taken
+  std::size_t current_block_ = 0;
+  /// Used bytes of the current block
+  std::size_t offset_ = 0;
+  /// Heads of the lists of freed objects, indexed by size / alignment
+  std::vector<Header *> free_lists_;
+  /// Statistics since the last release
+  Stats stats_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ACTIONARENA_H_
@@ -8,11 +8,15 @@
 #define SRC_INCLUDE_SMASH_ACTIONS_H_
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "action.h"
+#include "actionarena.h"
 #include "forwarddeclarations.h"
 
 namespace smash {
@@ -22,14 +26,54 @@ namespace smash {
  *
  * The Actions class abstracts the storage and manipulation of actions.
  *
+ * The actions are stored in a heap ordered by their time of execution. An
+ * index from the particle ids to the actions, in which the particles are
+ * incoming, allows to invalidate all actions of a particle right after it has
+ * interacted (see invalidate). Invalidated actions are left in the heap as
+ * tombstones, which are dropped when they reach the top of the heap or when
+ * the heap is compacted. They are never returned by pop.
+ *
  * \note
  * The Actions object cannot be copied, because it does not make sense
- * semantically. Move semantics make sense and can be implemented when needed.
+ * semantically.
  */
 class Actions {
  public:
+  /// Statistics of an Actions object since it was last cleared
+  struct Stats {
+    /// Number of inserted actions
+    std::size_t inserted = 0;
+    /// Number of actions invalidated by invalidate
+    std::size_t invalidated = 0;
+    /// Number of compactions of the heap
+    std::size_t compactions = 0;
+    /// Largest size of the heap, including invalidated actions
+    std::size_t max_heap_size = 0;
+
+    /// \return Fraction of the inserted actions, which were invalidated.
+    double discard_ratio() const {
+      return inserted > 0 ? static_cast<double>(invalidated) / inserted : 0.;
+    }
+  };
+
+  /**
+   * The heap is compacted when more than this fraction of its entries are
+   * invalidated actions.
+   */
+  static constexpr double compaction_threshold = 0.5;
+  /// Minimal number of invalidated actions in the heap to compact it
+  static constexpr std::size_t min_compaction_size = 64;
+
   /// Default constructor, creating an empty Actions object.
   Actions() {}
+  /**
+   * Creates an empty Actions object, whose actions are allocated from the
+   * given arena by the caller. The arena is released, whenever the Actions
+   * object is cleared.
+   *
+   * \param[in] arena The arena of the actions.
+   */
+  explicit Actions(ActionArena* arena) : arena_(arena) {}
   /**
    * Creates a new Actions object from an ActionList.
    *
@@ -39,7 +83,10 @@ class Actions {
    * \param[in] action_list The ActionList from which to construct the Actions
    *                    object
    */
-  explicit Actions(ActionList&& action_list) : data_(std::move(action_list)) {
+  explicit Actions(ActionList&& action_list) {
+    for (auto& a : action_list) {
+      push_back(std::move(a));
+    }
     std::make_heap(data_.begin(), data_.end(), cmp);
   }
 
@@ -47,6 +94,8 @@ class Actions {
   Actions(const Actions&) = delete;
   /// Cannot be copied
   Actions& operator=(const Actions&) = delete;
+  /// Move constructor
+  Actions(Actions&&) = default;
 
   /// \return whether the list of actions is empty.
   bool is_empty() const { return data_.empty(); }
@@ -56,18 +105,12 @@ class Actions {
    *
    * \throw RuntimeError if the list is empty.
    */
-  ActionPtr pop() {
-    if (data_.empty()) {
-      throw std::runtime_error("Empty actions list!");
-    }
-    std::pop_heap(data_.begin(), data_.end(), cmp);
-    ActionPtr act = std::move(data_.back());
-    data_.pop_back();
-    return act;
-  }
+  ActionPtr pop();
 
   /// Return time of execution of earliest action
-  double earliest_time() const { return data_.front()->time_of_execution(); }
+  double earliest_time() const {
+    return data_.front().action->time_of_execution();
+  }
 
   /**
    * Insert a list of actions into this object.
@@ -90,37 +133,102 @@ class Actions {
    * \param[in] action The action to insert.
    */
   void insert(ActionPtr&& action) {
-    data_.push_back(std::move(action));
+    push_back(std::move(action));
     std::push_heap(data_.begin(), data_.end(), cmp);
   }
 
-  /// \return Number of actions.
-  ActionList::size_type size() const { return data_.size(); }
+  /// \return Number of actions, which have not been invalidated.
+  ActionList::size_type size() const { return data_.size() - n_invalidated_; }
 
-  /// Delete all actions.
-  void clear() { data_.clear(); }
+  /**
+   * Invalidate all actions, in which one of the given particles is incoming,
+   * if the particle is not valid anymore, i.e. it has interacted since it was
+   * copied.
+   *
+   * Call this after performing an action with its incoming particles and
+   * before inserting the actions of its outgoing particles. The heap is
+   * compacted if the invalidated actions exceed the compaction threshold.
+   *
+   * \param[in] incoming Copies of the particles, whose actions are
+   *            invalidated.
+   * \param[in] particles The current particles.
+   * \param[in] count_until Only the invalidated actions up to this time of
+   *            execution are counted, e.g. the ones which would have been
+   *            popped and discarded within the current time step.
+   * \return Number of invalidated actions, which are executed not later than
+   *         count_until.
+   */
+  std::size_t invalidate(
+      const ParticleList& incoming, const Particles& particles,
+      double count_until = std::numeric_limits<double>::infinity());
 
-  /// \return an iterator to the earliest action.
-  std::vector<ActionPtr>::const_reverse_iterator begin() const {
-    return data_.crbegin();
-  }
+  /// Remove all invalidated actions from the heap.
+  void compact();
 
-  /// \return an iterator to the place following the last action.
-  std::vector<ActionPtr>::const_reverse_iterator end() const {
-    return data_.crend();
-  }
+  /**
+   * Delete all actions, reset the statistics and release the arena of the
+   * actions, if there is one. All other objects allocated from the arena have
+   * to be destroyed already.
+   */
+  void clear();
+
+  /// \return Statistics since the last call of clear.
+  const Stats& stats() const { return stats_; }
 
  private:
+  /// An action in the heap
+  struct Entry {
+    /// The action
+    ActionPtr action;
+    /// Index of the slot holding the state of the action
+    std::uint32_t slot;
+  };
+
+  /// State of an action in the heap
+  struct Slot {
+    /// Incremented whenever the slot is freed, to recognize outdated indices
+    std::uint32_t generation = 0;
+    /// Whether the action has been invalidated
+    bool invalidated = false;
+    /// Time of execution of the action
+    double time = 0.;
+  };
+
+  /// Reference to an action in the index
+  struct SlotRef {
+    /// Index of the slot
+    std::uint32_t slot;
+    /// Generation of the slot, when the action was indexed
+    std::uint32_t generation;
+  };
+
   /**
-   * Compare two action pointer such that the maximum is the most recent
-   * action.
+   * Append an action to the heap storage and index it by the ids of its
+   * incoming particles, without restoring the heap property.
    *
-   * \param[in] a First action
-   * \param[in] b Second action
+   * \param[in] action The action to append.
+   */
+  void push_back(ActionPtr&& action);
+
+  /**
+   * Free the slot of an action, which is removed from the heap.
+   *
+   * \param[in] slot Index of the slot.
+   */
+  void free_slot(std::uint32_t slot);
+
+  /// Remove invalidated actions from the top of the heap.
+  void drop_invalidated_top();
+
+  /**
+   * Compare two entries such that the maximum is the most recent action.
+   *
+   * \param[in] a First entry
+   * \param[in] b Second entry
    * \return Whether the first action will be executed later than the second.
    */
-  static bool cmp(const ActionPtr& a, const ActionPtr& b) {
-    return a->time_of_execution() > b->time_of_execution();
+  static bool cmp(const Entry& a, const Entry& b) {
+    return a.action->time_of_execution() > b.action->time_of_execution();
   }
 
   /**
@@ -130,7 +238,28 @@ class Actions {
    * random access iterators. Any linked data structure (e.g. list) thus
    * requires a less efficient sort algorithm.
    */
-  std::vector<ActionPtr> data_;
+  std::vector<Entry> data_;
+
+  /// States of the actions in the heap, indexed by Entry::slot
+  std::vector<Slot> slots_;
+
+  /// Slots, which can be reused
+  std::vector<std::uint32_t> free_slots_;
+
+  /**
+   * Actions of every particle id. The references of actions, which have been
+   * removed from the heap, are outdated and ignored.
+   */
+  std::unordered_map<std::int32_t, std::vector<SlotRef>> index_;
+
+  /// Number of invalidated actions in the heap
+  std::size_t n_invalidated_ = 0;
+
+  /// Statistics since the last call of clear
+  Stats stats_;
+
+  /// Arena of the actions, nullptr if they are allocated on the heap
+  ActionArena* arena_ = nullptr;
 };
 
 }  // namespace smash
@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ASCIIBUFFER_H_
+#define SRC_INCLUDE_SMASH_ASCIIBUFFER_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace smash {
+
+/// Maximal number of characters written by format_g and format_int
+constexpr std::size_t max_formatted_length = 32;
+
+/**
+ * Format a number like std::printf with the conversion "%.<precision>g".
+ *
+ * The digits are computed with a single multiplication by an exact power of
+ * ten, which is much faster than printf. If the number is not finite, its
+ * exponent is too large, the precision exceeds 9 digits or the number is too
+ * close to the middle between two results to decide the rounding, std::printf
+ * is used instead, so the result is always identical.
+ *
+ * \param[in] x The number.
+ * \param[in] precision Number of significant digits.
+ * \param[out] out Memory for at least max_formatted_length characters, which
+ *             is not null-terminated.
+ * \return Pointer behind the last written character.
+ */
+char *format_g(double x, int precision, char *out);
+
+/**
+ * Format an integer like std::printf with the conversion "%i".
+ *
+ * \param[in] x The integer.
+ * \param[out] out Memory for at least max_formatted_length characters, which
+ *             is not null-terminated.
+ * \return Pointer behind the last written character.
+ */
+char *format_int(int x, char *out);
+
+/**
+ * \ingroup output
+ *
+ * Buffer for formatted ASCII output to a file.
+ *
+ * The text is collected in memory and written to the file in large chunks,
+ * when the buffer is full, by flush and by the destructor. Numbers are
+ * formatted by format_g and format_int. Everything written to the file has to
+ * pass the buffer to keep the order.
+ */
+class AsciiBuffer {
+ public:
+  /// Size of the buffer [bytes]
+  static constexpr std::size_t capacity = 1 << 16;
+
+  /**
+   * Create an empty buffer.
+   *
+   * \param[in] file The file, which the text is written to.
+   */
+  explicit AsciiBuffer(std::FILE *file);
+
+  /// Write the remaining text to the file.
+  ~AsciiBuffer();
+
+  /// Cannot be copied
+  AsciiBuffer(const AsciiBuffer &) = delete;
+  /// Cannot be copied
+  AsciiBuffer &operator=(const AsciiBuffer &) = delete;
+
+  /**
+   * Append a character.
+   * \param[in] c The character.
+   */
+  void append(char c) { *reserve(1) = c; size_++; }
+
+  /**
+   * Append a string.
+   * \param[in] s The string.
+   */
+  void append(const std::string &s);
+
+  /**
+   * Append an integer like "%i".
+   * \param[in] x The integer.
+   */
+  void append(int x) {
+    char *begin = reserve(max_formatted_length);
+    size_ += format_int(x, begin) - begin;
+  }
+
+  /**
+   * Append a number like "%.<precision>g".
+   * \param[in] x The number.
+   * \param[in] precision Number of significant digits.
+   */
+  void append_g(double x, int precision) {
+    char *begin = reserve(max_formatted_length);
+    size_ += format_g(x, precision, begin) - begin;
+  }
+
+  /**
+   * Append text formatted by std::printf.
+   * \param[in] format The format string.
+   */
+  void printf(const char *format, ...);
+
+  /// Write the text to the file and flush the file.
+  void flush();
+
+ private:
+  /**
+   * Make room for characters, writing the buffer to the file if necessary.
+   *
+   * \param[in] n Number of characters, at most capacity.
+   * \return Pointer to the end of the text.
+   */
+  char *reserve(std::size_t n) {
+    if (size_ + n > capacity) {
+      write_out();
+    }
+    return data_.get() + size_;
+  }
+
+  /// Write the text to the file and empty the buffer.
+  void write_out();
+
+  /// The file
+  std::FILE *file_;
+  /// The text
+  std::unique_ptr<char[]> data_;
+  /// Length of the text
+  std::size_t size_ = 0;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ASCIIBUFFER_H_
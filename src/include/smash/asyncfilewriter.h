@@ -0,0 +1,168 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_ASYNCFILEWRITER_H_
+#define SRC_INCLUDE_SMASH_ASYNCFILEWRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Writes data to a file in a background thread.
+ *
+ * The data passed to write is copied into large in-memory blocks. Full blocks
+ * are handed over to a writer thread, which writes them to the file in the
+ * order they were written, so the calling thread does not wait for the file
+ * system. At most a fixed number of blocks can be pending: if the writer
+ * thread falls behind, write waits until a block has been written, which
+ * bounds the memory.
+ *
+ * Errors of the writer thread are rethrown as std::runtime_error by the next
+ * call of write, flush or sync.
+ *
+ * Usage:
+ * \code
+ * FilePtr file = fopen(path, "wb");
+ * AsyncFileWriter writer(file.get());
+ * writer.write(&x, sizeof(x));
+ * writer.flush();  // does not wait for the data to be written
+ * writer.sync();   // waits for the data to be written
+ * \endcode
+ *
+ * The file must not be accessed otherwise, while the writer exists.
+ */
+class AsyncFileWriter {
+ public:
+  /// Default size of the blocks [bytes]
+  static constexpr std::size_t default_block_size = 1 << 20;
+  /// Default maximal number of blocks waiting to be written
+  static constexpr std::size_t default_max_pending_blocks = 8;
+
+  /**
+   * Start the writer thread.
+   *
+   * \param[in] file The file, which the data is written to.
+   * \param[in] block_size Size of the blocks [bytes].
+   * \param[in] max_pending_blocks Maximal number of full blocks, which wait
+   *            to be written.
+   * \throw std::invalid_argument if the block size or the number of blocks is
+   *        zero.
+   */
+  explicit AsyncFileWriter(
+      std::FILE *file, std::size_t block_size = default_block_size,
+      std::size_t max_pending_blocks = default_max_pending_blocks);
+
+  /**
+   * Write all remaining data and stop the writer thread. Errors are logged,
+   * since they cannot be thrown anymore.
+   */
+  ~AsyncFileWriter();
+
+  /// Cannot be copied
+  AsyncFileWriter(const AsyncFileWriter &) = delete;
+  /// Cannot be copied
+  AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+
+  /**
+   * Append data to the current block. The block is handed over to the writer
+   * thread, when it is full.
+   *
+   * \param[in] data The data.
+   * \param[in] size Number of bytes.
+   */
+  void write(const void *data, std::size_t size) {
+    if (size <= block_size_ - current_.size()) {
+      const char *bytes = static_cast<const char *>(data);
+      current_.insert(current_.end(), bytes, bytes + size);
+    } else {
+      write_across_blocks(data, size);
+    }
+  }
+
+  /**
+   * Hand over the current block to the writer thread, which flushes the file
+   * after writing it. Does not wait for the data to be written.
+   */
+  void flush();
+
+  /// Hand over the current block and wait until all data is written.
+  void sync();
+
+ private:
+  /// A block of data, which waits to be written
+  struct Block {
+    /// The data
+    std::vector<char> data;
+    /// Whether to flush the file after writing the data
+    bool flush;
+  };
+
+  /**
+   * Write data, which does not fit into the current block.
+   *
+   * \param[in] data The data.
+   * \param[in] size Number of bytes.
+   */
+  void write_across_blocks(const void *data, std::size_t size);
+
+  /**
+   * Hand over the current block to the writer thread and start a new one.
+   * Waits if the maximal number of blocks are pending.
+   *
+   * \param[in] flush Whether to flush the file after writing the block.
+   */
+  void submit(bool flush);
+
+  /// Rethrow an error of the writer thread. mutex_ has to be locked.
+  void rethrow_error();
+
+  /// Main loop of the writer thread.
+  void writer_loop();
+
+  /// The file
+  std::FILE *file_;
+  /// Size of the blocks [bytes]
+  const std::size_t block_size_;
+  /// Maximal number of pending blocks
+  const std::size_t max_pending_blocks_;
+  /// The block, which is currently filled
+  std::vector<char> current_;
+  /// Protects the state shared with the writer thread
+  std::mutex mutex_;
+  /// Signals the writer thread that a block is pending or it should stop
+  std::condition_variable work_condition_;
+  /// Signals the calling thread that a block has been written
+  std::condition_variable written_condition_;
+  /// Blocks waiting to be written
+  std::deque<Block> pending_;
+  /// Written blocks, whose memory is reused
+  std::vector<std::vector<char>> spare_;
+  /// Whether the writer thread currently writes a block
+  bool busy_ = false;
+  /// Whether the writer thread should stop
+  bool stop_ = false;
+  /// The first error of the writer thread
+  std::exception_ptr error_;
+  /// The writer thread
+  std::thread thread_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_ASYNCFILEWRITER_H_
@@ -15,8 +15,10 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 
+#include "asyncfilewriter.h"
 #include "file.h"
 #include "forwarddeclarations.h"
+#include "fourvector.h"
 #include "outputinterface.h"
 #include "outputparameters.h"
 
@@ -25,6 +27,9 @@ namespace smash {
 /**
  * \ingroup output
  * Base class for SMASH binary output.
+ *
+ * The output is serialized into memory blocks, which are written to the file
+ * by a background thread (see AsyncFileWriter).
  */
 class BinaryOutputBase : public OutputInterface {
  protected:
@@ -43,7 +48,7 @@ class BinaryOutputBase : public OutputInterface {
    * Write byte to binary output.
    * \param[in] c Value to be written.
    */
-  void write(const char c);
+  void write(const char c) { writer_.write(&c, sizeof(c)); }
 
   /**
    * Write string to binary output.
@@ -55,37 +60,33 @@ class BinaryOutputBase : public OutputInterface {
    * Write double to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const double x);
+  void write(const double x) { writer_.write(&x, sizeof(x)); }
 
   /**
    * Write four-vector to binary output.
    * \param[in] v Four-vector to be written.
    */
-  void write(const FourVector &v);
+  void write(const FourVector &v) {
+    writer_.write(v.begin(), 4 * sizeof(*v.begin()));
+  }
 
   /**
    * Write integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::int32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::int32_t x) { writer_.write(&x, sizeof(x)); }
 
   /**
    * Write unsigned integer (32 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint32_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint32_t x) { writer_.write(&x, sizeof(x)); }
 
   /**
    * Write unsigned integer (16 bit) to binary output.
    * \param[in] x Value to be written.
    */
-  void write(const std::uint16_t x) {
-    std::fwrite(&x, sizeof(x), 1, file_.get());
-  }
+  void write(const std::uint16_t x) { writer_.write(&x, sizeof(x)); }
 
   /**
    * Write a std::size_t to binary output.
@@ -111,10 +112,20 @@ class BinaryOutputBase : public OutputInterface {
    */
   void write_particledata(const ParticleData &p);
 
+  /**
+   * Write the end of an event and flush the output to disk, without waiting
+   * for it.
+   * \param[in] event_number Number of event.
+   * \param[in] event Event info, see \ref event_info
+   */
+  void write_event_end(const int32_t event_number, const EventInfo &event);
+
+ private:
   /// Binary particles output file path
   RenamingFilePtr file_;
+  /// Writes the output to the file, it is destroyed before the file is closed
+  AsyncFileWriter writer_;
 
- private:
   /// Binary file format version number
   const uint16_t format_version_ = 7;
   /// Option for extended output
@@ -90,6 +90,9 @@ class BoxModus : public ModusDefault {
   int impose_boundary_conditions(Particles *particles,
                                  const OutputsList &output_list = {});
 
+  /// The type of the Grid created by create_grid
+  using GridType = Grid<GridOptions::PeriodicBoundaries>;
+
   /// \copydoc smash::ModusDefault::create_grid
   Grid<GridOptions::PeriodicBoundaries> create_grid(
       const Particles &particles, double min_cell_length,
@@ -0,0 +1,90 @@
+/*
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ */
+
+#ifndef SRC_INCLUDE_SMASH_CACHEFILE_H_
+#define SRC_INCLUDE_SMASH_CACHEFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "sha256.h"
+
+namespace smash {
+
+/**
+ * Common header of the binary cache files, like the EoS table, the nucleus
+ * configuration pools and the tabulation archive. Each kind of file extends
+ * it by its own fields, after which its data follows.
+ */
+struct CacheFileHeader {
+  /// Identifies the kind of file
+  char magic[8];
+  /// Version of the file format
+  std::uint32_t version;
+  /// Size of one stored element in bytes
+  std::uint32_t element_size;
+  /// Hash of the parameters from which the content was computed
+  sha256::Hash hash;
+
+  /**
+   * Create a header.
+   *
+   * \param[in] magic Identifies the kind of file.
+   * \param[in] version Version of the file format.
+   * \param[in] element_size Size of one stored element in bytes.
+   * \param[in] hash Hash of the parameters of the content.
+   * \return The header.
+   */
+  static CacheFileHeader create(const char (&magic)[8], std::uint32_t version,
+                                std::uint32_t element_size,
+                                const sha256::Hash &hash);
+
+  /**
+   * \param[in] other Header to compare with.
+   * \return Whether both headers are equal in all fields.
+   */
+  bool operator==(const CacheFileHeader &other) const;
+};
+static_assert(sizeof(CacheFileHeader) % sizeof(double) == 0,
+              "The data following the header has to be aligned.");
+
+/**
+ * Map a cache file read-only into memory. The mapping is shared by all
+ * processes mapping the file.
+ *
+ * \param[in] file_name Name of the file.
+ * \param[in] header Expected common header at the beginning of the file.
+ * \param[in] min_size Minimal size of the file in bytes, including the header.
+ * \param[out] size Size of the file in bytes.
+ * \return Pointer to the beginning of the file, which keeps it mapped as long
+ *         as a copy exists, or nullptr if the file does not exist, is smaller
+ *         than min_size or has a different header.
+ */
+std::shared_ptr<const void> map_cache_file(const std::string &file_name,
+                                           const CacheFileHeader &header,
+                                           std::size_t min_size,
+                                           std::size_t *size);
+
+/**
+ * Save a cache file. The content is written to a temporary file first, which
+ * then replaces the file by renaming it. Concurrent processes therefore never
+ * read a partially written file and do not need to lock the cache.
+ *
+ * \param[in] file_name Name of the file.
+ * \param[in] write Writes the content to the given stream.
+ * \return Whether the file was saved.
+ */
+bool save_cache_file(const std::string &file_name,
+                     const std::function<void(std::ofstream &)> &write);
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_CACHEFILE_H_
@@ -7,6 +7,7 @@
 #ifndef SRC_INCLUDE_SMASH_COLLIDERMODUS_H_
 #define SRC_INCLUDE_SMASH_COLLIDERMODUS_H_
 
+#include <cstdint>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -99,6 +100,26 @@ class ColliderModus : public ModusDefault {
    **/
   void sample_impact();
 
+  /**
+   * Sample the configuration pools of the projectile and the target, if
+   * requested by Nucleus_Pool in the configuration.
+   *
+   * \param[in] seed Seed of the run. The pools are sampled from a random
+   *            number sequence derived from it, which differs from the
+   *            sequences of the events.
+   * \see Nucleus::create_configuration_pool
+   */
+  void create_nucleus_pools(int64_t seed);
+
+  /**
+   * Draw the nucleus configurations from the pools of another modus instead
+   * of sampling own pools, see Nucleus::share_configuration_pool.
+   *
+   * \param[in] other The modus, whose pools were created by
+   *            create_nucleus_pools.
+   */
+  void share_nucleus_pools(const ColliderModus &other);
+
   /// Time until nuclei have passed through each other
   double nuclei_passing_time() const {
     const double passing_distance =
@@ -214,6 +235,17 @@ class ColliderModus : public ModusDefault {
   std::unique_ptr<InterpolateDataLinear<double>> impact_interpolation_ =
       nullptr;
 
+  /// Number of configurations per nucleus pool, 0 without pools
+  int pool_size_ = 0;
+  /// Threads used to sample the nucleus pools
+  int pool_threads_ = 1;
+  /// Directory, in which the nucleus pools are cached, empty to not cache
+  std::string pool_directory_;
+  /// Whether the projectile is a custom nucleus, which needs no pool
+  bool projectile_is_custom_ = false;
+  /// Whether the target is a custom nucleus, which needs no pool
+  bool target_is_custom_ = false;
+
   /**
    * Rotate the reaction plane about the angle phi
    *
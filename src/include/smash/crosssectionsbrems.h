@@ -85,11 +85,11 @@ const std::initializer_list<double> BREMS_THETA = {
 // (opposite charge incoming pions, charged pions in final state)
  */
 ///@{
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     pipi_pipi_opp_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pipi_opp_dsigma_dk_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pipi_opp_dsigma_dtheta_interpolation = nullptr;
 ///@}
 
@@ -8965,11 +8965,11 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA = {
     or π- + π- -> π- + π- + γ processes (same charge incoming pions)
  */
 ///@{
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     pipi_pipi_same_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pipi_same_dsigma_dk_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pipi_same_dsigma_dtheta_interpolation = nullptr;
 ///@}
 
@@ -18750,11 +18750,11 @@ const std::initializer_list<double> BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA = {
 /** @name Interpolation objects for π + π0 -> π + π0 + γ processes
  */
 ///@{
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     pipi0_pipi0_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi0_pipi0_dsigma_dk_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi0_pipi0_dsigma_dtheta_interpolation = nullptr;
 ///@}
 
@@ -27635,11 +27635,11 @@ const std::initializer_list<double> BREMS_PIPI0_PIPI0_DIFF_SIG_THETA = {
 /** @name Interpolation objects for π+- + π-+ -> π0 + π0 + γ processes
  */
 ///@{
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     pipi_pi0pi0_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pi0pi0_dsigma_dk_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pipi_pi0pi0_dsigma_dtheta_interpolation = nullptr;
 ///@}
 
@@ -35878,11 +35878,11 @@ const std::initializer_list<double> BREMS_PIPI_PI0PI0_DIFF_SIG_THETA = {
 /** @name Interpolation objects for π0 + π0 -> π+- + π-+ + γ processes
  */
 ///@{
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     pi0pi0_pipi_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pi0pi0_pipi_dsigma_dk_interpolation = nullptr;
-static std::unique_ptr<InterpolateData2DSpline>
+static thread_local std::unique_ptr<InterpolateData2DSpline>
     pi0pi0_pipi_dsigma_dtheta_interpolation = nullptr;
 ///@}
 
@@ -45,6 +45,9 @@ class DecayModes {
    * \param[in] branch the decay branch to add
    */
   void add_mode(DecayBranchPtr branch) {
+    if (branch->type().is_dilepton_decay()) {
+      dilepton_mode_indices_.push_back(decay_modes_.size());
+    }
     decay_modes_.push_back(std::move(branch));
   }
 
@@ -62,6 +65,14 @@ class DecayModes {
   /// \return pass out the decay modes list
   const DecayBranchList &decay_mode_list() const { return decay_modes_; }
 
+  /// \return true if there is at least one dilepton decay mode
+  bool has_dilepton_modes() const { return !dilepton_mode_indices_.empty(); }
+
+  /// \return the indices of the dilepton decay modes in decay_mode_list
+  const std::vector<std::size_t> &dilepton_mode_indices() const {
+    return dilepton_mode_indices_;
+  }
+
   /**
    * Loads the DecayModes map as described in the \p input string.
    *
@@ -122,6 +133,9 @@ class DecayModes {
    */
   DecayBranchList decay_modes_;
 
+  /// Indices of the dilepton decay modes in decay_modes_
+  std::vector<std::size_t> dilepton_mode_indices_;
+
   /// allow ParticleType::decay_modes to access all_decay_modes
   friend const DecayModes &ParticleType::decay_modes() const;
 
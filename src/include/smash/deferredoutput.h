@@ -0,0 +1,262 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
+#define SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "action.h"
+#include "outputinterface.h"
+#include "particles.h"
+#include "threevector.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * A copy of the information of a performed action that is available to the
+ * outputs: the incoming and outgoing particles, the time of execution, the
+ * process type and the weights.
+ *
+ * It is used to store interactions and pass them to the outputs later. It can
+ * neither generate a final state nor be performed again.
+ */
+class RecordedAction : public Action {
+ public:
+  /**
+   * Copy the output information from a performed action.
+   *
+   * \param[in] action The performed action
+   */
+  explicit RecordedAction(const Action &action)
+      : Action(action.incoming_particles(), action.outgoing_particles(),
+               action.time_of_execution(), action.get_type()),
+        total_weight_(action.get_total_weight()),
+        partial_weight_(action.get_partial_weight()) {}
+
+  /**
+   * Recorded actions outlive the time step, so they are always allocated on
+   * the heap instead of an ActionArena.
+   *
+   * \param[in] size Size of the action [bytes].
+   * \return Pointer to the memory of the action.
+   */
+  static void *operator new(std::size_t size) { return ::operator new(size); }
+
+  /**
+   * Free the memory of a recorded action.
+   *
+   * \param[in] ptr Pointer to the memory of the action.
+   */
+  static void operator delete(void *ptr) { ::operator delete(ptr); }
+
+  /// \return The total weight of the original action.
+  double get_total_weight() const override { return total_weight_; }
+
+  /// \return The partial weight of the original action.
+  double get_partial_weight() const override { return partial_weight_; }
+
+  /**
+   * Does nothing, the final state is already known.
+   */
+  void generate_final_state() override {}
+
+ protected:
+  /**
+   * Writes information about the recorded action to the output stream.
+   *
+   * \param[out] out The ostream into which to output
+   */
+  void format_debug_output(std::ostream &out) const override {
+    out << "Recorded " << get_type() << " of " << incoming_particles_
+        << " to " << outgoing_particles_;
+  }
+
+ private:
+  /// Total weight of the original action
+  const double total_weight_;
+  /// Partial weight of the original action
+  const double partial_weight_;
+};
+
+/**
+ * \ingroup output
+ *
+ * An output that records all interactions and passes them to another output
+ * later, when flush() is called.
+ *
+ * If several ensembles are evolved concurrently, every ensemble writes its
+ * interactions into its own DeferredOutput objects. Flushing them in the order
+ * of the ensembles afterwards yields the same order of interactions in the
+ * output files as a serial evolution, independent of the scheduling of the
+ * threads.
+ *
+ * The DeferredOutput reports itself as dilepton, photon or initial conditions
+ * output exactly if the target output does, such that it receives the same
+ * interactions as the target would.
+ */
+class DeferredOutput : public OutputInterface {
+ public:
+  /**
+   * Create a DeferredOutput for the given output.
+   *
+   * \param[in] target The output to which the interactions are passed in
+   *                   flush(). It has to outlive this object.
+   */
+  explicit DeferredOutput(OutputInterface *target);
+
+  /**
+   * Record the interaction.
+   *
+   * \param[in] action The performed action.
+   * \param[in] density The density at the interaction point.
+   */
+  void at_interaction(const Action &action, const double density) override;
+
+  /**
+   * Pass all recorded interactions to the target output in the order in which
+   * they were recorded and forget them.
+   */
+  void flush();
+
+ private:
+  /// The output to which the recorded interactions are passed
+  OutputInterface *target_;
+
+  /// Recorded interactions and densities at the interaction points
+  std::vector<std::pair<std::unique_ptr<RecordedAction>, double>> recorded_;
+};
+
+/**
+ * \ingroup output
+ *
+ * An output that records all calls of the output hooks, together with copies
+ * of their arguments, such that they can be passed to another output later.
+ *
+ * If several events are run concurrently, every event writes into its own
+ * RecordingOutput objects. Replaying the recorded calls event by event in the
+ * order of the event numbers yields the same output files as a serial run,
+ * independent of the scheduling of the threads.
+ *
+ * Particles are copied including their ids. The clock passed to
+ * at_intermediate_time is replaced by a UniformClock showing the same time.
+ * Like DeferredOutput, the RecordingOutput reports the same output category
+ * as the output it stands in for.
+ *
+ * The thermalizer output (thermodynamics_output(const GrandCanThermalizer &))
+ * is not recorded, because the thermalizer cannot be copied. The only output
+ * using it is the VTK thermodynamics output, which has to be written
+ * directly.
+ */
+class RecordingOutput : public OutputInterface {
+ public:
+  /// A recorded call of an output hook, which can be applied to any output
+  using RecordedCall = std::function<void(OutputInterface &)>;
+
+  /**
+   * Create a RecordingOutput that imitates the given output.
+   *
+   * \param[in] target The output whose category is imitated. It is not
+   *                   accessed afterwards.
+   */
+  explicit RecordingOutput(const OutputInterface &target);
+
+  /// Record the call, see OutputInterface
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &info) override;
+  /// Record the call, see OutputInterface
+  void at_eventstart(const std::vector<Particles> &ensembles,
+                     int event_number) override;
+  /// Record the call, see OutputInterface
+  void at_eventstart(const int event_number, const ThermodynamicQuantity tq,
+                     const DensityType dens_type,
+                     RectangularLattice<DensityOnLattice> lattice) override;
+  /// Record the call, see OutputInterface
+  void at_eventstart(const int event_number, const ThermodynamicQuantity tq,
+                     const DensityType dens_type,
+                     RectangularLattice<EnergyMomentumTensor> lattice) override;
+  /// Record the call, see OutputInterface
+  void at_eventend(const int event_number, const ThermodynamicQuantity tq,
+                   const DensityType dens_type) override;
+  /// Record the call, see OutputInterface
+  void at_eventend(const ThermodynamicQuantity tq) override;
+  /// Record the call, see OutputInterface
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &info) override;
+  /// Record the call, see OutputInterface
+  void at_eventend(const std::vector<Particles> &ensembles,
+                   const int event_number) override;
+  /// Record the call, see OutputInterface
+  void at_interaction(const Action &action, const double density) override;
+  /// Record the call, see OutputInterface
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param,
+                            const EventInfo &info) override;
+  /// Record the call, see OutputInterface
+  void at_intermediate_time(const std::vector<Particles> &ensembles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param) override;
+  /// Record the call, see OutputInterface
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<DensityOnLattice> &lattice) override;
+  /// Record the call, see OutputInterface
+  void thermodynamics_output(
+      const ThermodynamicQuantity tq, const DensityType dt,
+      RectangularLattice<EnergyMomentumTensor> &lattice) override;
+  /// Record the call, see OutputInterface
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice,
+      const double current_time) override;
+  /// Record the call, see OutputInterface
+  void thermodynamics_lattice_output(
+      RectangularLattice<DensityOnLattice> &lattice, const double current_time,
+      const std::vector<Particles> &ensembles,
+      const DensityParameters &dens_param) override;
+  /// Record the call, see OutputInterface
+  void thermodynamics_lattice_output(
+      const ThermodynamicQuantity tq,
+      RectangularLattice<EnergyMomentumTensor> &lattice,
+      const double current_time) override;
+  /// Record the call, see OutputInterface
+  void fields_output(
+      const std::string name1, const std::string name2,
+      RectangularLattice<std::pair<ThreeVector, ThreeVector>> &lat) override;
+
+  /**
+   * Hand over all recorded calls and forget them.
+   *
+   * \return The recorded calls in the order in which they were made.
+   */
+  std::vector<RecordedCall> release_recorded();
+
+  /**
+   * Apply recorded calls to an output.
+   *
+   * \param[in] calls Calls as returned by release_recorded().
+   * \param[in] target The output that receives the calls.
+   */
+  static void replay(const std::vector<RecordedCall> &calls,
+                     OutputInterface *target);
+
+ private:
+  /// The recorded calls
+  std::vector<RecordedCall> recorded_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_DEFERREDOUTPUT_H_
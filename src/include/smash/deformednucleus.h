@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_SMASH_DEFORMEDNUCLEUS_H_
 
 #include <map>
+#include <string>
 
 #include "angles.h"
 #include "configuration.h"
@@ -149,6 +150,16 @@ class DeformedNucleus : public Nucleus {
    */
   inline double get_beta4() { return beta4_; }
 
+ protected:
+  /**
+   * Rotates the nucleons by a random angle about the z-axis, which is the
+   * symmetry axis of the deformed nucleus before rotate orients it.
+   */
+  void rotate_randomly() override;
+
+  /// \return The parameters of the base class and the deformation.
+  std::string position_distribution_parameters() const override;
+
  private:
   /// Deformation parameter for angular momentum l=2.
   double beta2_ = 0.0;
@@ -9,6 +9,9 @@
 #ifndef SRC_INCLUDE_SMASH_DENSITY_H_
 #define SRC_INCLUDE_SMASH_DENSITY_H_
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <tuple>
 #include <typeinfo>
@@ -23,6 +26,7 @@
 #include "particledata.h"
 #include "particles.h"
 #include "pdgcode.h"
+#include "threadpool.h"
 #include "threevector.h"
 
 namespace smash {
@@ -279,6 +283,114 @@ current_eckart(const ThreeVector &r, const Particles &plist,
                const DensityParameters &par, DensityType dens_type,
                bool compute_gradient, bool smearing);
 
+/**
+ * Calculates the four-currents \f$ j^\mu \f$ of several density types at the
+ * centers of all cells of a lattice, as current_eckart does for a single
+ * point (second entry of its result).
+ *
+ * Instead of looping over all particles for every cell, every particle is
+ * deposited into the cells within \f$ r_{cut} \f$ of its position, like in
+ * update_lattice. This gives the same currents up to rounding, because the
+ * smearing factor vanishes beyond \f$ r_{cut} \f$. Without smearing every
+ * particle contributes equally to all cells, so the currents are the same
+ * everywhere.
+ *
+ * \tparam T Type of the lattice nodes; only the geometry of the lattice is
+ *           used.
+ * \tparam N Number of density types.
+ * \param[in] lattice Lattice, at whose cell centers the currents are needed.
+ * \param[in] ensembles Particles of all ensembles.
+ * \param[in] par Parameters of the smearing.
+ * \param[in] dens_types Density types, for which the currents are calculated.
+ * \param[in] smearing Whether to use gaussian smearing, see current_eckart.
+ * \return For every cell (with index ix + nx (iy + iz ny)) the currents of
+ *         the density types in the given order.
+ */
+template <typename T, std::size_t N>
+std::vector<std::array<FourVector, N>> currents_at_cell_centers(
+    const RectangularLattice<T> &lattice,
+    const std::vector<Particles> &ensembles, const DensityParameters &par,
+    const std::array<DensityType, N> &dens_types, bool smearing) {
+  const std::array<int, 3> &n_cells = lattice.n_cells();
+  const std::array<double, 3> &cell_sizes = lattice.cell_sizes();
+  const std::array<double, 3> &origin = lattice.origin();
+  std::vector<std::array<FourVector, N>> currents(lattice.size());
+
+  if (!smearing) {
+    std::array<FourVector, N> total;
+    for (const Particles &particles : ensembles) {
+      for (std::size_t i = 0; i < N; i++) {
+        total[i] += std::get<1>(current_eckart(ThreeVector(), particles, par,
+                                               dens_types[i], false, false));
+      }
+    }
+    std::fill(currents.begin(), currents.end(), total);
+    return currents;
+  }
+
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &part : particles) {
+      if (par.only_participants()) {
+        // if this conditions holds, the hadron is a spectator
+        if (part.get_history().collisions_per_particle == 0) {
+          continue;
+        }
+      }
+      std::array<double, N> dens_factors;
+      bool contributes = false;
+      for (std::size_t i = 0; i < N; i++) {
+        dens_factors[i] = density_factor(part.type(), dens_types[i]);
+        if (std::fabs(dens_factors[i]) < really_small) {
+          dens_factors[i] = 0.;
+        } else {
+          contributes = true;
+        }
+      }
+      const FourVector mom = part.momentum();
+      const double m = mom.abs();
+      if (!contributes || m < really_small) {
+        continue;
+      }
+      const double m_inv = 1.0 / m;
+      const FourVector unit_current = mom * (par.norm_factor_sf() / mom.x0());
+      const ThreeVector pos = part.position().threevec();
+
+      /* The cells with centers within r_cut of the particle in every
+       * direction. Periodic lattices are not wrapped around, because
+       * current_eckart does not do that either. */
+      std::array<int, 3> low, high;
+      for (int k = 0; k < 3; k++) {
+        low[k] = std::max(
+            0, static_cast<int>(std::ceil(
+                   (pos[k] - origin[k] - par.r_cut()) / cell_sizes[k] - 0.5)));
+        high[k] = std::min(
+            n_cells[k] - 1,
+            static_cast<int>(std::floor(
+                (pos[k] - origin[k] + par.r_cut()) / cell_sizes[k] - 0.5)));
+      }
+      for (int iz = low[2]; iz <= high[2]; iz++) {
+        for (int iy = low[1]; iy <= high[1]; iy++) {
+          for (int ix = low[0]; ix <= high[0]; ix++) {
+            const ThreeVector r = lattice.cell_center(ix, iy, iz);
+            const double sf =
+                unnormalized_smearing_factor(pos - r, mom, m_inv, par, false)
+                    .first;
+            if (sf == 0.) {
+              continue;
+            }
+            std::array<FourVector, N> &cell =
+                currents[ix + n_cells[0] * (iy + iz * n_cells[1])];
+            for (std::size_t i = 0; i < N; i++) {
+              cell[i] += unit_current * (dens_factors[i] * sf);
+            }
+          }
+        }
+      }
+    }
+  }
+  return currents;
+}
+
 /**
  * A class for time-efficient (time-memory trade-off) calculation of density
  * on the lattice. It holds six FourVectors - positive and negative
@@ -520,28 +632,32 @@ class DensityOnLattice {
 typedef RectangularLattice<DensityOnLattice> DensityLattice;
 
 /**
- * Updates the contents on the lattice.
+ * Adds the smeared contributions of the particles to the nodes of one slab of
+ * the lattice, i.e. to the nodes whose z-index lies in [z_begin, z_end). The
+ * nodes outside of the slab are not touched.
+ *
+ * Every node receives the contributions in the order of the particles, so
+ * filling the lattice slab by slab gives exactly the same result as filling
+ * it at once. Particles whose smearing does not reach the slab are skipped
+ * without evaluating the smearing kernel.
  *
  * \param[out] lat The lattice on which the content will be updated
- * \param[in] update tells if called for update at printout or at timestep
  * \param[in] dens_type density type to be computed on the lattice
  * \param[in] par a structure containing testparticles number and gaussian
  *            smearing parameters.
  * \param[in] ensembles the particles vector for each ensemble
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] z_begin First z-index of the slab
+ * \param[in] z_end One past the last z-index of the slab
  * \tparam T LatticeType
  */
 template <typename T>
-void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
-                    const DensityType dens_type, const DensityParameters &par,
-                    const std::vector<Particles> &ensembles,
-                    const bool compute_gradient) {
-  // Do not proceed if lattice does not exists/update not required
-  if (lat == nullptr || lat->when_update() != update) {
-    return;
-  }
-
-  lat->reset();
+void deposit_particles_in_slab(RectangularLattice<T> *lat,
+                               const DensityType dens_type,
+                               const DensityParameters &par,
+                               const std::vector<Particles> &ensembles,
+                               const bool compute_gradient, const int z_begin,
+                               const int z_end) {
   // get the normalization factor for the covariant Gaussian smearing
   const double norm_factor_gaus = par.norm_factor_sf();
   // get the volume of the cell and weights for discrete smearing
@@ -561,6 +677,45 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
        triangular_radius[0] * triangular_radius[1] * triangular_radius[1] *
        triangular_radius[2] * triangular_radius[2]);
 
+  // restriction of the nodes and particles to the slab
+  const int n_z = lat->n_cells()[2];
+  const bool whole_lattice = z_begin <= 0 && z_end >= n_z;
+  const int nodes_per_layer = lat->n_cells()[0] * lat->n_cells()[1];
+  const T *const first_node = &(*lat)[0];
+  const auto in_slab = [&](const T &node) {
+    if (whole_lattice) {
+      return true;
+    }
+    const int iz = static_cast<int>(&node - first_node) / nodes_per_layer;
+    return iz >= z_begin && iz < z_end;
+  };
+  // largest z-distance from a particle to the centers of the nodes it reaches
+  const double dz = lat->cell_sizes()[2];
+  const double reach_z = par.smearing() == SmearingMode::CovariantGaussian
+                             ? par.r_cut()
+                             : par.smearing() == SmearingMode::Triangular
+                                   ? triangular_radius[2]
+                                   : dz;
+  const auto reaches_slab = [&](const ThreeVector &pos) {
+    if (whole_lattice) {
+      return true;
+    }
+    // conservative range of z-indices [lo, hi) reached by the particle
+    const double z_cells = (pos.x3() - lat->origin()[2]) / dz;
+    int lo = static_cast<int>(std::floor(z_cells - reach_z / dz)) - 1;
+    const int length =
+        static_cast<int>(std::floor(z_cells + reach_z / dz)) + 2 - lo;
+    if (!lat->periodic()) {
+      return lo < z_end && lo + length > z_begin;
+    }
+    if (length >= n_z) {
+      return true;
+    }
+    lo = ((lo % n_z) + n_z) % n_z;
+    return (lo < z_end && lo + length > z_begin) ||
+           lo + length - n_z > z_begin;
+  };
+
   for (const Particles &particles : ensembles) {
     for (const ParticleData &part : particles) {
       if (par.only_participants()) {
@@ -575,21 +730,31 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
       }
       const FourVector p_mu = part.momentum();
       const ThreeVector pos = part.position().threevec();
-
-      // act accordingly to which smearing is used
-      if (par.smearing() == SmearingMode::CovariantGaussian) {
-        const double m = p_mu.abs();
-        if (unlikely(m < really_small)) {
+      const double m = p_mu.abs();
+      if (par.smearing() == SmearingMode::CovariantGaussian &&
+          unlikely(m < really_small)) {
+        // only warn once if the lattice is filled slab by slab
+        if (z_begin <= 0) {
           logg[LDensity].warn("Gaussian smearing is undefined for momentum ",
                               p_mu);
-          continue;
         }
+        continue;
+      }
+      if (!reaches_slab(pos)) {
+        continue;
+      }
+
+      // act accordingly to which smearing is used
+      if (par.smearing() == SmearingMode::CovariantGaussian) {
         const double m_inv = 1.0 / m;
 
         // unweighted contribution to density
         const double common_weight = dens_factor * norm_factor_gaus;
         lat->iterate_in_cube(
             pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
+              if (!in_slab(node)) {
+                return;
+              }
               // find the weight for smearing
               const ThreeVector r = lat->cell_center(ix, iy, iz);
               const auto sf = unnormalized_smearing_factor(
@@ -606,6 +771,9 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
             dens_factor / (par.ntest() * par.nensembles() * V_cell);
         lat->iterate_nearest_neighbors(
             pos, [&](T &node, int iterated_index, int center_index) {
+              if (!in_slab(node)) {
+                return;
+              }
               node.add_particle(
                   part, common_weight *
                             // the contribution to density is weighted depending
@@ -617,6 +785,9 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
         const double common_weight = dens_factor * prefactor_triangular;
         lat->iterate_in_rectangle(
             pos, triangular_radius, [&](T &node, int ix, int iy, int iz) {
+              if (!in_slab(node)) {
+                return;
+              }
               // compute the position of the node
               const ThreeVector cell_center = lat->cell_center(ix, iy, iz);
               // compute smearing weight
@@ -635,6 +806,95 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
   }    // end of for (const Particles &particles : ensembles)
 }
 
+/**
+ * Divides the lattice into slabs along the z-direction, such that every slab
+ * contains roughly the same number of particles.
+ *
+ * \param[in] lat The lattice to be divided
+ * \param[in] ensembles the particles vector for each ensemble
+ * \param[in] n_slabs Maximal number of slabs
+ * \return The z-indices of the slab bounds, starting with 0 and ending with
+ *         the number of cells in z-direction. Slabs are never empty, so there
+ *         may be fewer than n_slabs of them.
+ * \tparam T LatticeType
+ */
+template <typename T>
+std::vector<int> lattice_slab_bounds(const RectangularLattice<T> &lat,
+                                     const std::vector<Particles> &ensembles,
+                                     const int n_slabs) {
+  const int n_z = lat.n_cells()[2];
+  // number of particles in every layer of cells
+  std::vector<int> layer_count(n_z, 0);
+  int n_particles = 0;
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &part : particles) {
+      const double z = part.position().x3();
+      int iz = static_cast<int>(
+          std::floor((z - lat.origin()[2]) / lat.cell_sizes()[2]));
+      iz = lat.periodic() ? ((iz % n_z) + n_z) % n_z
+                          : std::min(std::max(iz, 0), n_z - 1);
+      layer_count[iz]++;
+      n_particles++;
+    }
+  }
+  std::vector<int> bounds = {0};
+  int counted = 0;
+  for (int iz = 0; iz < n_z - 1; iz++) {
+    counted += layer_count[iz];
+    const int slab = static_cast<int>(bounds.size());
+    if (slab < n_slabs &&
+        counted * static_cast<double>(n_slabs) >= slab * n_particles) {
+      bounds.push_back(iz + 1);
+    }
+  }
+  bounds.push_back(n_z);
+  return bounds;
+}
+
+/**
+ * Updates the contents on the lattice.
+ *
+ * If a thread pool is given, the lattice is divided into slabs along the
+ * z-direction (see lattice_slab_bounds), which are filled concurrently. Each
+ * node is only written by one thread and receives the contributions in the
+ * same order as in the serial update, so the result does not depend on the
+ * number of threads.
+ *
+ * \param[out] lat The lattice on which the content will be updated
+ * \param[in] update tells if called for update at printout or at timestep
+ * \param[in] dens_type density type to be computed on the lattice
+ * \param[in] par a structure containing testparticles number and gaussian
+ *            smearing parameters.
+ * \param[in] ensembles the particles vector for each ensemble
+ * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool Threads used to fill the lattice, serial if nullptr
+ * \tparam T LatticeType
+ */
+template <typename T>
+void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
+                    const DensityType dens_type, const DensityParameters &par,
+                    const std::vector<Particles> &ensembles,
+                    const bool compute_gradient, ThreadPool *pool = nullptr) {
+  // Do not proceed if lattice does not exists/update not required
+  if (lat == nullptr || lat->when_update() != update) {
+    return;
+  }
+
+  lat->reset();
+  const int n_z = lat->n_cells()[2];
+  if (pool == nullptr || pool->size() < 2 || n_z < 2) {
+    deposit_particles_in_slab(lat, dens_type, par, ensembles, compute_gradient,
+                              0, n_z);
+    return;
+  }
+  const std::vector<int> bounds =
+      lattice_slab_bounds(*lat, ensembles, pool->size());
+  pool->parallel_for(static_cast<int>(bounds.size()) - 1, [&](int i) {
+    deposit_particles_in_slab(lat, dens_type, par, ensembles, compute_gradient,
+                              bounds[i], bounds[i + 1]);
+  });
+}
+
 /**
  * Updates the contents on the lattice of DensityOnLattice type.
  *
@@ -653,6 +913,7 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
  * \param[in] ensembles The particles vector for each ensemble
  * \param[in] time_step Time step used in the simulation
  * \param[in] compute_gradient Whether to compute the gradients
+ * \param[in] pool Threads used to fill the lattice, serial if nullptr
  */
 void update_lattice(
     RectangularLattice<DensityOnLattice> *lat,
@@ -661,7 +922,8 @@ void update_lattice(
     RectangularLattice<std::array<FourVector, 4>> *four_grad_lattice,
     const LatticeUpdate update, const DensityType dens_type,
     const DensityParameters &par, const std::vector<Particles> &ensembles,
-    const double time_step, const bool compute_gradient);
+    const double time_step, const bool compute_gradient,
+    ThreadPool *pool = nullptr);
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_SMASH_DENSITY_H_
@@ -8,8 +8,12 @@
 #define SRC_INCLUDE_SMASH_EXPERIMENT_H_
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,6 +24,7 @@
 #include "chrono.h"
 #include "decayactionsfinder.h"
 #include "decayactionsfinderdilepton.h"
+#include "deferredoutput.h"
 #include "energymomentumtensor.h"
 #include "fields.h"
 #include "fourvector.h"
@@ -36,6 +41,7 @@
 #include "scatteractionsfinder.h"
 #include "stringprocess.h"
 #include "thermalizationaction.h"
+#include "threadpool.h"
 // Output
 #include "binaryoutput.h"
 #ifdef SMASH_USE_HEPMC
@@ -208,7 +214,8 @@ class Experiment : public ExperimentBase {
    * of the object. Thus, all values that remain were not used. \param[in]
    * output_path The directory where the output files are written.
    */
-  explicit Experiment(Configuration config, const bf::path &output_path);
+  explicit Experiment(Configuration config, const bf::path &output_path)
+      : Experiment(config, output_path, config.to_string(), nullptr) {}
 
   /**
    * This is called in the beginning of each event. It initializes particles
@@ -249,6 +256,11 @@ class Experiment : public ExperimentBase {
   /// Getter for all ensembles
   std::vector<Particles> *all_ensembles() { return &ensembles_; }
 
+  /// \return Number of discarded actions in the current event
+  uint64_t discarded_interactions_total() const {
+    return discarded_interactions_total_;
+  }
+
   /**
    * Provides external access to SMASH calculation modus. This is helpful if
    * SMASH is used as a 3rd-party library.
@@ -256,6 +268,60 @@ class Experiment : public ExperimentBase {
   Modus *modus() { return &modus_; }
 
  private:
+  /**
+   * Create a new Experiment, which is either the main experiment of a run or
+   * one of its event workers.
+   *
+   * \param[in] config See the public constructor.
+   * \param[in] output_path See the public constructor. Event workers get an
+   *            empty path.
+   * \param[in] config_yaml Copy of the complete configuration, from which the
+   *            configurations of the event workers are created.
+   * \param[in] main_experiment The experiment owning this event worker, or
+   *            nullptr for the main experiment. Event workers write into
+   *            RecordingOutput objects standing in for the outputs of the main
+   *            experiment.
+   */
+  Experiment(Configuration config, const bf::path &output_path,
+             const std::string &config_yaml, const Experiment *main_experiment);
+
+  /**
+   * Run the event with the current event number and seed: initialization,
+   * time evolution, final decays and output at the event end.
+   */
+  void run_event();
+
+  /**
+   * Run all events on the event workers, see Event_Threads in
+   * \ref input_general_.
+   *
+   * Every worker repeatedly takes the next event number together with its
+   * seed, runs the event and hands in the recorded output. The recorded
+   * output is written to the outputs strictly in the order of the events and
+   * the stopping criterion is evaluated in the same order, so the output files
+   * are identical to the ones of a serial run.
+   */
+  void run_events_concurrently();
+
+  /**
+   * \param[in] event Number of an event
+   * \return Whether the event might be needed, if all previous events are
+   *         calculated.
+   */
+  bool may_start_event(int event) const;
+
+  /**
+   * Draw the seed of the following event from the random number generator,
+   * which has to be seeded with the seed of the current event.
+   *
+   * The seed has to be positive, so it can be entered in the config. We have to
+   * be careful about the minimal integer, whose absolute value cannot be
+   * represented.
+   *
+   * \return Seed of the following event.
+   */
+  static int64_t draw_next_event_seed();
+
   /**
    * Perform the given action.
    *
@@ -286,9 +352,9 @@ class Experiment : public ExperimentBase {
    * and shine dileptons.
    *
    * \param[in] to_time Time at the end of propagation [fm/c]
-   * \param[in, out] particles Particles to be propagated
+   * \param[in] i_ensemble index of the ensemble to be propagated
    */
-  void propagate_and_shine(double to_time, Particles &particles);
+  void propagate_and_shine(double to_time, int i_ensemble);
 
   /**
    * Performs all the propagations and actions during a certain time interval
@@ -307,6 +373,42 @@ class Experiment : public ExperimentBase {
                                        const double end_time_propagation,
                                        const double end_time_run);
 
+  /**
+   * Call \p evolve for every ensemble.
+   *
+   * If several ensemble threads are used, the calls are performed concurrently
+   * and every ensemble uses its own random number generator. The interactions
+   * are written to deferred outputs meanwhile, which are flushed in the order
+   * of the ensembles afterwards. Otherwise the ensembles are evolved one after
+   * another. In both cases the interaction counters of the ensembles are
+   * added to the totals afterwards.
+   *
+   * \param[in] evolve Evolution of one ensemble for the given index
+   */
+  void evolve_ensembles(const std::function<void(int)> &evolve);
+
+  /**
+   * Add the interactions counted per ensemble to the totals and reset the
+   * counters of the ensembles.
+   */
+  void merge_ensemble_counters();
+
+  /**
+   * \param[in] n_performed Number of interactions, which the ensemble has
+   *            performed since its counters were last merged.
+   * \param[in] i_ensemble Index of the ensemble.
+   * \return The process id of the next interaction of the ensemble.
+   */
+  uint64_t process_id(uint64_t n_performed, int i_ensemble) const;
+
+  /**
+   * \param[in] i_ensemble index of an ensemble
+   * \return The outputs that receive the interactions of the given ensemble.
+   */
+  const OutputsList &outputs_for(int i_ensemble) const {
+    return evolving_concurrently_ ? deferred_outputs_[i_ensemble] : outputs_;
+  }
+
   /// Intermediate output during an event
   void intermediate_output();
 
@@ -391,9 +493,10 @@ class Experiment : public ExperimentBase {
 
   /**
    * Whether the projectile and the target collided.
-   * One value for each ensemble.
+   * One value for each ensemble. (Not a vector<bool>, because different
+   * ensembles may set their value concurrently.)
    */
-  std::vector<bool> projectile_target_interact_;
+  std::vector<char> projectile_target_interact_;
 
   /**
    * The initial nucleons in the ColliderModus propagate with
@@ -639,6 +742,14 @@ class Experiment : public ExperimentBase {
    */
   uint64_t interactions_total_ = 0;
 
+  /**
+   * Largest process id handed out so far in this event. In a serial
+   * evolution, it equals interactions_total_. While the ensembles are evolved
+   * concurrently, every ensemble takes every n-th id after it, where n is
+   * the number of ensembles, such that the ids of all ensembles are distinct.
+   */
+  uint64_t process_id_offset_ = 0;
+
   /**
    *  Total number of interactions for previous timestep.
    *  For timestepless mode the whole run time is considered as one timestep.
@@ -687,6 +798,102 @@ class Experiment : public ExperimentBase {
   /// random seed for the next event.
   int64_t seed_ = -1;
 
+  /**
+   * Numbers of interactions in one ensemble, which are not yet added to the
+   * totals of the event.
+   */
+  struct EnsembleCounters {
+    /// Number of performed interactions, see interactions_total_
+    uint64_t interactions = 0;
+    /// Number of wall crossings, see wall_actions_total_
+    uint64_t wall_actions = 0;
+    /// Number of Pauli-blocked actions, see total_pauli_blocked_
+    uint64_t pauli_blocked = 0;
+    /// Number of hypersurface crossings, see
+    /// total_hypersurface_crossing_actions_
+    uint64_t hypersurface_crossing_actions = 0;
+    /// Number of discarded actions, see discarded_interactions_total_
+    uint64_t discarded_interactions = 0;
+    /// Energy removed by hypersurface crossings, see total_energy_removed_
+    double energy_removed = 0.0;
+  };
+
+  /**
+   * Interaction counters for every ensemble. While an ensemble is evolved, the
+   * totals are not changed, such that the ensembles can be evolved
+   * concurrently. Afterwards the counters are added to the totals in
+   * merge_ensemble_counters().
+   */
+  std::vector<EnsembleCounters> ensemble_counters_;
+
+  /**
+   * Threads to evolve the ensembles concurrently. Only created, if more than
+   * one thread is requested by Ensemble_Threads.
+   */
+  std::unique_ptr<ThreadPool> ensemble_pool_;
+
+  /**
+   * Threads to fill the density lattices concurrently. Only created, if more
+   * than one thread is requested by the Threads option of the Lattice section.
+   */
+  std::unique_ptr<ThreadPool> lattice_pool_;
+
+  /**
+   * Grid of every ensemble, which is kept from time step to time step to
+   * reuse its memory. Only created when it is needed for the first time.
+   */
+  std::vector<std::unique_ptr<typename Modus::GridType>> grids_;
+
+  /**
+   * Memory arena of every ensemble, from which the actions and branches found
+   * within one time step are allocated. It is released when the actions of
+   * the ensemble are cleared at the beginning of the next time step.
+   */
+  std::vector<ActionArena> action_arenas_;
+
+  /**
+   * Random number generator of every ensemble, which is used while the
+   * ensembles are evolved concurrently. They are seeded from the event seed,
+   * such that the result does not depend on the thread scheduling.
+   */
+  std::vector<random::Engine> ensemble_engines_;
+
+  /**
+   * Factors of the rejection sampling of resonance masses of every ensemble,
+   * which are used while the ensembles are evolved concurrently. They are
+   * reset at the beginning of every event, such that the result does not
+   * depend on the thread scheduling.
+   */
+  std::vector<ParticleType::RejectionFactors> ensemble_rejection_factors_;
+
+  /**
+   * Factors of the rejection sampling of resonance masses, which are used
+   * while this experiment runs an event on its own thread (see
+   * Event_Threads). They are reset at the beginning of every event.
+   */
+  ParticleType::RejectionFactors event_rejection_factors_;
+
+  /**
+   * For every ensemble one DeferredOutput per output, which records the
+   * interactions while the ensembles are evolved concurrently.
+   */
+  std::vector<OutputsList> deferred_outputs_;
+
+  /**
+   * Particles of all ensembles at the beginning of the current concurrent
+   * evolution, used for the Pauli blocking of the other ensembles.
+   */
+  std::vector<ParticleList> pauli_snapshot_;
+
+  /// Whether the ensembles are currently evolved concurrently
+  bool evolving_concurrently_ = false;
+
+  /**
+   * Experiments that run complete events on their own threads. Only created,
+   * if more than one thread is requested by Event_Threads.
+   */
+  std::vector<std::unique_ptr<Experiment>> event_workers_;
+
   /**
    * \ingroup logging
    * Writes the initial state for the Experiment to the output stream.
@@ -1070,7 +1277,9 @@ ExperimentParameters create_experiment_parameters(Configuration config);
   \endverbatim
  */
 template <typename Modus>
-Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
+Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path,
+                              const std::string &config_yaml,
+                              const Experiment *main_experiment)
     : parameters_(create_experiment_parameters(config)),
       density_param_(DensityParameters(parameters_)),
       modus_(config["Modi"], parameters_),
@@ -1140,6 +1349,39 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
   logg[LExperiment].info("Using ", parameters_.n_ensembles,
                          " parallel ensembles.");
 
+  ensemble_pool_ =
+      make_thread_pool(parameters_.n_ensemble_threads,
+                       "General: Ensemble_Threads", parameters_.n_ensembles);
+  if (ensemble_pool_) {
+    logg[LExperiment].info("Evolving the ensembles with ",
+                           ensemble_pool_->size(), " threads.");
+    // Evaluate the lazily cached quantities before they are read concurrently
+    ParticleType::precompute_lazy_quantities();
+  } else if (parameters_.n_ensemble_threads != 1) {
+    logg[LExperiment].warn(
+        "Ensemble_Threads has no effect for a single ensemble.");
+  }
+  ensemble_counters_.resize(parameters_.n_ensembles);
+  grids_.resize(parameters_.n_ensembles);
+  action_arenas_.resize(parameters_.n_ensembles);
+
+  int n_event_threads = number_of_threads(
+      config.take({"General", "Event_Threads"}, 1), "General: Event_Threads");
+  if (main_experiment != nullptr) {
+    // Event workers run one event at a time.
+    n_event_threads = 1;
+  } else if (n_event_threads > 1) {
+    if (modus_.is_list()) {
+      throw std::invalid_argument(
+          "Event_Threads cannot be used with the List and ListBox modi, "
+          "because their events are read sequentially from files.");
+    }
+    n_event_threads = std::min(
+        n_event_threads, event_counting_ == EventCounting::FixedNumber
+                             ? std::max(1, nevents_)
+                             : max_events_);
+  }
+
   // create finders
   if (dileptons_switch_) {
     dilepton_finder_ = make_unique<DecayActionsFinderDilepton>();
@@ -1171,6 +1413,9 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     max_transverse_distance_sqr_ =
         scat_finder->max_transverse_distance_sqr(parameters_.testparticles);
     process_string_ptr_ = scat_finder->get_process_string_ptr();
+    if (process_string_ptr_ != NULL && ensemble_pool_) {
+      process_string_ptr_->set_reseed_per_collision(true);
+    }
     action_finders_.emplace_back(std::move(scat_finder));
   } else {
     max_transverse_distance_sqr_ =
@@ -1561,6 +1806,18 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
       create_output(format, content, output_path, output_parameters);
     }
   }
+  if (main_experiment != nullptr) {
+    for (const auto &output : main_experiment->outputs_) {
+      outputs_.emplace_back(make_unique<RecordingOutput>(*output));
+    }
+    printout_full_lattice_any_td_ =
+        main_experiment->printout_full_lattice_any_td_;
+    printout_full_lattice_ascii_td_ =
+        main_experiment->printout_full_lattice_ascii_td_;
+    printout_full_lattice_binary_td_ =
+        main_experiment->printout_full_lattice_binary_td_;
+    printout_lattice_td_ = main_experiment->printout_lattice_td_;
+  }
 
   /* We can take away the Fermi motion flag, because the collider modus is
    * already initialized. We only need it when potentials are enabled, but we
@@ -1746,6 +2003,12 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
    * Include potential effects, since mean field potentials change the threshold
    * energies of the actions.
    *
+   * \key Threads (int, optional, default = 1): \n
+   *      Number of threads used to compute the densities on the lattice. A
+   *      value of 0 uses all available hardware threads. The lattice is split
+   *      into slabs along the z-direction, which are filled concurrently. The
+   *      results are identical for any number of threads.
+   *
    * For information on the format of the lattice output see
    * \ref output_vtk_lattice_ or \ref thermodyn_lattice_output_. To configure
    * the thermodynamic output, see \ref input_output_options_.
@@ -1841,6 +2104,12 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
         config.take({"Lattice", "Origin"}, origin_default);
     const bool periodic =
         config.take({"Lattice", "Periodic"}, periodic_default);
+    lattice_pool_ = make_thread_pool(config.take({"Lattice", "Threads"}, 1),
+                                     "Lattice: Threads");
+    if (lattice_pool_) {
+      logg[LExperiment].info("Computing the lattice densities with ",
+                             lattice_pool_->size(), " threads.");
+    }
 
     logg[LExperiment].info()
         << "Lattice is ON. Origin = (" << origin[0] << "," << origin[1] << ","
@@ -1976,9 +2245,46 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     thermalizer_ = modus_.create_grandcan_thermalizer(th_conf);
   }
 
+  if (ensemble_pool_) {
+    ensemble_engines_.resize(parameters_.n_ensembles);
+    ensemble_rejection_factors_.resize(parameters_.n_ensembles);
+    pauli_snapshot_.resize(parameters_.n_ensembles);
+    deferred_outputs_.resize(parameters_.n_ensembles);
+    for (OutputsList &deferred : deferred_outputs_) {
+      for (const auto &output : outputs_) {
+        deferred.emplace_back(make_unique<DeferredOutput>(output.get()));
+      }
+    }
+  }
+
   /* Take the seed setting only after the configuration was stored to a file
    * in smash.cc */
   seed_ = config.take({"General", "Randomseed"});
+  /* The event threads draw from the pools of the main experiment, which are
+   * created before the threads. */
+  if (main_experiment != nullptr) {
+    modus_.share_nucleus_pools(main_experiment->modus_);
+  } else {
+    modus_.create_nucleus_pools(seed_);
+  }
+
+  if (n_event_threads > 1) {
+    if (thermalizer_ && printout_lattice_td_) {
+      throw std::invalid_argument(
+          "Event_Threads cannot be used together with the VTK thermodynamics "
+          "output of the forced thermalization.");
+    }
+    logg[LExperiment].info("Running the events with ", n_event_threads,
+                           " threads.");
+    // Evaluate the lazily cached quantities before they are read concurrently
+    ParticleType::precompute_lazy_quantities();
+    for (int i = 0; i < n_event_threads; i++) {
+      /* The constructor is private, so make_unique cannot be used. The
+       * workers do not create output files, but record their output. */
+      event_workers_.emplace_back(new Experiment(
+          Configuration(config_yaml.c_str()), "", config_yaml, this));
+    }
+  }
 }
 
 /// String representing a horizontal line.
@@ -2059,16 +2365,8 @@ template <typename Modus>
 void Experiment<Modus>::initialize_new_event() {
   random::set_seed(seed_);
   logg[LExperiment].info() << "random number seed: " << seed_;
-  /* Set seed for the next event. It has to be positive, so it can be entered
-   * in the config.
-   *
-   * We have to be careful about the minimal integer, whose absolute value
-   * cannot be represented. */
-  int64_t r = random::advance();
-  while (r == INT64_MIN) {
-    r = random::advance();
-  }
-  seed_ = std::abs(r);
+  // Set seed for the next event.
+  seed_ = draw_next_event_seed();
   /* Set the random seed used in PYTHIA hadronization
    * to be same with the SMASH one.
    * In this way we ensure that the results are reproducible
@@ -2140,9 +2438,11 @@ void Experiment<Modus>::initialize_new_event() {
   wall_actions_total_ = 0;
   previous_wall_actions_total_ = 0;
   interactions_total_ = 0;
+  process_id_offset_ = 0;
   previous_interactions_total_ = 0;
   discarded_interactions_total_ = 0;
   total_pauli_blocked_ = 0;
+  ensemble_counters_.assign(parameters_.n_ensembles, EnsembleCounters());
   projectile_target_interact_.assign(parameters_.n_ensembles, false);
   total_hypersurface_crossing_actions_ = 0;
   total_energy_removed_ = 0.0;
@@ -2162,7 +2462,8 @@ void Experiment<Modus>::initialize_new_event() {
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::Baryon,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_pool_.get());
       // Because there was no lattice at t=-Delta_t, the time derivatives
       // drho_dt and dj^mu/dt at t=0 are huge, while they shouldn't be; we
       // overwrite the time derivative to zero by hand.
@@ -2248,25 +2549,42 @@ void Experiment<Modus>::initialize_new_event() {
           FourVector(gamma * m, 0.0, 0.0, gamma * v_beam * m));
     }  // loop over particles
   }
+
+  /* Every ensemble gets its own random number sequence for the concurrent
+   * evolution, derived from the seed of this event, and starts with fresh
+   * factors of the mass sampling. */
+  for (random::Engine &engine : ensemble_engines_) {
+    engine.seed(random::advance());
+  }
+  for (ParticleType::RejectionFactors &factors : ensemble_rejection_factors_) {
+    factors.reset();
+  }
 }
 
 template <typename Modus>
 bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
                                        bool include_pauli_blocking) {
   Particles &particles = ensembles_[i_ensemble];
+  EnsembleCounters &counters = ensemble_counters_[i_ensemble];
   // Make sure to skip invalid and Pauli-blocked actions.
   if (!action.is_valid(particles)) {
-    discarded_interactions_total_++;
+    counters.discarded_interactions++;
     logg[LExperiment].debug(~einhard::DRed(), "✘ ", action,
                             " (discarded: invalid)");
     return false;
   }
   action.generate_final_state();
   logg[LExperiment].debug("Process Type is: ", action.get_type());
-  if (include_pauli_blocking && pauli_blocker_ &&
-      action.is_pauli_blocked(ensembles_, *pauli_blocker_)) {
-    total_pauli_blocked_++;
-    return false;
+  if (include_pauli_blocking && pauli_blocker_) {
+    const bool blocked =
+        evolving_concurrently_
+            ? action.is_pauli_blocked(particles, i_ensemble, pauli_snapshot_,
+                                      *pauli_blocker_)
+            : action.is_pauli_blocked(ensembles_, *pauli_blocker_);
+    if (blocked) {
+      counters.pauli_blocked++;
+      return false;
+    }
   }
 
   // Prepare projectile_target_interact_, it's used for output
@@ -2287,15 +2605,20 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
 
   /* Make sure to pick a non-zero integer, because 0 is reserved for "no
    * interaction yet". */
-  const auto id_process = static_cast<uint32_t>(interactions_total_ + 1);
+  const auto id_process =
+      static_cast<uint32_t>(process_id(counters.interactions, i_ensemble));
   action.perform(&particles, id_process);
-  interactions_total_++;
+  if (pauli_blocker_) {
+    pauli_blocker_->update_index(i_ensemble, action.incoming_particles(),
+                                 action.outgoing_particles());
+  }
+  counters.interactions++;
   if (action.get_type() == ProcessType::Wall) {
-    wall_actions_total_++;
+    counters.wall_actions++;
   }
   if (action.get_type() == ProcessType::HyperSurfaceCrossing) {
-    total_hypersurface_crossing_actions_++;
-    total_energy_removed_ += action.incoming_particles()[0].momentum().x0();
+    counters.hypersurface_crossing_actions++;
+    counters.energy_removed += action.incoming_particles()[0].momentum().x0();
   }
   // Calculate Eckart rest frame density at the interaction point
   double rho = 0.0;
@@ -2324,7 +2647,8 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
    * their x coordinates would be 0.1 and 9.9 fm and interaction point
    * position could be either at 10 fm or at 5 fm.
    */
-  for (const auto &output : outputs_) {
+  const OutputsList &outputs = outputs_for(i_ensemble);
+  for (const auto &output : outputs) {
     if (!output->is_dilepton_output() && !output->is_photon_output()) {
       if (output->is_IC_output() &&
           action.get_type() == ProcessType::HyperSurfaceCrossing) {
@@ -2366,7 +2690,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual photon reaction channel.
     photon_act.add_single_process();
 
-    photon_act.perform_photons(outputs_);
+    photon_act.perform_photons(outputs);
   }
 
   if (bremsstrahlung_switch_ &&
@@ -2396,7 +2720,7 @@ bool Experiment<Modus>::perform_action(Action &action, int i_ensemble,
     // Now add the actual bremsstrahlung reaction channel.
     brems_act.add_single_process();
 
-    brems_act.perform_bremsstrahlung(outputs_);
+    brems_act.perform_bremsstrahlung(outputs);
   }
 
   logg[LExperiment].debug(~einhard::Green(), "✔ ", action);
@@ -2411,6 +2735,13 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
         std::min(parameters_.labclock->timestep_duration(), t_end - t);
     logg[LExperiment].debug("Timestepless propagation for next ", dt, " fm/c.");
 
+    /* The Pauli blocking index is kept up to date by perform_action, apart
+     * from the propagation until the end of this time step. */
+    if (pauli_blocker_) {
+      pauli_blocker_->build_index(
+          ensembles_, std::min(parameters_.labclock->next_time(), t_end) - t);
+    }
+
     // Perform forced thermalization if required
     if (thermalizer_ &&
         thermalizer_->is_time_to_thermalize(parameters_.labclock)) {
@@ -2427,28 +2758,39 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
         if (th_act.any_particles_thermalized()) {
           perform_action(th_act, i_ens);
         }
+        merge_ensemble_counters();
       }
     }
 
-    std::vector<Actions> actions(parameters_.n_ensembles);
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+    std::vector<Actions> actions;
+    actions.reserve(parameters_.n_ensembles);
+    for (ActionArena &arena : action_arenas_) {
+      actions.emplace_back(&arena);
+    }
+    evolve_ensembles([&](int i_ens) {
+      ActionArena::Scope arena_scope(&action_arenas_[i_ens]);
       actions[i_ens].clear();
       if (ensembles_[i_ens].size() > 0 && action_finders_.size() > 0) {
-        /* (1.a) Create grid. */
+        /* (1.a) Create grid, or sort the particles into the grid of the
+         * previous time step. */
         const double min_cell_length = compute_min_cell_length(dt);
         logg[LExperiment].debug("Creating grid with minimal cell length ",
                                 min_cell_length);
         /* For the hyper-surface-crossing actions also unformed particles are
          * searched and therefore needed on the grid. */
         const bool include_unformed_particles = IC_output_switch_;
-        const auto &grid =
-            use_grid_ ? modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles)
-                      : modus_.create_grid(ensembles_[i_ens], min_cell_length,
-                                           dt, parameters_.coll_crit,
-                                           include_unformed_particles,
-                                           CellSizeStrategy::Largest);
+        std::unique_ptr<typename Modus::GridType> &grid_ptr = grids_[i_ens];
+        if (grid_ptr) {
+          grid_ptr->update(ensembles_[i_ens], min_cell_length, dt,
+                           include_unformed_particles);
+        } else {
+          grid_ptr = make_unique<typename Modus::GridType>(modus_.create_grid(
+              ensembles_[i_ens], min_cell_length, dt, parameters_.coll_crit,
+              include_unformed_particles,
+              use_grid_ ? CellSizeStrategy::Optimal
+                        : CellSizeStrategy::Largest));
+        }
+        const auto &grid = *grid_ptr;
 
         const double gcell_vol = grid.cell_volume();
         /* (1.b) Iterate over cells and find actions. */
@@ -2467,7 +2809,7 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
               }
             });
       }
-    }
+    });
 
     /* \todo (optimizations) Adapt timestep size here */
 
@@ -2475,10 +2817,12 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
     const double end_timestep_time =
         std::min(parameters_.labclock->next_time(), t_end);
     while (next_output_time() <= end_timestep_time) {
-      for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
-        run_time_evolution_timestepless(actions[i_ens], i_ens,
-                                        next_output_time(), t_end);
-      }
+      const double output_time = next_output_time();
+      evolve_ensembles([&](int i_ens) {
+        ActionArena::Scope arena_scope(&action_arenas_[i_ens]);
+        run_time_evolution_timestepless(actions[i_ens], i_ens, output_time,
+                                        t_end);
+      });
       ++(*parameters_.outputclock);
 
       // Avoid duplication of final output
@@ -2486,10 +2830,17 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
         intermediate_output();
       }
     }
-    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+    evolve_ensembles([&](int i_ens) {
+      ActionArena::Scope arena_scope(&action_arenas_[i_ens]);
       run_time_evolution_timestepless(actions[i_ens], i_ens, end_timestep_time,
                                       t_end);
-    }
+      const Actions::Stats &stats = actions[i_ens].stats();
+      logg[LExperiment].debug(
+          "Actions of ensemble ", i_ens, ": ", stats.inserted, " inserted, ",
+          stats.invalidated, " invalidated (ratio ", stats.discard_ratio(),
+          "), ", stats.compactions, " compactions, maximal heap size ",
+          stats.max_heap_size);
+    });
 
     /* (3) Update potentials (if computed on the lattice) and
      *     compute new momenta according to equations of motion */
@@ -2527,6 +2878,8 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
   }
 
   if (pauli_blocker_) {
+    // The final decays are not covered by the time step of the index
+    pauli_blocker_->clear_index();
     logg[LExperiment].info(
         "Interactions: Pauli-blocked/performed = ", total_pauli_blocked_, "/",
         interactions_total_ - wall_actions_total_);
@@ -2534,17 +2887,97 @@ void Experiment<Modus>::run_time_evolution(const double t_end) {
 }
 
 template <typename Modus>
-void Experiment<Modus>::propagate_and_shine(double to_time,
-                                            Particles &particles) {
+void Experiment<Modus>::propagate_and_shine(double to_time, int i_ensemble) {
+  Particles &particles = ensembles_[i_ensemble];
   const double dt =
       propagate_straight_line(&particles, to_time, beam_momentum_);
   if (dilepton_finder_ != nullptr) {
-    for (const auto &output : outputs_) {
+    for (const auto &output : outputs_for(i_ensemble)) {
       dilepton_finder_->shine(particles, output.get(), dt);
     }
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::evolve_ensembles(
+    const std::function<void(int)> &evolve) {
+  if (!ensemble_pool_) {
+    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+      evolve(i_ens);
+      merge_ensemble_counters();
+    }
+    return;
+  }
+
+  if (pauli_blocker_) {
+    for (int i_ens = 0; i_ens < parameters_.n_ensembles; i_ens++) {
+      pauli_snapshot_[i_ens] = ensembles_[i_ens].copy_to_vector();
+    }
+    pauli_blocker_->build_frozen_index(pauli_snapshot_);
+  }
+  /* The calling thread takes part in the evolution, so its random number
+   * generator has to be restored afterwards. */
+  const random::Engine main_engine = random::engine;
+  evolving_concurrently_ = true;
+  try {
+    ensemble_pool_->parallel_for(parameters_.n_ensembles, [&](int i_ens) {
+      random::engine = ensemble_engines_[i_ens];
+      ParticleType::RejectionFactors::Scope factors_scope(
+          &ensemble_rejection_factors_[i_ens]);
+      evolve(i_ens);
+      ensemble_engines_[i_ens] = random::engine;
+    });
+  } catch (...) {
+    evolving_concurrently_ = false;
+    random::engine = main_engine;
+    throw;
+  }
+  merge_ensemble_counters();
+  evolving_concurrently_ = false;
+  random::engine = main_engine;
+
+  // Write the interactions in the same order as the serial evolution
+  for (const OutputsList &deferred : deferred_outputs_) {
+    for (const auto &output : deferred) {
+      static_cast<DeferredOutput &>(*output).flush();
+    }
+  }
+}
+
+template <typename Modus>
+uint64_t Experiment<Modus>::process_id(uint64_t n_performed,
+                                       int i_ensemble) const {
+  if (!evolving_concurrently_) {
+    return process_id_offset_ + n_performed + 1;
+  }
+  return process_id_offset_ + n_performed * parameters_.n_ensembles +
+         i_ensemble + 1;
+}
+
+template <typename Modus>
+void Experiment<Modus>::merge_ensemble_counters() {
+  /* During a concurrent evolution, the ids up to the ones of the ensemble
+   * with the most interactions are taken. In a serial evolution, the counters
+   * are merged after every ensemble. */
+  uint64_t most_interactions = 0;
+  for (const EnsembleCounters &counters : ensemble_counters_) {
+    most_interactions = std::max(most_interactions, counters.interactions);
+  }
+  process_id_offset_ += evolving_concurrently_
+                            ? most_interactions * parameters_.n_ensembles
+                            : most_interactions;
+  for (EnsembleCounters &counters : ensemble_counters_) {
+    interactions_total_ += counters.interactions;
+    wall_actions_total_ += counters.wall_actions;
+    total_pauli_blocked_ += counters.pauli_blocked;
+    total_hypersurface_crossing_actions_ +=
+        counters.hypersurface_crossing_actions;
+    discarded_interactions_total_ += counters.discarded_interactions;
+    total_energy_removed_ += counters.energy_removed;
+    counters = EnsembleCounters();
+  }
+}
+
 /**
  * Make sure `interactions_total` can be represented as a 32-bit integer.
  * This is necessary for converting to a `id_process`. The latter is 32-bit
@@ -2564,6 +2997,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     Actions &actions, int i_ensemble, const double end_time_propagation,
     const double end_time_run) {
   Particles &particles = ensembles_[i_ensemble];
+  EnsembleCounters &counters = ensemble_counters_[i_ensemble];
   logg[LExperiment].debug(
       "Timestepless propagation: ", "Actions size = ", actions.size(),
       ", end time = ", end_time_propagation);
@@ -2576,7 +3010,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(
     // get next action
     ActionPtr act = actions.pop();
     if (!act->is_valid(particles)) {
-      discarded_interactions_total_++;
+      counters.discarded_interactions++;
       logg[LExperiment].debug(~einhard::DRed(), "✘ ", act,
                               " (discarded: invalid)");
       continue;
@@ -2585,7 +3019,7 @@ void Experiment<Modus>::run_time_evolution_timestepless(
                             ", action time = ", act->time_of_execution());
 
     /* (1) Propagate to the next action. */
-    propagate_and_shine(act->time_of_execution(), particles);
+    propagate_and_shine(act->time_of_execution(), i_ensemble);
 
     /* (2) Perform action.
      *
@@ -2601,11 +3035,18 @@ void Experiment<Modus>::run_time_evolution_timestepless(
       continue;
     }
 
-    /* (3) Update actions for newly-produced particles. */
-
     const double end_time_timestep =
         std::min(parameters_.labclock->next_time(), end_time_run);
     assert(!(end_time_propagation > end_time_timestep));
+
+    /* (3) Discard the remaining actions of the incoming particles, which have
+     * interacted now, and update actions for newly-produced particles. As
+     * before, only the discarded actions within the time step are counted,
+     * which would have been popped and found invalid, even if the propagation
+     * stops earlier at an output time. */
+    counters.discarded_interactions += actions.invalidate(
+        act->incoming_particles(), particles, end_time_timestep);
+
     // New actions are always search until the end of the current timestep
     const double time_left = end_time_timestep - act->time_of_execution();
     const ParticleList &outgoing_particles = act->outgoing_particles();
@@ -2620,10 +3061,10 @@ void Experiment<Modus>::run_time_evolution_timestepless(
           outgoing_particles, particles, time_left, beam_momentum_));
     }
 
-    check_interactions_total(interactions_total_);
+    check_interactions_total(process_id(counters.interactions, i_ensemble));
   }
 
-  propagate_and_shine(end_time_propagation, particles);
+  propagate_and_shine(end_time_propagation, i_ensemble);
 }
 
 template <typename Modus>
@@ -2705,7 +3146,8 @@ void Experiment<Modus>::intermediate_output() {
       switch (dens_type_lattice_printout_) {
         case DensityType::Baryon:
           update_lattice(jmu_B_lat_.get(), lat_upd, DensityType::Baryon,
-                         density_param_, ensembles_, false);
+                         density_param_, ensembles_, false,
+                         lattice_pool_.get());
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         DensityType::Baryon, *jmu_B_lat_);
           output->thermodynamics_lattice_output(*jmu_B_lat_,
@@ -2714,7 +3156,7 @@ void Experiment<Modus>::intermediate_output() {
         case DensityType::BaryonicIsospin:
           update_lattice(jmu_I3_lat_.get(), lat_upd,
                          DensityType::BaryonicIsospin, density_param_,
-                         ensembles_, false);
+                         ensembles_, false, lattice_pool_.get());
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         DensityType::BaryonicIsospin,
                                         *jmu_I3_lat_);
@@ -2726,7 +3168,7 @@ void Experiment<Modus>::intermediate_output() {
         default:
           update_lattice(jmu_custom_lat_.get(), lat_upd,
                          dens_type_lattice_printout_, density_param_,
-                         ensembles_, false);
+                         ensembles_, false, lattice_pool_.get());
           output->thermodynamics_output(ThermodynamicQuantity::EckartDensity,
                                         dens_type_lattice_printout_,
                                         *jmu_custom_lat_);
@@ -2735,7 +3177,7 @@ void Experiment<Modus>::intermediate_output() {
       }
       if (printout_tmn_ || printout_tmn_landau_ || printout_v_landau_) {
         update_lattice(Tmn_.get(), lat_upd, dens_type_lattice_printout_,
-                       density_param_, ensembles_, false);
+                       density_param_, ensembles_, false, lattice_pool_.get());
         if (printout_tmn_) {
           output->thermodynamics_output(ThermodynamicQuantity::Tmn,
                                         dens_type_lattice_printout_, *Tmn_);
@@ -2780,7 +3222,8 @@ void Experiment<Modus>::update_potentials() {
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::BaryonicIsospin,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_pool_.get());
     }
     if ((potentials_->use_skyrme() || potentials_->use_symmetry()) &&
         jmu_B_lat_ != nullptr) {
@@ -2788,7 +3231,8 @@ void Experiment<Modus>::update_potentials() {
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::Baryon,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_pool_.get());
       const size_t UBlattice_size = UB_lat_->size();
       for (size_t i = 0; i < UBlattice_size; i++) {
         auto jB = (*jmu_B_lat_)[i];
@@ -2823,7 +3267,8 @@ void Experiment<Modus>::update_potentials() {
     }
     if (potentials_->use_coulomb()) {
       update_lattice(jmu_el_lat_.get(), LatticeUpdate::EveryTimestep,
-                     DensityType::Charge, density_param_, ensembles_, true);
+                     DensityType::Charge, density_param_, ensembles_, true,
+                     lattice_pool_.get());
       for (size_t i = 0; i < EM_lat_->size(); i++) {
         ThreeVector electric_field = {0., 0., 0.};
         ThreeVector position = jmu_el_lat_->cell_center(i);
@@ -2842,7 +3287,8 @@ void Experiment<Modus>::update_potentials() {
                      new_jmu_auxiliary_.get(), four_gradient_auxiliary_.get(),
                      LatticeUpdate::EveryTimestep, DensityType::Baryon,
                      density_param_, ensembles_,
-                     parameters_.labclock->timestep_duration(), true);
+                     parameters_.labclock->timestep_duration(), true,
+                     lattice_pool_.get());
       if (parameters_.field_derivatives_mode == FieldDerivativesMode::Direct) {
         update_fields_lattice(
             fields_lat_.get(), old_fields_auxiliary_.get(),
@@ -2902,6 +3348,7 @@ void Experiment<Modus>::do_final_decays() {
       while (!actions.is_empty()) {
         perform_action(*actions.pop(), i_ens, false);
       }
+      merge_ensemble_counters();
     }
     actions_performed = interactions_total_ > interactions_old;
     // Throw an error if actions were found but not performed
@@ -3096,22 +3543,132 @@ bool Experiment<Modus>::is_finished() {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (event_ = 0; !is_finished(); event_++) {
-    mainlog.info() << "Event " << event_;
+int64_t Experiment<Modus>::draw_next_event_seed() {
+  int64_t r = random::advance();
+  while (r == INT64_MIN) {
+    r = random::advance();
+  }
+  return std::abs(r);
+}
 
-    // Sample initial particles, start clock, some printout and book-keeping
-    initialize_new_event();
+template <typename Modus>
+void Experiment<Modus>::run_event() {
+  logg[LMain].info() << "Event " << event_;
 
-    run_time_evolution(end_time_);
+  // Sample initial particles, start clock, some printout and book-keeping
+  initialize_new_event();
 
-    if (force_decays_) {
-      do_final_decays();
+  run_time_evolution(end_time_);
+
+  if (force_decays_) {
+    do_final_decays();
+  }
+
+  // Output at event end
+  final_output();
+}
+
+template <typename Modus>
+bool Experiment<Modus>::may_start_event(int event) const {
+  if (event_counting_ == EventCounting::FixedNumber) {
+    return event < nevents_;
+  }
+  return event < max_events_;
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_events_concurrently() {
+  const int n_workers = static_cast<int>(event_workers_.size());
+  /* Output of events that are finished, but wait for earlier events to be
+   * written. Their number is limited to bound the memory usage. */
+  struct FinishedEvent {
+    std::vector<std::vector<RecordingOutput::RecordedCall>> calls;
+    int nonempty_ensembles;
+  };
+  const int max_waiting_events = 4 * n_workers;
+  std::map<int, FinishedEvent> finished_events;
+  // Protects the members of the main experiment and the variables above.
+  std::mutex mutex;
+  std::condition_variable event_written;
+  int next_event = 0;
+  // event_ is the next event to be written.
+  event_ = 0;
+  bool stop = is_finished();
+
+  ThreadPool pool(n_workers);
+  pool.parallel_for(n_workers, [&](int i_worker) {
+    Experiment &worker = *event_workers_[i_worker];
+    try {
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          event_written.wait(lock, [&] {
+            return stop || next_event < event_ + max_waiting_events;
+          });
+          if (stop || !may_start_event(next_event)) {
+            return;
+          }
+          worker.event_ = next_event++;
+          worker.seed_ = seed_;
+          random::set_seed(seed_);
+          seed_ = draw_next_event_seed();
+        }
+
+        const int nonempty_before = worker.nonempty_ensembles_;
+        {
+          /* The factors of the mass sampling are not shared with the other
+           * workers and start fresh in every event, so the event only
+           * depends on its seed. */
+          worker.event_rejection_factors_.reset();
+          ParticleType::RejectionFactors::Scope factors_scope(
+              &worker.event_rejection_factors_);
+          worker.run_event();
+        }
+        FinishedEvent finished;
+        for (const auto &output : worker.outputs_) {
+          finished.calls.emplace_back(
+              static_cast<RecordingOutput &>(*output).release_recorded());
+        }
+        finished.nonempty_ensembles =
+            worker.nonempty_ensembles_ - nonempty_before;
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          finished_events.emplace(worker.event_, std::move(finished));
+          auto next_to_write = finished_events.find(event_);
+          while (!stop && next_to_write != finished_events.end()) {
+            for (size_t i = 0; i < outputs_.size(); i++) {
+              RecordingOutput::replay(next_to_write->second.calls[i],
+                                      outputs_[i].get());
+            }
+            nonempty_ensembles_ += next_to_write->second.nonempty_ensembles;
+            finished_events.erase(next_to_write);
+            event_++;
+            stop = is_finished();
+            next_to_write = finished_events.find(event_);
+          }
+        }
+        event_written.notify_all();
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      event_written.notify_all();
+      throw;
     }
+  });
+}
 
-    // Output at event end
-    final_output();
+template <typename Modus>
+void Experiment<Modus>::run() {
+  if (!event_workers_.empty()) {
+    run_events_concurrently();
+    return;
+  }
+  for (event_ = 0; !is_finished(); event_++) {
+    run_event();
   }
 }
 
@@ -31,6 +31,9 @@ struct ExperimentParameters {
   /// Number of parallel ensembles
   int n_ensembles;
 
+  /// Number of threads used to evolve the parallel ensembles
+  int n_ensemble_threads;
+
   /// Number of test-particles
   int testparticles;
 
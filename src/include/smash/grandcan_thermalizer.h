@@ -7,6 +7,7 @@
 #ifndef SRC_INCLUDE_SMASH_GRANDCAN_THERMALIZER_H_
 #define SRC_INCLUDE_SMASH_GRANDCAN_THERMALIZER_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -77,8 +78,17 @@ class ThermLatticeNode {
    * discussion see \iref{Oliinychenko:2015lva}. The advantage of this rest
    * frame transformation is that it conserves energy and momentum, even
    * though the dissipative part of the energy-momentum tensor is neglected.
+   *
+   * The rest frame energy density and velocity are determined by the
+   * pressure, which is found by the secant method.
+   *
+   * \param[in,out] eos_guess If not nullptr, (T, mub, mus, muq) of a similar
+   *                cell, e.g. the neighbouring one, which the solver of the
+   *                equation of state starts from. It is replaced by the
+   *                solution for this cell.
    */
-  void compute_rest_frame_quantities(HadronGasEos& eos);
+  void compute_rest_frame_quantities(
+      HadronGasEos& eos, std::array<double, 4>* eos_guess = nullptr);
   /**
    * Set all the rest frame quantities to some values, this is useful
    * for testing.
@@ -191,6 +201,11 @@ enum class HadronClass {
  * \li \key "biased BF" - faster, but theoretically less robust
  * \li \key "mode sampling" - fastest, but least robust
  *
+ * \key Threads (int, optional, default = 1): \n
+ * Number of threads used to compute the rest frame quantities of the cells and
+ * the densities on the lattice. A value of 0 uses all available hardware
+ * threads. The results are identical for any number of threads.
+ *
  * \key Microcanonical (bool, optional, default = false) \n
  * Enforce energy conservation or not as part of sampling algorithm. Relevant
  * for biased and unbiased Becattini-Ferroni (BF) algorithms. If this option is
@@ -203,6 +218,12 @@ enum class HadronClass {
  *
  * The downside of having this option on is that the sampling takes
  * significantly longer time.
+ *
+ * The forced thermalization needs a table of the hadron gas equation of
+ * state. It is computed with all hardware threads and saved in the binary file
+ * hadgas_eos.bin in the working directory, when the thermalization is used for
+ * the first time. Later runs with the same hadrons map this file into memory
+ * instead, which is shared by all SMASH processes on one machine.
  */
 
 /**
@@ -241,12 +262,15 @@ class GrandCanThermalizer {
    * \param[in] algo Choice of algorithm for the canonical sampling
    * \param[in] BF_microcanonical Enforce energy conservation in BF sampling
    *            algorithms or nor
+   * \param[in] n_threads Number of threads used to update the lattice, all
+   *            hardware threads if 0
    */
   GrandCanThermalizer(const std::array<double, 3> lat_sizes,
                       const std::array<int, 3> n_cells,
                       const std::array<double, 3> origin, bool periodicity,
                       double e_critical, double t_start, double delta_t,
-                      ThermalizationAlgorithm algo, bool BF_microcanonical);
+                      ThermalizationAlgorithm algo, bool BF_microcanonical,
+                      int n_threads = 1);
   /// \see GrandCanThermalizer Exactly the same but taking values from config
   GrandCanThermalizer(Configuration& conf,
                       const std::array<double, 3> lat_sizes,
@@ -256,7 +280,8 @@ class GrandCanThermalizer {
             conf.take({"Critical_Edens"}), conf.take({"Start_Time"}),
             conf.take({"Timestep"}),
             conf.take({"Algorithm"}, ThermalizationAlgorithm::BiasedBF),
-            conf.take({"Microcanonical"}, false)) {}
+            conf.take({"Microcanonical"}, false),
+            conf.take({"Threads"}, 1)) {}
   /**
    * Check that the clock is close to n * period of thermalization, since
    * the thermalization only happens at these times
@@ -493,6 +518,8 @@ class GrandCanThermalizer {
   HadronGasEos eos_ = HadronGasEos(true, false);
   /// The lattice on which the thermodynamic quantities are calculated
   std::unique_ptr<RectangularLattice<ThermLatticeNode>> lat_;
+  /// Threads used to update the lattice, nullptr if serial
+  std::unique_ptr<ThreadPool> pool_;
   /// Particles to be removed after this thermalization step
   ParticleList to_remove_;
   /// Newly generated particles by thermalizer
@@ -145,6 +145,27 @@ class Grid : public GridBase {
        const bool include_unformed_particles = false,
        CellSizeStrategy strategy = CellSizeStrategy::Optimal);
 
+  /**
+   * Sorts the given particles into the grid again, e.g. at the next time step.
+   *
+   * The cells keep their memory, such that no allocations are needed once
+   * the grid has reached its typical occupation. A grid with periodic
+   * boundaries keeps its box, otherwise the box is determined from the
+   * positions of the particles as in the constructor. The number of cells is
+   * determined as in the constructor, using the limitation and strategy given
+   * there.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   * \param[in] include_unformed_particles include unformed particles from
+                                              the grid (worsens runtime)
+   * \throws runtime_error if your box length is smaller than the grid length.
+   */
+  void update(const Particles &particles, double min_cell_length,
+              double timestep_duration,
+              const bool include_unformed_particles = false);
+
   /**
    * Iterates over all cells in the grid and calls the callback arguments with
    * a search cell and 0 to 13 neighbor cells.
@@ -186,8 +207,38 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /**
+   * Determines the number of cells and sorts the particles into them, for the
+   * current min_position_ and length_.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration duration of the timestep in fm/c
+   * \param[in] include_unformed_particles include unformed particles from
+                                              the grid (worsens runtime)
+   */
+  void build(const Particles &particles, double min_cell_length,
+             double timestep_duration, const bool include_unformed_particles);
+
+  /**
+   * Empties all cells and changes their number, keeping the memory of the
+   * remaining cells.
+   *
+   * \param[in] n The new number of cells.
+   */
+  void reset_cells(std::size_t n);
+
+  /// The minimal coordinates of the complete grid.
+  std::array<double, 3> min_position_;
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
-  const std::array<double, 3> length_;
+  std::array<double, 3> length_;
+
+  /// Limitation of the number of cells
+  CellNumberLimitation limit_;
+
+  /// Strategy for determining the cell size
+  CellSizeStrategy strategy_;
 
   /// The volume of a single cell.
   double cell_volume_;
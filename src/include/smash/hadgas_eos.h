@@ -14,11 +14,13 @@
 #include <gsl/gsl_vector.h>
 
 #include <array>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "constants.h"
 #include "particletype.h"
+#include "sha256.h"
 
 namespace smash {
 
@@ -71,12 +73,25 @@ class EosTable {
    * Computes the actual content of the table (for EosTable description see
    * documentation of the constructor).
    *
+   * If the file contains a table for the same grid, particles, decaymodes
+   * and EoS flags, which is consistent with the EoS at sample points, it is
+   * mapped into memory read-only, so that concurrent SMASH processes share it.
+   * Otherwise the table is computed, distributing the slabs of fixed energy
+   * density over several threads, and saved in the file.
+   *
+   * The file is binary: a header with a format version, the hash of the
+   * particles, decaymodes and EoS flags and the grid is followed by the table
+   * elements.
+   *
    * \param[in] eos equation of state
    * \param[in] eos_savefile_name name of the file to save tabulated equation
    *            of state
+   * \param[in] n_threads Number of threads used to compute the table, all
+   *            hardware threads if smaller than 1
    */
   void compile_table(HadronGasEos& eos,
-                     const std::string& eos_savefile_name = "hadgas_eos.dat");
+                     const std::string& eos_savefile_name = "hadgas_eos.bin",
+                     int n_threads = 0);
   /**
    * Obtain interpolated p/T/muB/muS/muQ from the tabulated equation of state
    * given energy density, net baryon density and net charge density
@@ -87,14 +102,60 @@ class EosTable {
    * \param[out] res structure, that contains p/T/muB/muS/muQ
    */
   void get(table_element& res, double e, double nb, double nq) const;
+  /**
+   * Set the hash of the SMASH version, the particles and decaymodes, which
+   * identifies the tables saved in files together with the EoS flags.
+   *
+   * \param[in] hash The hash of the particle properties.
+   */
+  static void set_particles_hash(sha256::Hash hash);
 
  private:
   /// proper index in a 1d vector, where the 3d table is stored
   size_t index(size_t ie, size_t inb, size_t inq) const {
     return n_q_ * (ie * n_nb_ + inb) + inq;
   }
-  /// Storage for the tabulated equation of state
+  /// \return Element of the table at the given index
+  const table_element& element(size_t i) const {
+    return mapped_ ? mapped_[i] : table_[i];
+  }
+  /**
+   * Compute the table elements of one energy density.
+   *
+   * \param[in] eos equation of state
+   * \param[in] ie index of the energy density
+   * \return number of points, for which the EoS was solved
+   */
+  size_t compile_slab(HadronGasEos& eos, size_t ie);
+  /**
+   * Check at sample points, whether the table solves the equations of the
+   * EoS.
+   *
+   * \param[in] eos equation of state
+   * \return whether the table is consistent with the EoS
+   */
+  bool is_consistent(const HadronGasEos& eos) const;
+  /**
+   * Map a table file into memory, if it matches the grid and the hash.
+   *
+   * \param[in] file_name name of the file
+   * \param[in] hash hash of the particles and the EoS flags
+   * \return whether the file has been mapped
+   */
+  bool map_file(const std::string& file_name, const sha256::Hash& hash);
+  /**
+   * Save the table in a file with save_cache_file.
+   *
+   * \param[in] file_name name of the file
+   * \param[in] hash hash of the particles and the EoS flags
+   */
+  void save_file(const std::string& file_name, const sha256::Hash& hash) const;
+  /// Storage for the tabulated equation of state, if it is not mapped
   std::vector<table_element> table_;
+  /// Memory mapping of the table file, shared by copies
+  std::shared_ptr<const void> mapping_;
+  /// Table in the memory mapping, nullptr if not mapped
+  const table_element* mapped_ = nullptr;
   /// Step in energy density
   double de_;
   /// Step in net-baryon density
@@ -142,6 +203,16 @@ class HadronGasEos {
    *             calculation.
    */
   HadronGasEos(bool tabulate, bool account_for_widths);
+  /**
+   * Copy the equation of state. The copy shares the table, but has its own
+   * solver workspace, so that the original and the copy can solve the
+   * equation of state concurrently.
+   *
+   * \param[in] other The equation of state to copy
+   */
+  HadronGasEos(const HadronGasEos& other);
+  /// Cannot be assigned
+  HadronGasEos& operator=(const HadronGasEos&) = delete;
   ~HadronGasEos();
 
   /**
@@ -161,6 +232,38 @@ class HadronGasEos {
    */
   static double energy_density(double T, double mub, double mus, double muq);
 
+  /// Energy density and net densities of the hadron gas
+  struct ThermodynamicSums {
+    /// energy density [GeV/fm\f$^3\f$]
+    double e;
+    /// net baryon density [fm\f$^{-3}\f$]
+    double nb;
+    /// net strangeness density [fm\f$^{-3}\f$]
+    double ns;
+    /// net charge density [fm\f$^{-3}\f$]
+    double nq;
+  };
+
+  /**
+   * Compute the energy density and the net baryon, strangeness and charge
+   * densities at once with pole masses, as energy_density and the net
+   * densities without widths do.
+   *
+   * All four sums are accumulated in a single scalar pass over the packed
+   * hadron properties, which share one exponential per hadron. The Bessel
+   * functions are interpolated in a table in \f$ \ln(m/T) \f$ with a relative
+   * error below \f$ 10^{-8} \f$, which makes this much faster than the
+   * separate sums. GSL is only called outside of the tabulated range.
+   *
+   * \param[in] T temperature [GeV]
+   * \param[in] mub baryon chemical potential [GeV]
+   * \param[in] mus strangeness chemical potential [GeV]
+   * \param[in] muq charge chemical potential [GeV]
+   * \return energy density and net densities, all zero if T is zero
+   */
+  ThermodynamicSums thermodynamic_sums(double T, double mub, double mus,
+                                       double muq) const;
+
   /**
    * \brief Compute particle number density.
    *
@@ -323,6 +426,25 @@ class HadronGasEos {
     return solve_eos(e, nb, ns, nq, solve_eos_initial_approximation(e, nb, nq));
   }
 
+  /**
+   * Compute temperature and chemical potentials given energy-,
+   * net baryon-, net strangeness- and net charge density, starting from the
+   * solution for similar densities. If the solver does not converge from
+   * there, it is restarted from solve_eos_initial_approximation.
+   *
+   * \param[in] e energy density [GeV/fm\f$^3\f$]
+   * \param[in] nb net baryon density [fm\f$^{-3}\f$]
+   * \param[in] ns net strangeness density [fm\f$^{-3}\f$]
+   * \param[in] nq net charge density [fm\f$^{-3}\f$]
+   * \param[in] guess (T [GeV], mub [GeV], mus [GeV], muq [GeV]) for similar
+   *            densities, not used if T is not positive
+   * \return array of 4 values: temperature, baryon chemical potential,
+   *          strange chemical potential and charge chemical potential
+   */
+  std::array<double, 4> solve_eos_warm_start(
+      double e, double nb, double ns, double nq,
+      const std::array<double, 4>& guess);
+
   /**
    * Compute a reasonable initial approximation for solve_eos.
    *
@@ -348,7 +470,11 @@ class HadronGasEos {
   /// Get the element of eos table
   void from_table(EosTable::table_element& res, double e, double nb,
                   double nq) const {
-    eos_table_.get(res, e, nb, nq);
+    if (eos_table_) {
+      eos_table_->get(res, e, nb, nq);
+    } else {
+      res = {-1.0, -1.0, -1.0, -1.0, -1.0};
+    }
   }
 
   /// Check if a particle belongs to the EoS
@@ -377,12 +503,33 @@ class HadronGasEos {
     double nq;
     /// use pole masses of resonances, or integrate over spectral functions
     bool account_for_width;
+    /// equation of state, whose thermodynamic_sums are used without widths
+    const HadronGasEos* eos;
   };
 
   /// Another structure for passing energy density to the gnu library
   struct eparams {
     /// energy density
     double edens;
+    /// equation of state, whose thermodynamic_sums are used
+    const HadronGasEos* eos;
+  };
+
+  /**
+   * Properties of the hadrons in the EoS, stored as separate contiguous
+   * arrays for the sums in thermodynamic_sums.
+   */
+  struct HadronTable {
+    /// pole masses [GeV]
+    std::vector<double> mass;
+    /// spin degeneracies
+    std::vector<double> degeneracy;
+    /// baryon numbers
+    std::vector<double> baryon_number;
+    /// strangeness
+    std::vector<double> strangeness;
+    /// charges
+    std::vector<double> charge;
   };
 
   /**
@@ -419,6 +566,23 @@ class HadronGasEos {
   /// \see set_eos_solver_equations()
   static double e_equation(double T, void* params);
 
+  /**
+   * Run the solver of the equation of state.
+   *
+   * \param[in] e energy density [GeV/fm\f$^3\f$]
+   * \param[in] nb net baryon density [fm\f$^{-3}\f$]
+   * \param[in] ns net strangeness density [fm\f$^{-3}\f$]
+   * \param[in] nq net charge density [fm\f$^{-3}\f$]
+   * \param[in] initial_approximation (T, mub, mus, muq) to start from [GeV]
+   * \param[in] warn Whether to warn if the solver does not converge
+   * \param[out] solution (T, mub, mus, muq) [GeV], all zero if the temperature
+   *             drops too low
+   * \return GSL status of the residual test
+   */
+  int run_eos_solver(double e, double nb, double ns, double nq,
+                     const std::array<double, 4>& initial_approximation,
+                     bool warn, std::array<double, 4>* solution);
+
   /**
    * Helpful printout, useful for debugging if gnu equation solving goes crazy
    *
@@ -437,8 +601,11 @@ class HadronGasEos {
   /// Number of equations in the system of equations to be solved
   static constexpr size_t n_equations_ = 4;
 
-  /// EOS Table to be used
-  EosTable eos_table_ = EosTable(1.e-1, 1.e-1, 1.e-1, 90, 90, 90);
+  /// EOS Table to be used, shared by copies, nullptr if not tabulated
+  std::shared_ptr<const EosTable> eos_table_;
+
+  /// Hadrons in the EoS, shared by copies
+  std::shared_ptr<const HadronTable> hadrons_;
 
   /**
    * Variables used by gnu equation solver. They are stored here to allocate
@@ -205,11 +205,15 @@ class IsoParticleType {
   /**
    * Tabulate all relevant integrals.
    *
+   * The tabulations are cached in a single archive "integrals.bin", which is
+   * mapped read-only into memory, so that all processes share it, see
+   * Tabulation::map_archive.
+   *
    * \param hash The hash of the particle properties.
    *             This is used to determine whether a cached tabulation can be
    *             reused or not.
    * \param tabulations_path The path to the directory where the tabulations are
-   * cached.
+   * cached. If it is empty, the integrals are calculated and not cached.
    */
   static void tabulate_integrals(sha256::Hash hash,
                                  const bf::path &tabulations_path);
@@ -41,7 +41,8 @@ Configuration setup_config_and_logging(
 
 /**
  * Initialize the particles and decays from the given configuration,
- * plus tabulate the resonance integrals.
+ * plus tabulate the resonance integrals and set up the tabulation of the
+ * mass-dependent widths and the cache of the PYTHIA initializations.
  *
  * \param[in] configuration Fully-setup configuration i.e. including
  * particles and decaymodes.
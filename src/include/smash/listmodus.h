@@ -10,14 +10,81 @@
 #include <cmath>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
 
 #include "forwarddeclarations.h"
 #include "modusdefault.h"
 
 namespace smash {
 
+/**
+ * \ingroup modus
+ * A particle list file of the ListModus, which is mapped into memory.
+ *
+ * The file is split into events in a single pass when it is opened. An event
+ * ends with a line containing "end" (e.g. "# event 0 end"), which does not
+ * belong to any event. The text after the last such line is an event as well,
+ * unless it contains only whitespace, so a file without such lines holds one
+ * event. Afterwards, the events can be accessed in any order without reading
+ * the file again.
+ */
+class ParticleListFile {
+ public:
+  /// Text of one event in the mapped file, which is not null-terminated
+  struct Event {
+    /// First character of the event
+    const char *begin;
+    /// Behind the last character of the event
+    const char *end;
+    /// Number of the first line of the event in the file, starting at 1
+    int first_line;
+  };
+
+  /**
+   * Map the file into memory and find its events.
+   *
+   * \param[in] path Path of the file.
+   * \throw std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit ParticleListFile(const bf::path &path);
+
+  /// Unmap the file
+  ~ParticleListFile();
+
+  /// Cannot be copied
+  ParticleListFile(const ParticleListFile &) = delete;
+  /// Cannot be copied
+  ParticleListFile &operator=(const ParticleListFile &) = delete;
+
+  /// \return Number of events in the file.
+  std::size_t n_events() const { return events_.size(); }
+
+  /**
+   * \param[in] i Index of the event, starting at 0.
+   * \return The i-th event of the file.
+   * \throw std::out_of_range if there are less than i + 1 events.
+   */
+  const Event &event(std::size_t i) const { return events_.at(i); }
+
+  /// \return Path of the file.
+  const bf::path &path() const { return path_; }
+
+ private:
+  /// Path of the file
+  bf::path path_;
+  /// The mapped file, nullptr for an empty file
+  char *data_ = nullptr;
+  /// Size of the file [bytes]
+  std::size_t size_ = 0;
+  /// The events of the file
+  std::vector<Event> events_;
+};
+
 /**
  * \ingroup modus
  * ListModus: Provides a modus for running SMASH on an external particle list,
@@ -165,17 +232,6 @@ class ListModus : public ModusDefault {
   double start_time_ = 0.;
 
  private:
-  /** Check if the file given by filepath has events left after streampos
-   * last_position
-   *
-   * \param[in] filepath Path to file to be checked.
-   * \param[in] last_position Streamposition in file after which check is
-   * performed
-   * \return True if there is at least one event left, false otherwise
-   * \throws runtime_error If file could not be read for whatever reason.
-   */
-  bool file_has_events_(bf::path filepath, std::streampos last_position);
-
   /** Return the absolute file path based on given integer. The filename
    * is assumed to have the form (particle_list_prefix)_(file_id)
    *
@@ -186,14 +242,29 @@ class ListModus : public ModusDefault {
    */
   bf::path file_path_(const int file_id);
 
-  /**  Read the next event. Either from the current file if it has more events
-   * or from the next file (with file_id += 1)
+  /**  Find the next event. Either in the current file if it has more events
+   * or in the next file (with file_id += 1)
    *
    * \returns
-   *  One event as string.
+   *  One event of current_file_.
    *  \throws runtime_error If file could not be read for whatever reason.
    */
-  std::string next_event_();
+  const ParticleListFile::Event &next_event_();
+
+  /**
+   * Parse a particle line and add the particle to particles, see
+   * try_create_particle.
+   *
+   * \param[out] particles structure, to which the particle is added
+   * \param[in] begin First character of the line
+   * \param[in] end Behind the last character of the line, without comment
+   * \param[in] line_number Number of the line in the file
+   * \throw LoadFailure if the line is not correctly formatted
+   * \throw invalid_argument if the listed charge of a particle does not
+   *                         correspond to its pdg charge
+   */
+  void read_particle_(Particles &particles, const char *begin,
+                      const char *end, int line_number);
 
   /// File directory of the particle list
   std::string particle_list_file_directory_;
@@ -218,8 +289,11 @@ class ListModus : public ModusDefault {
   /// Counter for energy-momentum conservation warnings to avoid spamming
   int n_warns_mass_consistency_ = 0;
 
-  /// last read position in current file
-  std::streampos last_read_position_;
+  /// The current file, which is opened at the first event
+  std::unique_ptr<ParticleListFile> current_file_;
+
+  /// Index of the next event in current_file_
+  std::size_t next_event_in_file_ = 0;
 
   /**\ingroup logging
    * Writes the initial state for the List to the output stream.
@@ -288,6 +362,9 @@ class ListBoxModus : public ListModus {
   int impose_boundary_conditions(Particles *particles,
                                  const OutputsList &output_list = {});
 
+  /// The type of the Grid created by create_grid
+  using GridType = Grid<GridOptions::PeriodicBoundaries>;
+
   /// \copydoc smash::ModusDefault::create_grid
   Grid<GridOptions::PeriodicBoundaries> create_grid(
       const Particles &particles, double min_cell_length,
@@ -75,6 +75,10 @@ class ModusDefault {
   double impact_parameter() const { return -1.; }
   /// sample impact parameter for collider modus
   void sample_impact() const {}
+  /// sample the nucleus configuration pools for collider modus
+  void create_nucleus_pools(int64_t) const {}
+  /// share the nucleus configuration pools for collider modus
+  void share_nucleus_pools(const ModusDefault &) const {}
   /** \return The beam velocity of the projectile required in the Collider
    * modus. In the other modus, return zero. */
   double velocity_projectile() const { return 0.0; }
@@ -106,6 +110,9 @@ class ModusDefault {
    */
   double nuclei_passing_time() const { return 0.0; }
 
+  /// The type of the Grid created by create_grid
+  using GridType = Grid<GridOptions::Normal>;
+
   /**
    * Creates the Grid with normal boundary conditions.
    *
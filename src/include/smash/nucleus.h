@@ -8,7 +8,9 @@
 #define SRC_INCLUDE_SMASH_NUCLEUS_H_
 
 #include <map>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "configuration.h"
@@ -16,10 +18,13 @@
 #include "forwarddeclarations.h"
 #include "fourvector.h"
 #include "particledata.h"
+#include "sha256.h"
 #include "threevector.h"
 
 namespace smash {
 
+class ThreadPool;
+
 /**
  * A nucleus is a collection of particles that are initialized,
  * before the beginning of the simulation and all have the same velocity.
@@ -75,9 +80,53 @@ class Nucleus {
    */
   double woods_saxon(double x);
 
-  /// Sets the positions of the nucleons inside a nucleus.
+  /**
+   * Sets the positions of the nucleons inside a nucleus. If a pool of
+   * configurations was created, one of them is drawn instead of sampling the
+   * nucleons.
+   */
   virtual void arrange_nucleons();
 
+  /**
+   * Samples configurations of the nucleon positions in the rest frame of the
+   * nucleus in advance, which are then drawn by arrange_nucleons.
+   *
+   * A drawn configuration is rotated randomly by rotate_randomly and then by
+   * rotate, so that drawing the same configuration again still gives
+   * different nuclei. The Fermi momenta and the boost are applied for every
+   * event as without the pool.
+   *
+   * Every configuration is sampled with its own seed, which is taken from
+   * the random number engine of the calling thread, so the pool is the same
+   * for any number of threads.
+   *
+   * \param[in] n_configurations Number of configurations in the pool.
+   * \param[in] threads Threads to sample the configurations with, nullptr
+   *            to sample them in the calling thread.
+   * \param[in] directory Directory, in which the pool is cached. If a
+   *            matching pool was saved there, it is read instead of sampled;
+   *            otherwise the sampled pool is saved. Empty to not cache it.
+   */
+  void create_configuration_pool(size_t n_configurations, ThreadPool *threads,
+                                 const std::string &directory);
+
+  /**
+   * Draw the configurations from the pool of another nucleus with the same
+   * nucleons, without copying it.
+   *
+   * \param[in] other The nucleus whose pool is used.
+   */
+  void share_configuration_pool(const Nucleus &other) {
+    configuration_pool_ = other.configuration_pool_;
+  }
+
+  /// \return Number of configurations in the pool, 0 if there is none.
+  size_t configuration_pool_size() const {
+    return particles_.empty() || !configuration_pool_
+               ? 0
+               : configuration_pool_->size() / size();
+  }
+
   /**
    * Sets the deformation parameters of the Woods-Saxon distribution
    * according to the current mass number.
@@ -283,6 +332,41 @@ class Nucleus {
   /// Number of testparticles per physical particle
   size_t testparticles_ = 1;
 
+  /**
+   * Pre-sampled nucleon positions, one configuration of size() nucleons
+   * after the other, nullptr if there is no pool. It is shared by the nuclei
+   * of all event threads, see share_configuration_pool.
+   */
+  std::shared_ptr<const std::vector<ThreeVector>> configuration_pool_;
+
+  /**
+   * Sample one configuration of the pool, centered at the origin.
+   *
+   * \param[out] positions Memory for the size() nucleon positions.
+   */
+  void sample_configuration(ThreeVector *positions);
+
+  /**
+   * Read the pool from a file, which is mapped with map_cache_file.
+   *
+   * \param[in] file_name Name of the file.
+   * \param[in] n_configurations Expected number of configurations.
+   * \param[in] hash Hash of position_distribution_parameters.
+   * \return Whether the file exists and matches the nucleus.
+   */
+  bool load_configuration_pool(const std::string &file_name,
+                               size_t n_configurations,
+                               const sha256::Hash &hash);
+
+  /**
+   * Save the pool to a file with save_cache_file. Failures are only logged.
+   *
+   * \param[in] file_name Name of the file.
+   * \param[in] hash Hash of position_distribution_parameters.
+   */
+  void save_configuration_pool(const std::string &file_name,
+                               const sha256::Hash &hash) const;
+
  protected:
   /// Particles associated with this nucleus.
   std::vector<ParticleData> particles_;
@@ -297,6 +381,19 @@ class Nucleus {
    */
   void random_euler_angles();
 
+  /**
+   * Rotates the nucleons randomly, such that the distribution of their
+   * positions does not change. Applied to the configurations drawn from the
+   * pool. A spherical nucleus is rotated by random Euler angles.
+   */
+  virtual void rotate_randomly();
+
+  /**
+   * \return Text with all parameters of the distribution of the nucleon
+   *         positions, which identifies the cached configuration pools.
+   */
+  virtual std::string position_distribution_parameters() const;
+
   /// Euler angel phi
   double euler_phi_;
   /// Euler angel theta
@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 
+#include "asciibuffer.h"
 #include "file.h"
 #include "forwarddeclarations.h"
 #include "outputinterface.h"
@@ -130,6 +131,9 @@ class OscarOutput : public OutputInterface {
 
   /// Full filepath of the output file.
   RenamingFilePtr file_;
+
+  /// Collects the text, which is written to the file in large chunks.
+  AsciiBuffer buffer_;
 };
 
 /**
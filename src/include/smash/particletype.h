@@ -8,6 +8,8 @@
 #define SRC_INCLUDE_SMASH_PARTICLETYPE_H_
 
 #include <cassert>
+#include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +17,7 @@
 #include "forwarddeclarations.h"
 #include "macros.h"
 #include "pdgcode.h"
+#include "sha256.h"
 
 namespace smash {
 
@@ -323,6 +326,23 @@ class ParticleType {
   DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
                                      WhichDecaymodes wh) const;
 
+  /**
+   * Get the mass-dependent partial widths of the dilepton decay modes of a
+   * particle, like get_partial_widths with WhichDecaymodes::Dileptons, but
+   * without creating decay branches. Hadronic modes are only evaluated until
+   * one with a positive width is found.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[out] widths Pairs of the index in the decay mode list and the
+   *             partial width of the dilepton modes with a positive width. The
+   *             previous content is replaced.
+   * \return true if a hadronic decay mode has a positive width.
+   */
+  bool get_dilepton_widths(
+      const FourVector p, const ThreeVector x,
+      std::vector<std::pair<std::size_t, double>> *widths) const;
+
   /**
    * Get the mass-dependent partial width of a resonance with mass m,
    * decaying into two given daughter particles.
@@ -561,6 +581,123 @@ class ParticleType {
    */
   static void check_consistency();
 
+  /**
+   * Evaluate all lazily computed and cached quantities of all particle types
+   * and their decay modes (kinematic and spectral minimum masses, isospin,
+   * spectral function normalization, decay thresholds and tabulated decay
+   * widths).
+   *
+   * Afterwards the global particle type list is only read, such that it can
+   * be accessed from multiple threads concurrently, if every thread samples
+   * resonance masses with its own RejectionFactors.
+   *
+   * Note that the particles and decay modes have to be initialized, otherwise
+   * calling this is undefined behavior.
+   */
+  static void precompute_lazy_quantities();
+
+  /**
+   * Tabulate the mass-dependent total and partial widths of all unstable
+   * particle types, which are then used by total_width, get_partial_widths and
+   * the spectral functions.
+   *
+   * The widths of a type are tabulated on an equidistant mass grid when they
+   * are needed for the first time, from the decay thresholds up to the pole
+   * mass plus ten times the pole width (at least 2 GeV). Masses outside of the
+   * grid and intervals, where the linear interpolation violates the error
+   * bound at the interval midpoint, are evaluated directly. If the total width
+   * cannot be tabulated, the tabulated partial widths are summed up instead.
+   *
+   * \param[in] mass_step Spacing of the mass grid [GeV]. The widths are not
+   *            tabulated if this is 0.
+   * \param[in] max_error Maximal error of the interpolation, relative to the
+   *            larger of the exact width and the width at the pole mass.
+   * \param[in] hash The hash of the particle properties.
+   *             This is used to determine whether a cached tabulation can be
+   *             reused or not.
+   * \param[in] tabulations_path The path to the directory where the
+   *             tabulations are cached. Nothing is cached, if it is empty.
+   * \throw std::invalid_argument if the mass step is negative or the error
+   *        bound is not positive.
+   */
+  static void tabulate_widths(double mass_step, double max_error,
+                              sha256::Hash hash,
+                              const bf::path &tabulations_path);
+
+  /**
+   * Tabulate the mass distributions of resonances, which are sampled by
+   * sample_resonance_mass, to draw the masses by inversion instead of
+   * rejection sampling.
+   *
+   * A table is created on first use for each resonance type, stable partner
+   * mass and angular momentum. On a grid in sqrt(s), it holds the cumulative
+   * mass distribution in the variable of the Cauchy distribution used for the
+   * rejection sampling, in which the distribution is smooth. The grid is
+   * refined where the largest possible mass crosses the pole. A mass is
+   * sampled from one of the neighboring sqrt(s) grid points, chosen with the
+   * probabilities of the linear interpolation, by inverting the cumulative
+   * distribution, which takes constant time on average. Rejection sampling
+   * is used for sqrt(s) outside of the grid, which covers resonance masses
+   * up to the pole mass plus ten times the pole width (at least 2 GeV).
+   *
+   * \param[in] sqrts_step Largest spacing of the sqrt(s) grid [GeV]. The mass
+   *            distributions are not tabulated if this is 0.
+   * \param[in] n_intervals Number of mass intervals per sqrt(s).
+   * \throw std::invalid_argument if the spacing is negative or there are less
+   *        than 2 intervals.
+   */
+  static void tabulate_mass_sampling(double sqrts_step, int n_intervals);
+
+  /**
+   * Factors, by which the maxima of the rejection sampling of resonance masses
+   * are increased when they turn out to be too small, see
+   * sample_resonance_mass and sample_resonance_masses, for all particle types.
+   *
+   * By default, all threads use and increase the factors stored in the
+   * particle types. While a Scope is active in a thread, the factors of the
+   * given object are used instead, so that concurrently sampling threads do
+   * not share them. An object must only be used by one thread at a time.
+   */
+  class RejectionFactors {
+   public:
+    /**
+     * Guard making the factors the current ones of this thread during its
+     * lifetime. The previous factors are restored by the destructor, so scopes
+     * can be nested.
+     */
+    class Scope {
+     public:
+      /**
+       * \param[in] factors The factors to be used, or nullptr to use the
+       *            factors stored in the particle types.
+       */
+      explicit Scope(RejectionFactors *factors);
+      /// Restore the previous factors.
+      ~Scope();
+      /// Cannot be copied
+      Scope(const Scope &) = delete;
+      /// Cannot be copied
+      Scope &operator=(const Scope &) = delete;
+
+     private:
+      /// The factors, which were current before this scope
+      RejectionFactors *previous_;
+    };
+
+    /// Reset all factors to 1.
+    void reset() {
+      single_.clear();
+      pair_.clear();
+    }
+
+   private:
+    friend class ParticleType;
+    /// Factors for single-res mass sampling, in the order of list_all
+    std::vector<double> single_;
+    /// Factors for double-res mass sampling, in the order of list_all
+    std::vector<double> pair_;
+  };
+
   /**
    * Returns an object that acts like a pointer, except that it requires only 2
    * bytes and inhibits pointer arithmetics.
@@ -652,6 +789,113 @@ class ParticleType {
   /// Maximum factor for double-res mass sampling, cf. sample_resonance_masses.
   mutable double max_factor2_ = 1.;
 
+  /**
+   * \return The factor for single-res mass sampling of the current
+   *         RejectionFactors of this thread, or max_factor1_ if there are none.
+   */
+  double &max_factor1() const;
+
+  /**
+   * \return The factor for double-res mass sampling of the current
+   *         RejectionFactors of this thread, or max_factor2_ if there are none.
+   */
+  double &max_factor2() const;
+
+  /// Tabulated total and partial widths of an unstable particle type
+  struct WidthTabulation;
+  /**
+   * Tabulated widths, which are created on first use if the widths are
+   * tabulated (see tabulate_widths). Mutable, because they are only a cache.
+   */
+  mutable std::shared_ptr<const WidthTabulation> width_tabulation_;
+
+  /**
+   * \return The tabulated widths of this type, which are looked up in the
+   *         cache or created on the first call, or nullptr if the widths are
+   *         not tabulated.
+   */
+  const WidthTabulation *width_tabulation() const;
+
+  /**
+   * Get the mass-dependent partial width of one decay mode, using the
+   * tabulation if it covers the given mass.
+   *
+   * \param[in] m Invariant mass of the decaying particle.
+   * \param[in] mode_index Index of the decay mode in the decay mode list.
+   * \return the partial width of this mode for this mass
+   */
+  double tabulated_partial_width(const double m,
+                                 std::size_t mode_index) const;
+
+  /// Tabulated mass distribution for one stable partner and angular momentum
+  struct MassSamplingTable;
+  /// Tabulated mass distributions by the mass of the stable partner and the
+  /// angular momentum
+  using MassSamplingTables = std::map<std::pair<double, int>,
+                                      std::shared_ptr<const MassSamplingTable>>;
+  /**
+   * Tabulated mass distributions, which are created on first use if the
+   * mass sampling is tabulated (see tabulate_mass_sampling). A published map
+   * is never modified. New tables are added to a copy, which replaces the map
+   * atomically, so that the tables can be looked up without a lock. Mutable,
+   * because they are only a cache.
+   */
+  mutable std::shared_ptr<const MassSamplingTables> mass_sampling_tables_;
+
+  /**
+   * \param[in] mass_stable Mass of the stable partner.
+   * \param[in] L Relative angular momentum of the final-state particles.
+   * \return The tabulated mass distribution, which is looked up in the cache
+   *         or created on the first call.
+   */
+  std::shared_ptr<const MassSamplingTable> mass_sampling_table(
+      double mass_stable, int L) const;
+
+  /**
+   * Tabulate the mass distribution, see tabulate_mass_sampling.
+   *
+   * \param[in] mass_stable Mass of the stable partner.
+   * \param[in] L Relative angular momentum of the final-state particles.
+   * \return The tabulated mass distribution.
+   */
+  std::shared_ptr<const MassSamplingTable> create_mass_sampling_table(
+      double mass_stable, int L) const;
+
+  /**
+   * \param[in] table The tabulated mass distribution.
+   * \param[in] max_mass Largest possible mass of the resonance.
+   * \return Position of the largest mass in the sqrt(s) grid of the table,
+   *         in units of the grid spacing.
+   */
+  double mass_sampling_grid_position(const MassSamplingTable &table,
+                                     double max_mass) const;
+
+  /**
+   * Sample the resonance mass from the tabulated mass distribution, see
+   * tabulate_mass_sampling.
+   *
+   * \param[in] table The tabulated mass distribution.
+   * \param[in] max_mass Largest possible mass of the resonance.
+   * \return The mass of the resonance or a negative value, if the table does
+   *         not cover max_mass.
+   */
+  double sample_tabulated_mass(const MassSamplingTable &table,
+                               double max_mass) const;
+
+  /**
+   * Get the partial width of one decay mode of a particle, whose invariant
+   * mass is shifted by the potentials acting on it and on the decay products.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] UB Baryon potential at the position of the particle.
+   * \param[in] UI3 Isospin potential at the position of the particle.
+   * \param[in] mode_index Index of the decay mode in the decay mode list.
+   * \return the partial width of this mode
+   */
+  double partial_width_in_potentials(const FourVector &p, const FourVector &UB,
+                                     const FourVector &UI3,
+                                     std::size_t mode_index) const;
+
   /**\ingroup logging
    * Writes all information about the particle type to the output stream.
    *
@@ -10,6 +10,8 @@
 #ifndef SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 #define SRC_INCLUDE_SMASH_PAULIBLOCKING_H_
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "configuration.h"
@@ -34,6 +36,14 @@ namespace smash {
  * \iref{Gaitanos:2010fd}, section III B. Our implementation
  * mainly follows this article (and therefore GiBUU, see
  * http://gibuu.hepforge.org).
+ *
+ * To avoid looping over all particles for every phase-space density, the
+ * particles can be sorted by species into cubic cells in coordinate space
+ * (see build_index). A density is then summed only over the cells within
+ * reach of the point. The index has to be rebuilt whenever the particles
+ * were changed other than by propagation or by the actions reported via
+ * update_index, at least once per time step. Without an index, all particles
+ * are looped over.
  */
 class PauliBlocker {
  public:
@@ -68,7 +78,193 @@ class PauliBlocker {
                          const PdgCode pdg,
                          const ParticleList &disregard) const;
 
+  /**
+   * Calculate phase-space density of a particle species at the point (r,p),
+   * where the particles of one ensemble are taken from the current state and
+   * the ones of all other ensembles from a fixed earlier state.
+   *
+   * This is used if the ensembles are evolved concurrently, where the other
+   * ensembles cannot be accessed consistently.
+   *
+   * \param[in] r Position vector of the particle.
+   * \param[in] p Momentum vector of the particle.
+   * \param[in] own_ensemble Current list of particles in the ensemble, in which
+   *                         the action is performed.
+   * \param[in] i_own_ensemble Index of this ensemble.
+   * \param[in] frozen_ensembles Earlier state of the particles in all
+   *                             ensembles. The entry at i_own_ensemble is not
+   *                             used.
+   * \param[in] pdg PDG number of species for which density to be calculated.
+   * \param[in] disregard Do not count particles that should be disregarded.
+   * \return Phase-space density
+   */
+  double phasespace_dens(const ThreeVector &r, const ThreeVector &p,
+                         const Particles &own_ensemble, int i_own_ensemble,
+                         const std::vector<ParticleList> &frozen_ensembles,
+                         const PdgCode pdg,
+                         const ParticleList &disregard) const;
+
+  /**
+   * Sort the particles of all ensembles into the spatial index used by
+   * phasespace_dens.
+   *
+   * Particles are expected to move at most by max_drift from their current
+   * positions until the index is rebuilt or cleared, apart from changes
+   * reported via update_index.
+   *
+   * \param[in] ensembles Current list of particles in all ensembles.
+   * \param[in] max_drift Maximal time until the index is rebuilt [fm].
+   */
+  void build_index(const std::vector<Particles> &ensembles, double max_drift);
+
+  /**
+   * Sort the fixed earlier state of the ensembles, which is used if the
+   * ensembles are evolved concurrently, into a spatial index.
+   *
+   * \param[in] frozen_ensembles Earlier state of the particles in all
+   *                             ensembles. It has to be kept unchanged as
+   *                             long as it is used for phasespace_dens.
+   */
+  void build_frozen_index(const std::vector<ParticleList> &frozen_ensembles);
+
+  /**
+   * Update the spatial index of one ensemble after an action was performed.
+   * Does nothing if there is no index.
+   *
+   * \param[in] i_ensemble Index of the ensemble.
+   * \param[in] removed Incoming particles of the action.
+   * \param[in] added Outgoing particles of the action, which have to be valid
+   *                  copies of the particles in the ensemble.
+   */
+  void update_index(int i_ensemble, const ParticleList &removed,
+                    const ParticleList &added);
+
+  /// Forget the spatial indices, such that all particles are looped over.
+  void clear_index();
+
  private:
+  /// Species and position of a cell of the spatial index
+  struct CellKey {
+    /// PDG code of the particles in the cell
+    std::int32_t pdg;
+    /// Cell coordinates in units of the cell length
+    int x, y, z;
+    /// \return Whether both keys denote the same cell.
+    bool operator==(const CellKey &other) const {
+      return pdg == other.pdg && x == other.x && y == other.y && z == other.z;
+    }
+  };
+
+  /// Hash function for CellKey
+  struct CellKeyHash {
+    /**
+     * \param[in] key Cell to be hashed.
+     * \return Hash of the cell.
+     */
+    std::size_t operator()(const CellKey &key) const {
+      std::size_t h = static_cast<std::uint32_t>(key.pdg);
+      for (int coordinate : {key.x, key.y, key.z}) {
+        h = h * 1000003u ^ static_cast<std::uint32_t>(coordinate);
+      }
+      return h;
+    }
+  };
+
+  /// Particles of one ensemble sorted into cells
+  struct EnsembleIndex {
+    /**
+     * Copies of the particles in every non-empty cell. In the index of a
+     * Particles object they only identify the current state of the particles.
+     */
+    std::unordered_map<CellKey, ParticleList, CellKeyHash> cells;
+    /// The cell of every particle id, only needed for updates
+    std::unordered_map<int, CellKey> cell_of_id;
+  };
+
+  /**
+   * \param[in] pdg PDG code of the particle.
+   * \param[in] r Position of the particle.
+   * \return The cell of the particle.
+   */
+  CellKey cell_of(const PdgCode pdg, const ThreeVector &r) const;
+
+  /**
+   * Add a particle to a spatial index.
+   *
+   * \param[in] part The particle to be added.
+   * \param[out] index The index of the ensemble of the particle.
+   */
+  void add_to_index(const ParticleData &part, EnsembleIndex *index) const;
+
+  /**
+   * Calculate the weight of a single particle for the phase-space density at
+   * the point (r,p).
+   *
+   * \param[in] part The particle, whose contribution is calculated.
+   * \param[in] r Position vector of the particle.
+   * \param[in] p Momentum vector of the particle.
+   * \param[in] pdg PDG number of species for which density to be calculated.
+   * \param[in] disregard Do not count particles that should be disregarded.
+   * \return Unnormalized contribution to the phase-space density
+   */
+  double phasespace_weight(const ParticleData &part, const ThreeVector &r,
+                           const ThreeVector &p, const PdgCode pdg,
+                           const ParticleList &disregard) const;
+
+  /**
+   * Sum up the weights of the particles in the cells of a spatial index,
+   * which can contribute to the phase-space density at the point (r,p).
+   *
+   * \param[in] r Position vector of the particle.
+   * \param[in] p Momentum vector of the particle.
+   * \param[in] index Spatial index of one ensemble.
+   * \param[in] reach Distance from r, up to which particles in the index
+   *                  can contribute [fm].
+   * \param[in] pdg PDG number of species for which density to be calculated.
+   * \param[in] disregard Do not count particles that should be disregarded.
+   * \param[in] current_state Returns the current state of a particle in the
+   *                          index or nullptr, if the particle is gone.
+   * \return Unnormalized contribution to the phase-space density
+   */
+  template <typename CurrentState>
+  double indexed_weight_sum(const ThreeVector &r, const ThreeVector &p,
+                            const EnsembleIndex &index, double reach,
+                            const PdgCode pdg, const ParticleList &disregard,
+                            const CurrentState &current_state) const;
+
+  /**
+   * Sum up the weights of the indexed particles of a Particles object.
+   *
+   * \param[in] r Position vector of the particle.
+   * \param[in] p Momentum vector of the particle.
+   * \param[in] particles Particles of one ensemble.
+   * \param[in] index Spatial index of these particles.
+   * \param[in] pdg PDG number of species for which density to be calculated.
+   * \param[in] disregard Do not count particles that should be disregarded.
+   * \return Unnormalized contribution to the phase-space density
+   */
+  double indexed_weight_sum(const ThreeVector &r, const ThreeVector &p,
+                            const Particles &particles,
+                            const EnsembleIndex &index, const PdgCode pdg,
+                            const ParticleList &disregard) const;
+
+  /**
+   * Sum up the weights of the particles in one ensemble, which contribute to
+   * the phase-space density at the point (r,p).
+   *
+   * \param[in] r Position vector of the particle.
+   * \param[in] p Momentum vector of the particle.
+   * \param[in] particles Particles of one ensemble.
+   * \param[in] pdg PDG number of species for which density to be calculated.
+   * \param[in] disregard Do not count particles that should be disregarded.
+   * \return Unnormalized contribution to the phase-space density
+   */
+  template <typename ParticleContainer>
+  double phasespace_weight_sum(const ThreeVector &r, const ThreeVector &p,
+                               const ParticleContainer &particles,
+                               const PdgCode pdg,
+                               const ParticleList &disregard) const;
+
   /// Tabulate integrals for weights
   void init_weights();
 
@@ -95,6 +291,15 @@ class PauliBlocker {
 
   /// Weights: tabulated results of numerical integration
   std::array<double, 30> weights_;
+
+  /// Spatial indices of the current particles of all ensembles
+  std::vector<EnsembleIndex> index_;
+
+  /// Spatial indices of the frozen state of all ensembles
+  std::vector<EnsembleIndex> frozen_index_;
+
+  /// Maximal distance, which the particles move after building index_, fm
+  double max_drift_ = 0.0;
 };
 }  // namespace smash
 
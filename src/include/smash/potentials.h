@@ -331,6 +331,9 @@ class Potentials {
   /// \return cutoff radius in ntegration for coulomb potential in fm
   double coulomb_r_cut() const { return coulomb_r_cut_; }
 
+  /// \return Parameters of the smearing used for the densities
+  const DensityParameters &density_parameters() const { return param_; }
+
  private:
   /**
    * Struct that contains the gaussian smearing width \f$\sigma\f$,
@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "actionarena.h"
 #include "decaytype.h"
 #include "forwarddeclarations.h"
 #include "particletype.h"
@@ -157,6 +158,24 @@ class ProcessBranch {
    */
   virtual ~ProcessBranch() = default;
 
+  /**
+   * Allocate a branch from the ActionArena of the current scope, or from the
+   * heap if there is none.
+   *
+   * \param[in] size Size of the branch [bytes].
+   * \return Pointer to the memory of the branch.
+   */
+  static void *operator new(std::size_t size) {
+    return ActionArena::allocate(size);
+  }
+
+  /**
+   * Free the memory of a branch.
+   *
+   * \param[in] ptr Pointer to the memory of the branch.
+   */
+  static void operator delete(void *ptr) { ActionArena::deallocate(ptr); }
+
   /**
    * Set the weight of the branch.
    * In other words, how probable this branch is
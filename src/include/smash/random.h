@@ -27,7 +27,7 @@ namespace random {
 using Engine = std::mt19937_64;
 
 /// The engine that is used commonly by all distributions.
-extern /*thread_local (see #3075)*/ Engine engine;
+extern thread_local Engine engine;
 
 /** Provides uniform random numbers on a fixed interval.
  *
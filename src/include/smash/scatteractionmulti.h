@@ -64,6 +64,20 @@ class ScatterActionMulti : public Action {
   void add_possible_reactions(double dt, const double gcell_vol,
                               const MultiParticleReactionsBitSet incl_multi);
 
+  /**
+   * Check whether a particle can be one of the incoming particles of the
+   * enabled multi-particle reactions with the given number of incoming
+   * particles. If any incoming particle cannot, add_possible_reactions does
+   * not find any reaction.
+   *
+   * \param[in] pdg PDG code of the particle
+   * \param[in] n_incoming Number of incoming particles
+   * \param[in] incl_multi Which multi-particle reactions are enabled?
+   * \return whether the particle can take part in a reaction.
+   */
+  static bool can_be_incoming(PdgCode pdg, std::size_t n_incoming,
+                              const MultiParticleReactionsBitSet incl_multi);
+
   /**
    * Get list of possible reaction channels.
    *
@@ -18,6 +18,7 @@
 #include "actionfinderfactory.h"
 #include "configuration.h"
 #include "scatteraction.h"
+#include "totalcrosssectiontable.h"
 
 namespace smash {
 
@@ -313,6 +314,21 @@ class ScatterActionsFinder : public ActionFinderInterface {
   ActionPtr check_collision_multi_part(const ParticleList &plist, double dt,
                                        const double gcell_vol) const;
 
+  /**
+   * Calculate the total cross section of two particles with their pole masses
+   * at the given center-of-mass energy, with the same processes as in
+   * check_collision_two_part. Used to fill xs_bound_table_.
+   *
+   * \param[in] type_a Type of the first particle.
+   * \param[in] type_b Type of the second particle.
+   * \param[in] sqrts Center-of-mass energy [GeV].
+   * \return Total cross section [mb], without the scaling factors of the
+   *         particles.
+   */
+  double pole_mass_cross_section(const ParticleType &type_a,
+                                 const ParticleType &type_b,
+                                 double sqrts) const;
+
   /// Class that deals with strings, interfacing Pythia.
   std::unique_ptr<StringProcess> string_process_interface_;
   /// Specifies which collision criterion is used
@@ -364,6 +380,14 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * over 1.
    */
   const bool only_warn_for_high_prob_;
+  /**
+   * Approximate upper bounds of the total cross sections of pairs of stable
+   * particles (see TotalCrossSectionTable for their accuracy). They allow
+   * rejecting distant pairs for the geometric and covariant criteria without
+   * building all collision branches. Not used for the stochastic criterion,
+   * where every pair needs its cross section anyway.
+   */
+  std::unique_ptr<TotalCrossSectionTable> xs_bound_table_;
 };
 
 }  // namespace smash
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "constants.h"
 #include "logging.h"
 #include "particledata.h"
+#include "sha256.h"
 
 namespace smash {
 static constexpr int LPythia = LogArea::Pythia::id;
@@ -180,6 +182,23 @@ class StringProcess {
   /// Map object to contain the different pythia objects
   pythia_map hard_map_;
 
+  /**
+   * Create and initialize a PYTHIA object for hard string routines.
+   *
+   * The object is initialized at the collision energy given by
+   * mpi_init_energy, which is the maximal energy it can be used for. If a
+   * cache directory has been set by cache_mpi_initialization, the
+   * initialization of the multiparton interactions is read from there, or
+   * stored there if it has not been cached yet.
+   *
+   * \param[in] idAB PDG codes of the two beam particles in PYTHIA
+   * \param[in] sqrts Collision energy, which the object is needed for [GeV]
+   * \return The initialized PYTHIA object
+   * \throw std::runtime_error if PYTHIA fails to initialize
+   */
+  std::unique_ptr<Pythia8::Pythia> create_hard_pythia(
+      const std::pair<int, int> &idAB, double sqrts);
+
   /// PYTHIA object used in fragmentation
   std::unique_ptr<Pythia8::Pythia> pythia_hadron_;
 
@@ -198,6 +217,20 @@ class StringProcess {
    */
   Pythia8::Event event_intermediate_;
 
+  /**
+   * Serializes the access to the PYTHIA objects, if several ensembles are
+   * evolved concurrently.
+   */
+  std::mutex mutex_;
+
+  /**
+   * Whether the random number generator of #pythia_hadron_ is reseeded from
+   * the SMASH random number generator at every string excitation. This is
+   * needed for reproducible results if the collisions of several ensembles
+   * are performed concurrently in an unpredictable order.
+   */
+  bool reseed_per_collision_ = false;
+
  public:
   // clang-format off
 
@@ -280,6 +313,46 @@ class StringProcess {
                            double stringz_a, double stringz_b,
                            double string_sigma_T);
 
+  /**
+   * Cache the initialization of the multiparton interactions of the PYTHIA
+   * objects for hard string routines on disk.
+   *
+   * The initialization of the multiparton interactions dominates the time
+   * needed to create a PYTHIA object for a new pair of beam particles. It is
+   * stored per beam pair and initialization energy in a file, whose name
+   * contains a hash of the particle properties and the string parameters, so
+   * that later runs with the same settings can reuse it.
+   *
+   * \param[in] hash The hash of the particle properties.
+   * \param[in] tabulations_path The path to the directory where the
+   *             initializations are cached. Nothing is cached, if it is empty.
+   */
+  static void cache_mpi_initialization(sha256::Hash hash,
+                                       const bf::path &tabulations_path);
+
+  /**
+   * Energy at which a PYTHIA object for hard string routines is initialized.
+   *
+   * With variable collision energies, PYTHIA can only be used up to the energy
+   * of the initialization. The energy is rounded up to a power of two, so that
+   * few initializations are needed and they can be cached.
+   *
+   * \param[in] sqrts Collision energy [GeV]
+   * \return Initialization energy, at least 4 GeV [GeV]
+   */
+  static double mpi_init_energy(double sqrts);
+
+  /**
+   * Initialize the multiparton interactions of PYTHIA for all pairs of beam
+   * particles, which hadrons of the particle list are mapped onto, and for all
+   * initialization energies up to the given collision energy, and cache them
+   * on disk. This allows to prepare the cache in a separate run.
+   *
+   * \param[in] sqrts_max Maximal collision energy [GeV]
+   * \throw std::runtime_error if no cache directory has been set
+   */
+  void prepare_mpi_initialization(double sqrts_max);
+
   /**
    * Set PYTHIA random seeds to be desired values.
    * The value is recalculated such that it is allowed by PYTHIA.
@@ -323,6 +396,7 @@ class StringProcess {
     if (sqrt_s < sqrts_threshold) {
       sqrt_s = sqrts_threshold;
     }
+    std::lock_guard<std::mutex> lock(mutex_);
     pythia_sigmatot_.calc(pdg_a, pdg_b, sqrt_s);
     return {pythia_sigmatot_.sigmaAX(), pythia_sigmatot_.sigmaXB(),
             pythia_sigmatot_.sigmaXX()};
@@ -378,6 +452,20 @@ class StringProcess {
     kappa_tension_string_ = kappa_string;
   }
 
+  /**
+   * Mutex that has to be held while a string excitation is performed, since
+   * the PYTHIA objects cannot be used from several threads at the same time.
+   */
+  std::mutex &mutex() { return mutex_; }
+
+  /**
+   * Set whether the random number generator of the PYTHIA object used in
+   * fragmentation is reseeded at every initialization of a collision, see
+   * #reseed_per_collision_.
+   * \param[in] reseed whether to reseed at every collision
+   */
+  void set_reseed_per_collision(bool reseed) { reseed_per_collision_ = reseed; }
+
   // clang-format off
 
   /**
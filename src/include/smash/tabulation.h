@@ -12,6 +12,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "forwarddeclarations.h"
@@ -31,13 +32,17 @@ enum class Extrapolation {
 
 /**
  * A class for storing a one-dimensional lookup table of floating-point values.
+ *
+ * The values are shared by all copies of a tabulation. They are either owned
+ * by the tabulation or are part of a memory-mapped tabulation archive, see
+ * map_archive.
  */
 class Tabulation {
  public:
   /**
    * Construct an empty tabulation object.
    */
-  Tabulation() : values_({}), x_min_(0.0), x_max_(0.0), inv_dx_(0.0) {}
+  Tabulation() : x_min_(0.0), x_max_(0.0), inv_dx_(0.0) {}
 
   /**
    * Construct a new tabulation object.
@@ -56,7 +61,15 @@ class Tabulation {
   /**
    * \returns whether the tabulation is empty.
    */
-  bool is_empty() const { return values_.empty(); }
+  bool is_empty() const { return n_values_ == 0; }
+
+  /**
+   * \param x Argument to tabulated function.
+   * \returns whether \par x lies within the tabulation domain.
+   */
+  bool covers(double x) const {
+    return n_values_ > 0 && x >= x_min_ && x <= x_max_;
+  }
 
   /**
    * Construct a tabulation object by reading binary data from a stream.
@@ -105,9 +118,51 @@ class Tabulation {
    */
   void write(std::ofstream& stream, sha256::Hash hash) const;
 
+  /**
+   * Map a tabulation archive, which was written by save_archive, with
+   * map_cache_file. The returned tabulations refer to the mapped file and
+   * keep it mapped as long as any of them exists.
+   *
+   * \param file_name Name of the archive.
+   * \param hash Hash corresponding to the particle properties for which the
+   *             tabulations were created.
+   * \param n_tabulations Expected number of tabulations.
+   * \return The tabulations in the order in which they were saved, or an empty
+   *         vector, if the file does not exist or does not match.
+   */
+  static std::vector<Tabulation> map_archive(const std::string& file_name,
+                                             sha256::Hash hash,
+                                             size_t n_tabulations);
+
+  /**
+   * Save tabulations as a single archive with save_cache_file, which can be
+   * mapped by map_archive.
+   *
+   * \param file_name Name of the archive.
+   * \param hash Hash corresponding to the particle properties for which the
+   *             tabulations were created.
+   * \param tabulations The tabulations to be saved.
+   * \return Whether the archive was saved.
+   */
+  static bool save_archive(const std::string& file_name, sha256::Hash hash,
+                           const std::vector<Tabulation>& tabulations);
+
  protected:
-  /// vector for storing tabulated values
-  std::vector<double> values_;
+  /**
+   * Set the values of the tabulation to a new vector.
+   *
+   * \param values The tabulated values.
+   */
+  void assign_values(std::vector<double>&& values);
+
+  /// Owner of the tabulated values (a vector or a mapped archive)
+  std::shared_ptr<const void> storage_;
+
+  /// tabulated values
+  const double* values_ = nullptr;
+
+  /// number of tabulated values
+  size_t n_values_ = 0;
 
   /// lower bound for tabulation
   double x_min_;
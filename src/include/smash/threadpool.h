@@ -0,0 +1,141 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_THREADPOOL_H_
+#define SRC_INCLUDE_SMASH_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * \ingroup data
+ *
+ * A minimal pool of persistent worker threads that executes loops of
+ * independent tasks.
+ *
+ * The pool is meant for coarse-grained work (e.g. the evolution of one
+ * ensemble during one time step), where the overhead of waking the workers is
+ * negligible compared to the work per task. The tasks of one parallel_for call
+ * are distributed dynamically over the workers and the calling thread, which
+ * also participates in the work. parallel_for only returns after all tasks
+ * are finished, i.e. it acts as a barrier.
+ *
+ * Usage:
+ * \code
+ * ThreadPool pool(4);
+ * std::vector<double> result(n);
+ * pool.parallel_for(n, [&](int i) { result[i] = expensive(i); });
+ * \endcode
+ *
+ * The tasks must not call parallel_for of the same pool.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Create a pool that uses \p n_threads threads in total, i.e. n_threads - 1
+   * worker threads in addition to the calling thread.
+   *
+   * \param[in] n_threads Total number of threads. If it is smaller than 1, the
+   *                      number of hardware threads is used.
+   */
+  explicit ThreadPool(int n_threads);
+
+  /// Stops and joins all worker threads.
+  ~ThreadPool();
+
+  /// Cannot be copied
+  ThreadPool(const ThreadPool &) = delete;
+  /// Cannot be copied
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Call \p task for every index in [0, n_tasks) and wait until all calls have
+   * returned.
+   *
+   * There is no guarantee on which thread or in which order the tasks are
+   * executed. If tasks throw, the remaining tasks are still executed and the
+   * first exception is rethrown in the calling thread.
+   *
+   * \param[in] n_tasks Number of tasks.
+   * \param[in] task Function that is called with the task index.
+   */
+  void parallel_for(int n_tasks, const std::function<void(int)> &task);
+
+  /// \return Total number of threads used, including the calling thread.
+  int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+ private:
+  /// Main loop of the worker threads.
+  void worker_loop();
+
+  /// Execute tasks of the current loop until none are left.
+  void work_on_tasks();
+
+  /// The worker threads.
+  std::vector<std::thread> workers_;
+  /// Protects the state that is shared with the workers.
+  std::mutex mutex_;
+  /// Signals the workers that a new loop is available or the pool stops.
+  std::condition_variable start_condition_;
+  /// Signals the calling thread that all workers finished the loop.
+  std::condition_variable done_condition_;
+  /// Incremented for every new loop, so that workers can detect it.
+  unsigned generation_ = 0;
+  /// Number of workers that still work on the current loop.
+  int busy_workers_ = 0;
+  /// Whether the workers should terminate.
+  bool stop_ = false;
+  /// The task of the current loop.
+  const std::function<void(int)> *task_ = nullptr;
+  /// Number of tasks in the current loop.
+  int n_tasks_ = 0;
+  /// Index of the next task that is not yet started.
+  std::atomic<int> next_task_{0};
+  /// The first exception thrown by a task of the current loop.
+  std::exception_ptr exception_;
+};
+
+/**
+ * Check the number of threads given by a configuration option.
+ *
+ * \param[in] n_threads Configured number of threads, where 0 stands for the
+ *                      number of hardware threads.
+ * \param[in] option Name of the option, which is reported in the error.
+ * \return The number of threads to use, which is at least 1.
+ * \throw std::invalid_argument if n_threads is negative.
+ */
+int number_of_threads(int n_threads, const char *option);
+
+/**
+ * Create a pool for the number of threads given by a configuration option.
+ *
+ * \param[in] n_threads Configured number of threads, where 0 stands for the
+ *                      number of hardware threads.
+ * \param[in] option Name of the option, which is reported in the error.
+ * \param[in] max_threads Upper limit for the number of threads, e.g. the
+ *                        number of independent tasks.
+ * \return The pool or nullptr if only one thread is used.
+ * \throw std::invalid_argument if n_threads is negative.
+ */
+std::unique_ptr<ThreadPool> make_thread_pool(
+    int n_threads, const char *option,
+    int max_threads = std::numeric_limits<int>::max());
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_THREADPOOL_H_
@@ -0,0 +1,136 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_SMASH_TOTALCROSSSECTIONTABLE_H_
+#define SRC_INCLUDE_SMASH_TOTALCROSSSECTIONTABLE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "particletype.h"
+
+namespace smash {
+
+/**
+ * \ingroup collision
+ *
+ * Lazily filled table of upper bounds of the total cross section of pairs of
+ * stable particle species on a fine grid in \f$\sqrt{s}\f$.
+ *
+ * It allows rejecting a pair of particles by the geometric collision criterion
+ * without building the list of all collision branches: if the transverse
+ * distance is larger than the one allowed by the upper bound, the pair cannot
+ * collide. Only the pairs passing this test need the actual cross section.
+ *
+ * The cross section of a pair of stable particles only depends on the
+ * species and on \f$\sqrt{s}\f$, as long as the potentials do not shift the
+ * thresholds. For every pair of species, the \f$\sqrt{s}\f$ axis is divided
+ * into bins. When a bin is needed for the first time, the total cross section
+ * is evaluated at several points within the bin and the maximum, multiplied by
+ * a safety factor, is stored as the bound of the bin. Bins close to the
+ * threshold of the pair, where the cross section can change rapidly, and
+ * \f$\sqrt{s}\f$ values beyond the tabulated range are not covered. Neither
+ * are pairs involving unstable particles, whose cross sections depend on
+ * their masses.
+ *
+ * The bounds are approximate, because the cross section is only sampled at
+ * points with a distance \f$ h \f$ = bin_width / samples_per_bin. They hold
+ * as long as every peak of the cross section is at least as broad as a
+ * Breit-Wigner peak of full width \f$ h / \sqrt{f - 1} \approx \f$ 4 MeV,
+ * with \f$ f \f$ = safety_factor. Narrower peaks can exceed the bound
+ * between two samples. Therefore a pair is not covered either, if it forms a
+ * narrower resonance within the tabulated range according to the decay
+ * modes. Narrow peaks of other origin are still missed.
+ *
+ * The table can be used from several threads concurrently.
+ */
+class TotalCrossSectionTable {
+ public:
+  /**
+   * Function that calculates the total cross section [mb] of a pair of
+   * particles with their pole masses at the given \f$\sqrt{s}\f$ [GeV].
+   */
+  using TotalCrossSection = std::function<double(
+      const ParticleType &, const ParticleType &, double)>;
+
+  /**
+   * Create an empty table for the currently defined particle types and
+   * decay modes.
+   *
+   * \param[in] total_cross_section Function calculating the cross sections to
+   *            be tabulated.
+   */
+  explicit TotalCrossSectionTable(TotalCrossSection total_cross_section);
+
+  /**
+   * Look up an upper bound of the total cross section, filling the table if
+   * necessary.
+   *
+   * \param[in] type_a Type of the first particle.
+   * \param[in] type_b Type of the second particle.
+   * \param[in] sqrts Center-of-mass energy of the pair [GeV].
+   * \return Upper bound of the total cross section [mb], or infinity if the
+   *         pair or \f$\sqrt{s}\f$ is not covered by the table.
+   */
+  double upper_bound(const ParticleType &type_a, const ParticleType &type_b,
+                     double sqrts);
+
+  /// Width of the \f$\sqrt{s}\f$ bins [GeV]
+  static constexpr double bin_width = 0.005;
+  /// Largest tabulated \f$\sqrt{s}\f$ [GeV]
+  static constexpr double max_sqrts = 20.;
+  /// Minimal distance of a tabulated bin to the threshold of the pair [GeV]
+  static constexpr double threshold_distance = 0.05;
+  /// Number of intervals, into which a bin is divided for the evaluation
+  static constexpr int samples_per_bin = 4;
+  /**
+   * Factor by which the maximal evaluated cross section of a bin is
+   * increased, which covers peaks between the samples down to the width
+   * given in the class description
+   */
+  static constexpr double safety_factor = 1.1;
+
+ private:
+  /// The bounds for one pair of species, negative if not yet evaluated
+  using Row = std::vector<std::atomic<double>>;
+
+  /**
+   * \param[in] stable_a Index of the first species among the stable ones.
+   * \param[in] stable_b Index of the second species among the stable ones.
+   * \return The row of the pair, which is created if necessary.
+   */
+  Row &row(int stable_a, int stable_b);
+
+  /// The tabulated function
+  const TotalCrossSection total_cross_section_;
+  /// Index among the stable species for every type, -1 for unstable ones
+  std::vector<int> stable_index_;
+  /**
+   * Whether a pair of stable species forms a resonance narrower than the
+   * covered peaks, for all pairs
+   */
+  std::vector<bool> narrow_peak_;
+  /// Number of stable species
+  int n_stable_ = 0;
+  /// Number of \f$\sqrt{s}\f$ bins
+  int n_bins_ = 0;
+  /// Rows of all pairs of stable species, nullptr if not yet created
+  std::unique_ptr<std::atomic<Row *>[]> rows_;
+  /// Owns the created rows
+  std::vector<std::unique_ptr<Row>> created_rows_;
+  /// Protects the creation of rows
+  std::mutex mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_SMASH_TOTALCROSSSECTIONTABLE_H_
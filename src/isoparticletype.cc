@@ -10,7 +10,6 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 
-#include "smash/filelock.h"
 #include "smash/integrate.h"
 #include "smash/logging.h"
 
@@ -183,180 +182,179 @@ static Integrator integrate;
 static Integrator2d integrate2d;
 
 /**
- * Tabulation of all N R integrals.
- *
- * Keys are the multiplet names (which are unique).
- */
-static std::unordered_map<std::string, Tabulation> NR_tabulations;
-
-/**
- * Tabulation of all pi R integrals.
- *
- * Keys are the multiplet names (which are unique).
- */
-static std::unordered_map<std::string, Tabulation> piR_tabulations;
-
-/**
- * Tabulation of all K R integrals.
- *
- * Keys are the multiplet names (which are unique).
- */
-static std::unordered_map<std::string, Tabulation> RK_tabulations;
-
-/**
- * Tabulation of all Delta R integrals.
- *
- * Keys are the pairs of multiplet names (which are unique).
+ * Tabulations of all resonance integrals, in the order of the jobs created by
+ * IsoParticleType::tabulate_integrals. The multiplets refer to them by
+ * pointer.
  */
-static std::unordered_map<std::string, Tabulation> DeltaR_tabulations;
+static std::vector<Tabulation> integral_tabulations;
+
+namespace {
+/// A resonance integral, which has to be tabulated
+struct IntegralJob {
+  /// The partner of the resonance
+  const IsoParticleType *part;
+  /// The resonance multiplet
+  const IsoParticleType *res;
+  /// The anti-multiplet of the resonance, which shares the tabulation
+  const IsoParticleType *antires;
+  /// Whether the partner is unstable
+  bool unstable;
+  /// The member of the multiplets, which points to the tabulation
+  Tabulation *IsoParticleType::*target;
+};
+}  // unnamed namespace
 
 /**
- * Tabulation of all rho rho integrals.
+ * Calculate the tabulation of a resonance integral.
  *
- * Keys are the pairs of multiplet names (which are unique).
+ * \param job The integral.
+ * \return Tabulation of the integral.
  */
-static std::unordered_map<std::string, Tabulation> rhoR_tabulations;
-
-static bf::path generate_tabulation_path(const bf::path &dir,
-                                         const std::string &prefix,
-                                         const std::string &res_name) {
-  return dir / (prefix + res_name + ".bin");
-}
-
-inline void cache_integral(
-    std::unordered_map<std::string, Tabulation> &tabulations,
-    const bf::path &dir, sha256::Hash hash, const IsoParticleType &part,
-    const IsoParticleType &res, const IsoParticleType *antires, bool unstable) {
+static Tabulation calculate_integral(const IntegralJob &job) {
   constexpr double spacing = 2.0;
   constexpr double spacing2d = 3.0;
-  const auto path = generate_tabulation_path(dir, part.name_filtered_prime(),
-                                             res.name_filtered_prime());
-  Tabulation integral;
-  if (!dir.empty() && bf::exists(path)) {
-    std::ifstream file(path.string());
-    integral = Tabulation::from_file(file, hash);
-    if (!integral.is_empty()) {
-      // Only print message if the found tabulation was valid.
-      std::cout << "Tabulation found at " << path.filename() << '\r'
-                << std::flush;
-    }
-  }
-  if (integral.is_empty()) {
-    if (!dir.empty()) {
-      std::cout << "Caching tabulation to " << path.filename() << '\r'
-                << std::flush;
-    } else {
-      std::cout << "Calculating integral for " << part.name_filtered_prime()
-                << res.name_filtered_prime() << '\r' << std::flush;
-    }
-    if (!unstable) {
-      integral = spectral_integral_semistable(integrate, *res.get_states()[0],
-                                              *part.get_states()[0], spacing);
-    } else {
-      integral = spectral_integral_unstable(integrate2d, *res.get_states()[0],
-                                            *part.get_states()[0], spacing2d);
-    }
-    if (!dir.empty()) {
-      std::ofstream file(path.string());
-      integral.write(file, hash);
-    }
-  }
-  tabulations.emplace(std::make_pair(res.name(), integral));
-  if (antires != nullptr) {
-    tabulations.emplace(std::make_pair(antires->name(), integral));
+  std::cout << "Calculating integral for " << job.part->name_filtered_prime()
+            << job.res->name_filtered_prime() << '\r' << std::flush;
+  if (!job.unstable) {
+    return spectral_integral_semistable(integrate, *job.res->get_states()[0],
+                                        *job.part->get_states()[0], spacing);
   }
+  return spectral_integral_unstable(integrate2d, *job.res->get_states()[0],
+                                    *job.part->get_states()[0], spacing2d);
 }
 
 void IsoParticleType::tabulate_integrals(sha256::Hash hash,
                                          const bf::path &tabulations_path) {
-  // To avoid race conditions, make sure we are the only ones currently storing
-  // tabulations. Otherwise, we ignore any stored tabulations and don't store
-  // our results.
-  FileLock lock(tabulations_path / "tabulations.lock");
-  const bf::path &dir = lock.acquire() ? tabulations_path : "";
-
   const auto nuc = IsoParticleType::try_find("N");
   const auto pion = IsoParticleType::try_find("π");
   const auto kaon = IsoParticleType::try_find("K");
   const auto delta = IsoParticleType::try_find("Δ");
   const auto rho = IsoParticleType::try_find("ρ");
   const auto h1 = IsoParticleType::try_find("h₁(1170)");
+  std::vector<IntegralJob> jobs;
   for (const auto &res : IsoParticleType::list_baryon_resonances()) {
     const auto antires = res->anti_multiplet();
     if (nuc) {
-      cache_integral(NR_tabulations, dir, hash, *nuc, *res, antires, false);
+      jobs.push_back({nuc, res, antires, false,
+                      &IsoParticleType::XS_NR_tabulation_});
     }
     if (pion) {
-      cache_integral(piR_tabulations, dir, hash, *pion, *res, antires, false);
+      jobs.push_back({pion, res, antires, false,
+                      &IsoParticleType::XS_piR_tabulation_});
     }
     if (kaon) {
-      cache_integral(RK_tabulations, dir, hash, *kaon, *res, antires, false);
+      jobs.push_back({kaon, res, antires, false,
+                      &IsoParticleType::XS_RK_tabulation_});
     }
     if (delta) {
-      cache_integral(DeltaR_tabulations, dir, hash, *delta, *res, antires,
-                     true);
+      jobs.push_back({delta, res, antires, true,
+                      &IsoParticleType::XS_DeltaR_tabulation_});
     }
   }
   if (rho) {
-    cache_integral(rhoR_tabulations, dir, hash, *rho, *rho, nullptr, true);
+    jobs.push_back(
+        {rho, rho, nullptr, true, &IsoParticleType::XS_rhoR_tabulation_});
   }
   if (rho && h1) {
-    cache_integral(rhoR_tabulations, dir, hash, *rho, *h1, nullptr, true);
+    jobs.push_back(
+        {rho, h1, nullptr, true, &IsoParticleType::XS_rhoR_tabulation_});
+  }
+
+  /* All integrals are stored in one archive, which is mapped read-only, so
+   * that all processes using the same tabulations share them in memory. */
+  std::string archive;
+  if (!tabulations_path.empty()) {
+    archive = (tabulations_path / "integrals.bin").string();
+  }
+  integral_tabulations.clear();
+  if (!archive.empty()) {
+    integral_tabulations = Tabulation::map_archive(archive, hash, jobs.size());
+    if (!integral_tabulations.empty()) {
+      logg[LParticleType].info("Tabulated integrals found at ", archive);
+    }
+  }
+  if (integral_tabulations.empty()) {
+    integral_tabulations.reserve(jobs.size());
+    for (const IntegralJob &job : jobs) {
+      integral_tabulations.push_back(calculate_integral(job));
+    }
+    if (!archive.empty() &&
+        Tabulation::save_archive(archive, hash, integral_tabulations)) {
+      logg[LParticleType].info("Tabulated integrals cached to ", archive);
+    }
+  }
+
+  /* Set the tabulations of all multiplets right away. This way, the
+   * multiplets are not modified when the integrals are needed, which can then
+   * happen concurrently in several threads. If several jobs refer to the same
+   * multiplet, the first one is used. */
+  for (IsoParticleType &multiplet : iso_type_list) {
+    multiplet.XS_NR_tabulation_ = nullptr;
+    multiplet.XS_piR_tabulation_ = nullptr;
+    multiplet.XS_RK_tabulation_ = nullptr;
+    multiplet.XS_DeltaR_tabulation_ = nullptr;
+    multiplet.XS_rhoR_tabulation_ = nullptr;
+  }
+  for (size_t i = 0; i < jobs.size(); i++) {
+    for (const IsoParticleType *res : {jobs[i].res, jobs[i].antires}) {
+      if (res == nullptr) {
+        continue;
+      }
+      Tabulation *&target = find_private(res->name()).*(jobs[i].target);
+      if (target == nullptr) {
+        target = &integral_tabulations[i];
+      }
+    }
   }
 }
 
-double IsoParticleType::get_integral_NR(double sqrts) {
-  if (XS_NR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_NR_tabulation_ = &NR_tabulations.at(res->name());
+/**
+ * \param tabulation Tabulation of a resonance integral of a multiplet.
+ * \param integral Name of the integral.
+ * \param multiplet Name of the multiplet.
+ * \return The tabulation.
+ * \throw std::runtime_error if the integral was not tabulated.
+ */
+static const Tabulation &checked_tabulation(const Tabulation *tabulation,
+                                            const char *integral,
+                                            const std::string &multiplet) {
+  if (tabulation == nullptr) {
+    throw std::runtime_error(std::string("The ") + integral +
+                             " integral of " + multiplet +
+                             " was not tabulated.");
   }
-  return XS_NR_tabulation_->get_value_linear(sqrts);
+  return *tabulation;
+}
+
+double IsoParticleType::get_integral_NR(double sqrts) {
+  return checked_tabulation(XS_NR_tabulation_, "NR", name_)
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_piR(double sqrts) {
-  if (XS_piR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_piR_tabulation_ = &piR_tabulations.at(res->name());
-  }
-  return XS_piR_tabulation_->get_value_linear(sqrts);
+  return checked_tabulation(XS_piR_tabulation_, "piR", name_)
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_RK(double sqrts) {
-  if (XS_RK_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_RK_tabulation_ = &RK_tabulations.at(res->name());
-  }
-  return XS_RK_tabulation_->get_value_linear(sqrts);
+  return checked_tabulation(XS_RK_tabulation_, "RK", name_)
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_rhoR(double sqrts) {
-  if (XS_rhoR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-  }
-  return XS_rhoR_tabulation_->get_value_linear(sqrts);
+  return checked_tabulation(XS_rhoR_tabulation_, "rhoR", name_)
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_RR(IsoParticleType *type_res_2,
                                         double sqrts) {
-  const auto res = states_[0]->iso_multiplet();
   if (type_res_2->states_[0]->is_Delta()) {
-    if (XS_DeltaR_tabulation_ == nullptr) {
-      XS_DeltaR_tabulation_ = &DeltaR_tabulations.at(res->name());
-    }
-    return XS_DeltaR_tabulation_->get_value_linear(sqrts);
+    return checked_tabulation(XS_DeltaR_tabulation_, "DeltaR", name_)
+        .get_value_linear(sqrts);
   }
-  if (type_res_2->name() == "ρ") {
-    if (XS_rhoR_tabulation_ == nullptr) {
-      XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-    }
-    return XS_rhoR_tabulation_->get_value_linear(sqrts);
-  }
-  if (type_res_2->name() == "h₁(1170)") {
-    if (XS_rhoR_tabulation_ == nullptr) {
-      XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-    }
-    return XS_rhoR_tabulation_->get_value_linear(sqrts);
+  if (type_res_2->name() == "ρ" || type_res_2->name() == "h₁(1170)") {
+    return checked_tabulation(XS_rhoR_tabulation_, "rhoR", name_)
+        .get_value_linear(sqrts);
   }
   std::stringstream err;
   err << "RR=" << name() << type_res_2->name() << " is not implemented";
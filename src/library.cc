@@ -12,10 +12,12 @@
 #include <boost/filesystem.hpp>
 
 #include "smash/decaymodes.h"
+#include "smash/hadgas_eos.h"
 #include "smash/inputfunctions.h"
 #include "smash/isoparticletype.h"
 #include "smash/logging.h"
 #include "smash/setup_particles_decaymodes.h"
+#include "smash/stringprocess.h"
 
 namespace smash {
 static constexpr int LMain = LogArea::Main::id;
@@ -100,6 +102,22 @@ void initialize_particles_decays_and_tabulations(
     logg[LMain].info() << "Tabulations path: " << tabulations_path;
   }
   IsoParticleType::tabulate_integrals(hash, tabulations_path);
+  StringProcess::cache_mpi_initialization(hash, tabulations_path);
+  EosTable::set_particles_hash(hash);
+
+  const double width_mass_step =
+      configuration.take({"General", "Width_Tabulation", "Mass_Step"}, 0.005);
+  const double width_max_error =
+      configuration.take({"General", "Width_Tabulation", "Max_Error"}, 1e-3);
+  ParticleType::tabulate_widths(width_mass_step, width_max_error, hash,
+                                tabulations_path);
+
+  const double mass_sampling_sqrts_step = configuration.take(
+      {"General", "Mass_Sampling_Tabulation", "Sqrts_Step"}, 0.);
+  const int mass_sampling_intervals = configuration.take(
+      {"General", "Mass_Sampling_Tabulation", "Mass_Intervals"}, 128);
+  ParticleType::tabulate_mass_sampling(mass_sampling_sqrts_step,
+                                       mass_sampling_intervals);
 }
 
 }  // namespace smash
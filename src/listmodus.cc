@@ -9,10 +9,18 @@
 
 #include "smash/listmodus.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
+#include <cstring>
 #include <list>
 #include <map>
 #include <sstream>
@@ -20,12 +28,12 @@
 #include <vector>
 
 #include <boost/filesystem.hpp>
-#include <boost/filesystem/fstream.hpp>
 
 #include "smash/algorithms.h"
 #include "smash/boxmodus.h"
 #include "smash/configuration.h"
 #include "smash/constants.h"
+#include "smash/cxx14compat.h"
 #include "smash/experimentparameters.h"
 #include "smash/fourvector.h"
 #include "smash/inputfunctions.h"
@@ -135,6 +143,150 @@ static constexpr int LList = LogArea::List::id;
  * details please check the List userpage.
  */
 
+namespace {
+/// \return Whether c separates the columns of a particle list.
+bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/// Reads the whitespace separated columns of a line of a particle list.
+class FieldReader {
+ public:
+  /**
+   * \param[in] begin First character of the line
+   * \param[in] end Behind the last character of the line
+   */
+  FieldReader(const char *begin, const char *end)
+      : position_(begin), end_(end) {}
+
+  /**
+   * Read the next column as a finite number.
+   * \param[out] x The number.
+   * \return Whether the column exists and is a valid number.
+   */
+  bool read(double &x) {
+    if (!next()) {
+      return false;
+    }
+    char *number_end;
+    x = std::strtod(buffer_, &number_end);
+    return *number_end == '\0' && std::isfinite(x);
+  }
+
+  /**
+   * Read the next column as an integer.
+   * \param[out] n The integer.
+   * \return Whether the column exists and is a valid integer.
+   */
+  bool read(int &n) {
+    if (!next()) {
+      return false;
+    }
+    char *number_end;
+    errno = 0;
+    const long value = std::strtol(buffer_, &number_end, 10);  // NOLINT
+    n = static_cast<int>(value);
+    return *number_end == '\0' && errno == 0 && n == value;
+  }
+
+  /**
+   * Read the next column.
+   * \param[out] s The column.
+   * \return Whether the column exists.
+   */
+  bool read(std::string &s) {
+    if (!next()) {
+      return false;
+    }
+    s.assign(buffer_);
+    return true;
+  }
+
+ private:
+  /**
+   * Copy the next column into buffer_.
+   * \return Whether there is a column, which fits into buffer_.
+   */
+  bool next() {
+    position_ = std::find_if_not(position_, end_, is_blank);
+    const char *field_end = std::find_if(position_, end_, is_blank);
+    const std::size_t length = field_end - position_;
+    if (length == 0 || length >= sizeof(buffer_)) {
+      return false;
+    }
+    std::memcpy(buffer_, position_, length);
+    buffer_[length] = '\0';
+    position_ = field_end;
+    return true;
+  }
+
+  /// Beginning of the remaining line
+  const char *position_;
+  /// End of the line
+  const char *end_;
+  /// The current column, null-terminated
+  char buffer_[64];
+};
+}  // unnamed namespace
+
+ParticleListFile::ParticleListFile(const bf::path &path) : path_(path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open " + path.native() + ": " +
+                             std::strerror(errno));
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    const int error = errno;
+    close(fd);
+    throw std::runtime_error("Could not read " + path.native() + ": " +
+                             std::strerror(error));
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+  if (size_ > 0) {
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      const int error = errno;
+      close(fd);
+      throw std::runtime_error("Could not map " + path.native() + ": " +
+                               std::strerror(error));
+    }
+    data_ = static_cast<char *>(data);
+  }
+  close(fd);
+
+  /* Events are terminated by a line containing "end" in case of Oscar output.
+   * Assume one event per file for all other output formats. */
+  const char needle[] = "end";
+  const char *const end = data_ + size_;
+  const char *event_begin = data_;
+  int event_first_line = 1;
+  int line_number = 1;
+  for (const char *line = data_; line < end; line_number++) {
+    const char *line_end = std::find(line, end, '\n');
+    const char *next_line = line_end == end ? end : line_end + 1;
+    if (std::search(line, line_end, needle, needle + 3) != line_end) {
+      events_.push_back({event_begin, line, event_first_line});
+      event_begin = next_line;
+      event_first_line = line_number + 1;
+    }
+    line = next_line;
+  }
+  const bool has_text =
+      std::find_if(event_begin, end, [](char c) {
+        return !std::isspace(static_cast<unsigned char>(c));
+      }) != end;
+  if (has_text) {
+    events_.push_back({event_begin, end, event_first_line});
+  }
+  logg[LList].debug() << path_.filename().native() << " contains "
+                      << events_.size() << " events";
+}
+
+ParticleListFile::~ParticleListFile() {
+  if (data_) {
+    munmap(data_, size_);
+  }
+}
+
 ListModus::ListModus(Configuration modus_config,
                      const ExperimentParameters &param)
     : shift_id_(modus_config.take({"List", "Shift_Id"})) {
@@ -253,31 +405,16 @@ void ListModus::try_create_particle(Particles &particles, PdgCode pdgcode,
 /* initial_conditions - sets particle data for @particles */
 double ListModus::initial_conditions(Particles *particles,
                                      const ExperimentParameters &) {
-  std::string particle_list = next_event_();
-  for (const Line &line : line_parser(particle_list)) {
-    std::istringstream lineinput(line.text);
-    double t, x, y, z, mass, E, px, py, pz;
-    int id, charge;
-    std::string pdg_string;
-    lineinput >> t >> x >> y >> z >> mass >> E >> px >> py >> pz >>
-        pdg_string >> id >> charge;
-    if (lineinput.fail()) {
-      throw LoadFailure(
-          build_error_string("While loading external particle lists data:\n"
-                             "Failed to convert the input string to the "
-                             "expected data types.",
-                             line));
-    }
-    PdgCode pdgcode(pdg_string);
-    logg[LList].debug("Particle ", pdgcode, " (x,y,z)= (", x, ", ", y, ", ", z,
-                      ")");
-
-    // Charge consistency check
-    if (pdgcode.charge() != charge) {
-      logg[LList].error() << "Charge of pdg = " << pdgcode << " != " << charge;
-      throw std::invalid_argument("Inconsistent input (charge).");
+  const ParticleListFile::Event &event = next_event_();
+  int line_number = event.first_line;
+  for (const char *line = event.begin; line < event.end; line_number++) {
+    const char *line_end = std::find(line, event.end, '\n');
+    // Everything behind '#' is a comment
+    const char *content_end = std::find(line, line_end, '#');
+    if (std::find_if_not(line, content_end, is_blank) != content_end) {
+      read_particle_(*particles, line, content_end, line_number);
     }
-    try_create_particle(*particles, pdgcode, t, x, y, z, mass, E, px, py, pz);
+    line = line_end == event.end ? event.end : line_end + 1;
   }
   if (particles->size() > 0) {
     backpropagate_to_same_time(*particles);
@@ -289,6 +426,37 @@ double ListModus::initial_conditions(Particles *particles,
   return start_time_;
 }
 
+void ListModus::read_particle_(Particles &particles, const char *begin,
+                               const char *end, int line_number) {
+  FieldReader fields(begin, end);
+  double t, x, y, z, mass, E, px, py, pz;
+  int id, charge;
+  std::string pdg_string;
+  // Further columns are ignored
+  const bool valid = fields.read(t) && fields.read(x) && fields.read(y) &&
+                     fields.read(z) && fields.read(mass) && fields.read(E) &&
+                     fields.read(px) && fields.read(py) && fields.read(pz) &&
+                     fields.read(pdg_string) && fields.read(id) &&
+                     fields.read(charge);
+  if (!valid) {
+    throw LoadFailure(
+        build_error_string("While loading external particle lists data:\n"
+                           "Failed to convert the input string to the "
+                           "expected data types.",
+                           Line(line_number, std::string(begin, end))));
+  }
+  PdgCode pdgcode(pdg_string);
+  logg[LList].debug("Particle ", pdgcode, " (x,y,z)= (", x, ", ", y, ", ", z,
+                    ")");
+
+  // Charge consistency check
+  if (pdgcode.charge() != charge) {
+    logg[LList].error() << "Charge of pdg = " << pdgcode << " != " << charge;
+    throw std::invalid_argument("Inconsistent input (charge).");
+  }
+  try_create_particle(particles, pdgcode, t, x, y, z, mass, E, px, py, pz);
+}
+
 bf::path ListModus::file_path_(const int file_id) {
   std::stringstream fname;
   fname << particle_list_file_prefix_ << file_id;
@@ -315,75 +483,17 @@ bf::path ListModus::file_path_(const int file_id) {
   return fpath;
 }
 
-std::string ListModus::next_event_() {
-  const bf::path fpath = file_path_(file_id_);
-  bf::ifstream ifs{fpath};
-  ifs.seekg(last_read_position_);
-
-  if (!file_has_events_(fpath, last_read_position_)) {
-    // current file out of events. get next file and call this function
-    // recursively.
-    file_id_++;
-    last_read_position_ = 0;
-    ifs.close();
-    return next_event_();
-  }
-
-  // read one event. events marked by line # event end i in case of Oscar
-  // output. Assume one event per file for all other output formats
-  std::string event_string;
-  const std::string needle = "end";
-  std::string line;
-  while (getline(ifs, line)) {
-    if (line.find(needle) == std::string::npos) {
-      event_string += line + "\n";
-    } else {
-      break;
+const ParticleListFile::Event &ListModus::next_event_() {
+  // Files without further events are skipped
+  while (!current_file_ ||
+         next_event_in_file_ == current_file_->n_events()) {
+    if (current_file_) {
+      file_id_++;
     }
+    current_file_ = make_unique<ParticleListFile>(file_path_(file_id_));
+    next_event_in_file_ = 0;
   }
-
-  if (!ifs.eof() && (ifs.fail() || ifs.bad())) {
-    logg[LList].fatal() << "Error while reading " << fpath.filename().native();
-    throw std::runtime_error("Error while reading external particle list");
-  }
-  // save position for next event read
-  last_read_position_ = ifs.tellg();
-  ifs.close();
-
-  return event_string;
-}
-
-bool ListModus::file_has_events_(bf::path filepath,
-                                 std::streampos last_position) {
-  bf::ifstream ifs{filepath};
-  std::string line;
-
-  // last event read read at end of file. we know this because errors are
-  // handled in next_event
-  if (last_position == -1) {
-    return false;
-  }
-  ifs.seekg(last_position);
-  // skip over comment lines, assume that a max. of four consecutive comment
-  // lines can occur
-  int skipped_lines = 0;
-  const int max_comment_lines = 4;
-  while (std::getline(ifs, line) && line[0] != '#' &&
-         skipped_lines++ < max_comment_lines) {
-  }
-
-  if (ifs.eof()) {
-    return false;
-  }
-
-  if (!ifs.good()) {
-    logg[LList].fatal() << "Error while reading "
-                        << filepath.filename().native();
-    throw std::runtime_error("Error while reading external particle list");
-  }
-
-  ifs.close();
-  return true;
+  return current_file_->event(next_event_in_file_++);
 }
 
 ListBoxModus::ListBoxModus(Configuration modus_config,
@@ -6,17 +6,23 @@
  */
 #include "smash/nucleus.h"
 
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "smash/angles.h"
+#include "smash/cachefile.h"
 #include "smash/constants.h"
 #include "smash/fourvector.h"
 #include "smash/logging.h"
 #include "smash/random.h"
+#include "smash/sha256.h"
+#include "smash/threadpool.h"
 #include "smash/threevector.h"
 
 namespace smash {
@@ -263,6 +269,18 @@ double Nucleus::woods_saxon(double r) {
 }
 
 void Nucleus::arrange_nucleons() {
+  if (configuration_pool_) {
+    const size_t n_configurations = configuration_pool_size();
+    const size_t k = random::uniform_int<size_t>(0, n_configurations - 1);
+    const ThreeVector *positions = &(*configuration_pool_)[k * size()];
+    for (ParticleData &p : particles_) {
+      p.set_4momentum(p.pole_mass(), 0.0, 0.0, 0.0);
+      p.set_4position(FourVector(0.0, *positions++));
+    }
+    rotate_randomly();
+    rotate();
+    return;
+  }
   for (auto i = begin(); i != end(); i++) {
     // Initialize momentum
     i->set_4momentum(i->pole_mass(), 0.0, 0.0, 0.0);
@@ -279,6 +297,148 @@ void Nucleus::arrange_nucleons() {
   rotate();
 }
 
+namespace {
+/// Identifies files with configuration pools
+constexpr char pool_magic[8] = {'S', 'M', 'A', 'S', 'H', 'N', 'U', 'C'};
+/// Version of the file format of configuration pools
+constexpr std::uint32_t pool_version = 1;
+
+/// Header of a file with a configuration pool, followed by the positions
+struct PoolHeader {
+  /// Common header with pool_magic and pool_version
+  CacheFileHeader common;
+  /// Number of nucleons per configuration
+  std::uint64_t n_nucleons;
+  /// Number of configurations
+  std::uint64_t n_configurations;
+};
+static_assert(sizeof(ThreeVector) == 3 * sizeof(double),
+              "The positions of the pool are written as bytes.");
+}  // unnamed namespace
+
+void Nucleus::create_configuration_pool(size_t n_configurations,
+                                        ThreadPool *threads,
+                                        const std::string &directory) {
+  if (particles_.empty() || n_configurations == 0) {
+    return;
+  }
+  const std::string key = position_distribution_parameters();
+  const sha256::Hash hash = sha256::calculate(
+      reinterpret_cast<const uint8_t *>(key.data()), key.size());
+  const std::string file_name =
+      directory.empty() ? std::string()
+                        : directory + "/nucleus_pool_" +
+                              sha256::hash_to_string(hash) + "_" +
+                              std::to_string(n_configurations) + ".bin";
+  if (!file_name.empty() &&
+      load_configuration_pool(file_name, n_configurations, hash)) {
+    logg[LNucleus].info("Read ", n_configurations,
+                        " nucleus configurations from ", file_name);
+    return;
+  }
+
+  // One seed per configuration, so the pool does not depend on the threads
+  std::vector<random::Engine::result_type> seeds(n_configurations);
+  for (auto &seed : seeds) {
+    seed = random::advance();
+  }
+  // The calling thread also samples, so its engine is restored afterwards
+  const random::Engine engine = random::engine;
+  auto pool =
+      std::make_shared<std::vector<ThreeVector>>(n_configurations * size());
+  auto sample = [&](int k) {
+    random::set_seed(seeds[k]);
+    sample_configuration(&(*pool)[k * size()]);
+  };
+  if (threads) {
+    threads->parallel_for(static_cast<int>(n_configurations), sample);
+  } else {
+    for (size_t k = 0; k < n_configurations; k++) {
+      sample(k);
+    }
+  }
+  random::engine = engine;
+  configuration_pool_ = std::move(pool);
+  logg[LNucleus].info("Sampled ", n_configurations, " nucleus configurations");
+
+  if (!file_name.empty()) {
+    save_configuration_pool(file_name, hash);
+  }
+}
+
+void Nucleus::sample_configuration(ThreeVector *positions) {
+  ThreeVector center;
+  for (size_t i = 0; i < size(); i++) {
+    positions[i] = distribute_nucleon();
+    center += positions[i];
+  }
+  center /= size();
+  for (size_t i = 0; i < size(); i++) {
+    positions[i] -= center;
+  }
+}
+
+bool Nucleus::load_configuration_pool(const std::string &file_name,
+                                      size_t n_configurations,
+                                      const sha256::Hash &hash) {
+  const std::size_t size_expected =
+      sizeof(PoolHeader) + n_configurations * size() * sizeof(ThreeVector);
+  std::size_t file_size;
+  std::shared_ptr<const void> mapping = map_cache_file(
+      file_name,
+      CacheFileHeader::create(pool_magic, pool_version, sizeof(ThreeVector),
+                              hash),
+      size_expected, &file_size);
+  if (!mapping || file_size != size_expected) {
+    return false;
+  }
+  const PoolHeader *header = static_cast<const PoolHeader *>(mapping.get());
+  if (header->n_nucleons != size() ||
+      header->n_configurations != n_configurations) {
+    return false;
+  }
+  const ThreeVector *positions =
+      reinterpret_cast<const ThreeVector *>(header + 1);
+  configuration_pool_ = std::make_shared<std::vector<ThreeVector>>(
+      positions, positions + n_configurations * size());
+  return true;
+}
+
+void Nucleus::save_configuration_pool(const std::string &file_name,
+                                      const sha256::Hash &hash) const {
+  PoolHeader header;
+  header.common = CacheFileHeader::create(pool_magic, pool_version,
+                                          sizeof(ThreeVector), hash);
+  header.n_nucleons = size();
+  header.n_configurations = configuration_pool_size();
+  const bool saved = save_cache_file(file_name, [&](std::ofstream &file) {
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(configuration_pool_->data()),
+               configuration_pool_->size() * sizeof(ThreeVector));
+  });
+  if (!saved) {
+    logg[LNucleus].warn("Could not save the nucleus configurations to ",
+                        file_name);
+  }
+}
+
+void Nucleus::rotate_randomly() {
+  random_euler_angles();
+  for (ParticleData &p : particles_) {
+    ThreeVector pos = p.position().threevec();
+    pos.rotate(euler_phi_, euler_theta_, euler_psi_);
+    p.set_3position(pos);
+  }
+}
+
+std::string Nucleus::position_distribution_parameters() const {
+  std::ostringstream parameters;
+  parameters << std::setprecision(17) << "Woods-Saxon " << size() << " "
+             << nuclear_radius_ << " " << diffusiveness_ << " "
+             << saturation_density_;
+  return parameters.str();
+}
+
 void Nucleus::set_parameters_automatic() {
   int A = Nucleus::number_of_particles();
   int Z = Nucleus::number_of_protons();
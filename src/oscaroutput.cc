@@ -28,7 +28,8 @@ OscarOutput<Format, Contents>::OscarOutput(const bf::path &path,
     : OutputInterface(name),
       file_{path /
                 (name + ".oscar" + ((Format == OscarFormat1999) ? "1999" : "")),
-            "w"} {
+            "w"},
+      buffer_{file_.get()} {
   /*!\Userguide
    * \page oscar_general_ OSCAR Block Structure
    * OSCAR outputs are a family of ASCII and binary formats that follow
@@ -79,39 +80,34 @@ OscarOutput<Format, Contents>::OscarOutput(const bf::path &path,
    * and optionally the initial and final configuration.
    */
   if (Format == OscarFormat2013) {
-    std::fprintf(file_.get(),
-                 "#!OSCAR2013 %s t x y z mass "
-                 "p0 px py pz pdg ID charge\n",
-                 name.c_str());
-    std::fprintf(file_.get(),
-                 "# Units: fm fm fm fm "
-                 "GeV GeV GeV GeV GeV none none e\n");
-    std::fprintf(file_.get(), "# %s\n", SMASH_VERSION);
+    buffer_.printf("#!OSCAR2013 %s t x y z mass "
+                   "p0 px py pz pdg ID charge\n",
+                   name.c_str());
+    buffer_.printf("# Units: fm fm fm fm "
+                   "GeV GeV GeV GeV GeV none none e\n");
+    buffer_.printf("# %s\n", SMASH_VERSION);
   } else if (Format == OscarFormat2013Extended) {
-    std::fprintf(file_.get(),
-                 "#!OSCAR2013Extended %s t x y z mass p0 px py pz"
-                 " pdg ID charge ncoll form_time xsecfac proc_id_origin"
-                 " proc_type_origin time_last_coll pdg_mother1 pdg_mother2\n",
-                 name.c_str());
-    std::fprintf(file_.get(),
-                 "# Units: fm fm fm fm GeV GeV GeV GeV GeV"
-                 " none none e none fm none none none fm none none\n");
-    std::fprintf(file_.get(), "# %s\n", SMASH_VERSION);
+    buffer_.printf("#!OSCAR2013Extended %s t x y z mass p0 px py pz"
+                   " pdg ID charge ncoll form_time xsecfac proc_id_origin"
+                   " proc_type_origin time_last_coll pdg_mother1 pdg_mother2\n",
+                   name.c_str());
+    buffer_.printf("# Units: fm fm fm fm GeV GeV GeV GeV GeV"
+                   " none none e none fm none none none fm none none\n");
+    buffer_.printf("# %s\n", SMASH_VERSION);
   } else {
     const std::string &oscar_name =
         name == "particle_lists" ? "final_id_p_x" : name;
     // This is necessary because OSCAR199A requires
     // this particular string for particle output.
 
-    std::fprintf(file_.get(), "# OSC1999A\n# %s\n# %s\n", oscar_name.c_str(),
-                 SMASH_VERSION);
-    std::fprintf(file_.get(), "# Block format:\n");
-    std::fprintf(file_.get(), "# nin nout event_number\n");
-    std::fprintf(file_.get(), "# id pdg 0 px py pz p0 mass x y z t\n");
-    std::fprintf(file_.get(),
-                 "# End of event: 0 0 event_number"
-                 " impact_parameter\n");
-    std::fprintf(file_.get(), "#\n");
+    buffer_.printf("# OSC1999A\n# %s\n# %s\n", oscar_name.c_str(),
+                   SMASH_VERSION);
+    buffer_.printf("# Block format:\n");
+    buffer_.printf("# nin nout event_number\n");
+    buffer_.printf("# id pdg 0 px py pz p0 mass x y z t\n");
+    buffer_.printf("# End of event: 0 0 event_number"
+                   " impact_parameter\n");
+    buffer_.printf("#\n");
   }
 }
 
@@ -129,15 +125,13 @@ void OscarOutput<Format, Contents>::at_eventstart(const Particles &particles,
   current_event_ = event_number;
   if (Contents & OscarAtEventstart) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(), "# event %i in %zu\n", event_number,
-                   particles.size());
+      buffer_.printf("# event %i in %zu\n", event_number, particles.size());
     } else {
       /* OSCAR line prefix : initial particles; final particles; event id
        * First block of an event: initial = 0, final = number of particles
        */
       const size_t zero = 0;
-      std::fprintf(file_.get(), "%zu %zu %i\n", zero, particles.size(),
-                   event_number);
+      buffer_.printf("%zu %zu %i\n", zero, particles.size(), event_number);
     }
     if (!(Contents & OscarParticlesIC)) {
       // We do not want the inital particle list to be printed in case of IC
@@ -154,14 +148,12 @@ void OscarOutput<Format, Contents>::at_eventend(const Particles &particles,
   if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
     if (Contents & OscarParticlesAtEventend ||
         (Contents & OscarParticlesAtEventendIfNotEmpty && !event.empty_event)) {
-      std::fprintf(file_.get(), "# event %i out %zu\n", event_number,
-                   particles.size());
+      buffer_.printf("# event %i out %zu\n", event_number, particles.size());
       write(particles);
     }
     // Comment end of an event
     const char *empty_event_str = event.empty_event ? "no" : "yes";
-    std::fprintf(
-        file_.get(),
+    buffer_.printf(
         "# event %i end 0 impact %7.3f scattering_projectile_target %s\n",
         event_number, event.impact_parameter, empty_event_str);
   } else {
@@ -171,16 +163,15 @@ void OscarOutput<Format, Contents>::at_eventend(const Particles &particles,
     const size_t zero = 0;
     if (Contents & OscarParticlesAtEventend ||
         (Contents & OscarParticlesAtEventendIfNotEmpty && !event.empty_event)) {
-      std::fprintf(file_.get(), "%zu %zu %i\n", particles.size(), zero,
-                   event_number);
+      buffer_.printf("%zu %zu %i\n", particles.size(), zero, event_number);
       write(particles);
     }
     // Null interaction marks the end of an event
-    std::fprintf(file_.get(), "%zu %zu %i %7.3f\n", zero, zero, event_number,
-                 event.impact_parameter);
+    buffer_.printf("%zu %zu %i %7.3f\n", zero, zero, event_number,
+                   event.impact_parameter);
   }
   // Flush to disk
-  std::fflush(file_.get());
+  buffer_.flush();
 
   if (Contents & OscarParticlesIC) {
     // If the runtime is too short some particles might not yet have
@@ -199,13 +190,12 @@ void OscarOutput<Format, Contents>::at_interaction(const Action &action,
                                                    const double density) {
   if (Contents & OscarInteractions) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(),
-                   "# interaction in %zu out %zu rho %12.7f weight %12.7g"
-                   " partial %12.7f type %5i\n",
-                   action.incoming_particles().size(),
-                   action.outgoing_particles().size(), density,
-                   action.get_total_weight(), action.get_partial_weight(),
-                   static_cast<int>(action.get_type()));
+      buffer_.printf("# interaction in %zu out %zu rho %12.7f weight %12.7g"
+                     " partial %12.7f type %5i\n",
+                     action.incoming_particles().size(),
+                     action.outgoing_particles().size(), density,
+                     action.get_total_weight(), action.get_partial_weight(),
+                     static_cast<int>(action.get_type()));
     } else {
       /* OSCAR line prefix : initial final
        * particle creation: 0 1
@@ -213,11 +203,11 @@ void OscarOutput<Format, Contents>::at_interaction(const Action &action,
        * resonance formation: 2 1
        * resonance decay: 1 2
        * etc.*/
-      std::fprintf(file_.get(), "%zu %zu %12.7f %12.7f %12.7f %5i\n",
-                   action.incoming_particles().size(),
-                   action.outgoing_particles().size(), density,
-                   action.get_total_weight(), action.get_partial_weight(),
-                   static_cast<int>(action.get_type()));
+      buffer_.printf("%zu %zu %12.7f %12.7f %12.7f %5i\n",
+                     action.incoming_particles().size(),
+                     action.outgoing_particles().size(), density,
+                     action.get_total_weight(), action.get_partial_weight(),
+                     static_cast<int>(action.get_type()));
     }
     for (const auto &p : action.incoming_particles()) {
       write_particledata(p);
@@ -238,12 +228,10 @@ void OscarOutput<Format, Contents>::at_intermediate_time(
     const DensityParameters &, const EventInfo &) {
   if (Contents & OscarTimesteps) {
     if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
-      std::fprintf(file_.get(), "# event %i out %zu\n", current_event_,
-                   particles.size());
+      buffer_.printf("# event %i out %zu\n", current_event_, particles.size());
     } else {
       const size_t zero = 0;
-      std::fprintf(file_.get(), "%zu %zu %i\n", particles.size(), zero,
-                   current_event_);
+      buffer_.printf("%zu %zu %i\n", particles.size(), zero, current_event_);
     }
     write(particles);
   }
@@ -704,32 +692,69 @@ void OscarOutput<Format, Contents>::at_intermediate_time(
 template <OscarOutputFormat Format, int Contents>
 void OscarOutput<Format, Contents>::write_particledata(
     const ParticleData &data) {
+  /* The lines are formatted as by std::printf with the formats given in the
+   * comments, but much faster. */
   const FourVector pos = data.position();
   const FourVector mom = data.momentum();
-  if (Format == OscarFormat2013) {
-    std::fprintf(file_.get(), "%g %g %g %g %g %.9g %.9g %.9g %.9g %s %i %i\n",
-                 pos.x0(), pos.x1(), pos.x2(), pos.x3(), data.effective_mass(),
-                 mom.x0(), mom.x1(), mom.x2(), mom.x3(),
-                 data.pdgcode().string().c_str(), data.id(),
-                 data.type().charge());
-  } else if (Format == OscarFormat2013Extended) {
-    const auto h = data.get_history();
-    std::fprintf(
-        file_.get(),
-        "%g %g %g %g %g %.9g %.9g %.9g"
-        " %.9g %s %i %i %i %g %g %i %i %g %s %s\n",
-        pos.x0(), pos.x1(), pos.x2(), pos.x3(), data.effective_mass(), mom.x0(),
-        mom.x1(), mom.x2(), mom.x3(), data.pdgcode().string().c_str(),
-        data.id(), data.type().charge(), h.collisions_per_particle,
-        data.formation_time(), data.xsec_scaling_factor(), h.id_process,
-        static_cast<int>(h.process_type), h.time_last_collision,
-        h.p1.string().c_str(), h.p2.string().c_str());
+  if (Format == OscarFormat2013 || Format == OscarFormat2013Extended) {
+    // "%g %g %g %g %g %.9g %.9g %.9g %.9g %s %i %i"
+    for (const double x : pos) {
+      buffer_.append_g(x, 6);
+      buffer_.append(' ');
+    }
+    buffer_.append_g(data.effective_mass(), 6);
+    for (const double p : mom) {
+      buffer_.append(' ');
+      buffer_.append_g(p, 9);
+    }
+    buffer_.append(' ');
+    buffer_.append(data.pdgcode().string());
+    buffer_.append(' ');
+    buffer_.append(data.id());
+    buffer_.append(' ');
+    buffer_.append(data.type().charge());
+    if (Format == OscarFormat2013Extended) {
+      // " %i %g %g %i %i %g %s %s"
+      const auto h = data.get_history();
+      buffer_.append(' ');
+      buffer_.append(h.collisions_per_particle);
+      buffer_.append(' ');
+      buffer_.append_g(data.formation_time(), 6);
+      buffer_.append(' ');
+      buffer_.append_g(data.xsec_scaling_factor(), 6);
+      buffer_.append(' ');
+      buffer_.append(h.id_process);
+      buffer_.append(' ');
+      buffer_.append(static_cast<int>(h.process_type));
+      buffer_.append(' ');
+      buffer_.append_g(h.time_last_collision, 6);
+      buffer_.append(' ');
+      buffer_.append(h.p1.string());
+      buffer_.append(' ');
+      buffer_.append(h.p2.string());
+    }
   } else {
-    std::fprintf(file_.get(), "%i %s %i %g %g %g %g %g %g %g %g %g\n",
-                 data.id(), data.pdgcode().string().c_str(), 0, mom.x1(),
-                 mom.x2(), mom.x3(), mom.x0(), data.effective_mass(), pos.x1(),
-                 pos.x2(), pos.x3(), pos.x0());
+    // "%i %s %i %g %g %g %g %g %g %g %g %g"
+    buffer_.append(data.id());
+    buffer_.append(' ');
+    buffer_.append(data.pdgcode().string());
+    buffer_.append(" 0");
+    for (int i = 1; i < 4; i++) {
+      buffer_.append(' ');
+      buffer_.append_g(mom[i], 6);
+    }
+    buffer_.append(' ');
+    buffer_.append_g(mom.x0(), 6);
+    buffer_.append(' ');
+    buffer_.append_g(data.effective_mass(), 6);
+    for (int i = 1; i < 4; i++) {
+      buffer_.append(' ');
+      buffer_.append_g(pos[i], 6);
+    }
+    buffer_.append(' ');
+    buffer_.append_g(pos.x0(), 6);
   }
+  buffer_.append('\n');
 }
 
 namespace {
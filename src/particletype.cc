@@ -11,9 +11,18 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
+#include "smash/cachefile.h"
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
@@ -26,6 +35,7 @@
 #include "smash/logging.h"
 #include "smash/potential_globals.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -46,8 +56,150 @@ ParticleTypePtrList anti_deltas_list;
 ParticleTypePtrList baryon_resonances_list;
 /// Global pointer to the Particle Type list of light nuclei
 ParticleTypePtrList light_nuclei_list;
+
+/// Spacing of the mass grid of the tabulated widths, 0 if not tabulated
+double width_mass_step = 0.;
+/// Maximal relative interpolation error of the tabulated widths
+double width_max_error = 0.;
+/// Hash of the particle properties and the width tabulation parameters
+sha256::Hash width_hash;
+/// Directory, where the tabulated widths are cached (none if empty)
+bf::path width_tabulations_dir;
+
+/// Mass spacing of the sqrt(s) grid of the tabulated mass sampling, 0 if the
+/// mass sampling is not tabulated
+double mass_sampling_sqrts_step = 0.;
+/// Number of mass intervals per sqrt(s) of the tabulated mass sampling
+int mass_sampling_n_intervals = 0;
+/// Spacing of the sqrt(s) grid in the Cauchy variable of the largest mass
+constexpr double mass_sampling_angle_step = M_PI / 64.;
+/// Serializes the publication of new mass sampling tables
+std::mutex mass_sampling_mutex;
+
+/**
+ * Tabulate a width on an equidistant mass grid. The tabulation only starts
+ * above the last interval, where the linear interpolation violates the error
+ * bound at the interval midpoint.
+ *
+ * \param[in] m_min Lowest mass of the grid (the decay threshold).
+ * \param[in] m_max Highest mass of the grid.
+ * \param[in] scale The interpolation error is bounded relative to the larger
+ *            of this scale and the exact width.
+ * \param[in] width The width as a function of the mass.
+ * \return The tabulated width, which is empty if no part of the mass range
+ *         can be tabulated with the requested accuracy.
+ */
+Tabulation tabulate_width(double m_min, double m_max, double scale,
+                          const std::function<double(double)> &width) {
+  const double range = m_max - m_min;
+  if (!(range > 0.)) {
+    return Tabulation();
+  }
+  const size_t num =
+      std::max(static_cast<size_t>(std::ceil(range / width_mass_step)),
+               static_cast<size_t>(2));
+  const double dm = range / num;
+  const Tabulation full(m_min, range, num, width);
+  size_t first_accurate = 0;
+  for (size_t i = 0; i < num; i++) {
+    const double m = m_min + (i + 0.5) * dm;
+    const double exact = width(m);
+    const double error = std::abs(full.get_value_linear(m) - exact);
+    if (error > width_max_error * std::max(std::abs(exact), scale)) {
+      first_accurate = i + 1;
+    }
+  }
+  if (first_accurate == 0) {
+    return full;
+  }
+  if (num - first_accurate < 2) {
+    return Tabulation();
+  }
+  // Reuse the tabulated values of the accurate part of the grid
+  return Tabulation(m_min + first_accurate * dm, (num - first_accurate) * dm,
+                    num - first_accurate,
+                    [&](double m) { return full.get_value_linear(m); });
+}
+
+/**
+ * Read the tabulated widths of one particle type from a stream.
+ *
+ * \param[in] stream Stream containing the tabulations.
+ * \param[out] total Tabulated total width.
+ * \param[out] partial Tabulated partial widths, which have to be of the size
+ *             of the decay mode list.
+ * \return Whether the tabulations were created with the current particle
+ *         properties and tabulation parameters.
+ */
+bool read_widths(std::ifstream &stream, Tabulation *total,
+                 std::vector<Tabulation> *partial) {
+  sha256::Hash hash;
+  stream.read(reinterpret_cast<char *>(hash.data()), hash.size());
+  if (!stream || hash != width_hash) {
+    return false;
+  }
+  *total = Tabulation::from_file(stream, width_hash);
+  for (Tabulation &tabulation : *partial) {
+    tabulation = Tabulation::from_file(stream, width_hash);
+  }
+  return static_cast<bool>(stream);
+}
+
+/**
+ * Write the tabulated widths of one particle type to a stream.
+ *
+ * \param[in] stream Stream to which the tabulations are written.
+ * \param[in] total Tabulated total width.
+ * \param[in] partial Tabulated partial widths.
+ */
+void write_widths(std::ofstream &stream, const Tabulation &total,
+                  const std::vector<Tabulation> &partial) {
+  /* Empty tabulations are valid, so the hash is written in front of them to
+   * tell a valid file from one that has to be recreated. */
+  stream.write(reinterpret_cast<const char *>(width_hash.data()),
+               width_hash.size());
+  total.write(stream, width_hash);
+  for (const Tabulation &tabulation : partial) {
+    tabulation.write(stream, width_hash);
+  }
+}
 }  // unnamed namespace
 
+struct ParticleType::WidthTabulation {
+  /// Total width, empty if it is not tabulated
+  Tabulation total;
+  /// Partial widths in the order of the decay modes, empty if not tabulated
+  std::vector<Tabulation> partial;
+};
+
+struct ParticleType::MassSamplingTable {
+  /// Mass distribution at one sqrt(s) of the grid
+  struct Node {
+    /**
+     * Normalized Cauchy variable u of the mass grid, where
+     * t = t_min + u * (t_max - t_min), with t_max of the largest mass.
+     */
+    std::vector<double> u;
+    /// Mass distribution in u, normalized to 1, on the mass grid
+    std::vector<double> density;
+    /// Cumulative distribution on the mass grid
+    std::vector<double> cdf;
+    /**
+     * Index of the mass interval, where the cumulative distribution reaches
+     * i / n_intervals, to start the search for the sampled interval
+     */
+    std::vector<std::uint32_t> guide;
+  };
+  /// Mass of the stable partner [GeV]
+  double mass_stable;
+  /// Lowest mass of the resonance [GeV]
+  double m_min;
+  /// Cauchy variable atan((m - m_pole) / (Gamma_pole / 2)) of the lowest mass
+  double t_min;
+  /// The grid in sqrt(s), empty nodes if the mass distribution vanishes
+  std::vector<Node> nodes;
+};
+
 const ParticleTypeList &ParticleType::list_all() {
   assert(all_particle_types);
   return *all_particle_types;
@@ -66,6 +218,43 @@ ParticleTypePtr ParticleType::operator&() const {
   return ParticleTypePtr(static_cast<uint16_t>(offset));
 }
 
+namespace {
+/// The rejection factors used in this thread, nullptr for the shared ones
+thread_local ParticleType::RejectionFactors *current_rejection_factors =
+    nullptr;
+}  // unnamed namespace
+
+ParticleType::RejectionFactors::Scope::Scope(RejectionFactors *factors)
+    : previous_(current_rejection_factors) {
+  current_rejection_factors = factors;
+}
+
+ParticleType::RejectionFactors::Scope::~Scope() {
+  current_rejection_factors = previous_;
+}
+
+double &ParticleType::max_factor1() const {
+  if (current_rejection_factors == nullptr) {
+    return max_factor1_;
+  }
+  std::vector<double> &factors = current_rejection_factors->single_;
+  if (factors.empty()) {
+    factors.assign(list_all().size(), 1.);
+  }
+  return factors[this - std::addressof(list_all()[0])];
+}
+
+double &ParticleType::max_factor2() const {
+  if (current_rejection_factors == nullptr) {
+    return max_factor2_;
+  }
+  std::vector<double> &factors = current_rejection_factors->pair_;
+  if (factors.empty()) {
+    factors.assign(list_all().size(), 1.);
+  }
+  return factors[this - std::addressof(list_all()[0])];
+}
+
 ParticleTypePtrList &ParticleType::list_nucleons() { return nucleons_list; }
 
 ParticleTypePtrList &ParticleType::list_anti_nucleons() {
@@ -426,15 +615,29 @@ const DecayModes &ParticleType::decay_modes() const {
   return modes;
 }
 
+double ParticleType::tabulated_partial_width(const double m,
+                                             std::size_t mode_index) const {
+  const WidthTabulation *tabulation = width_tabulation();
+  if (tabulation && tabulation->partial[mode_index].covers(m)) {
+    return tabulation->partial[mode_index].get_value_linear(m);
+  }
+  return partial_width(m, decay_modes().decay_mode_list()[mode_index].get());
+}
+
 double ParticleType::total_width(const double m) const {
   double w = 0.;
   if (is_stable()) {
     return w;
   }
-  /* Loop over decay modes and sum up all partial widths. */
-  const auto &modes = decay_modes().decay_mode_list();
-  for (unsigned int i = 0; i < modes.size(); i++) {
-    w = w + partial_width(m, modes[i].get());
+  const WidthTabulation *tabulation = width_tabulation();
+  if (tabulation && tabulation->total.covers(m)) {
+    w = tabulation->total.get_value_linear(m);
+  } else {
+    /* Loop over decay modes and sum up all partial widths. */
+    const auto &modes = decay_modes().decay_mode_list();
+    for (unsigned int i = 0; i < modes.size(); i++) {
+      w = w + tabulated_partial_width(m, i);
+    }
   }
   if (w < width_cutoff) {
     return 0.;
@@ -451,6 +654,97 @@ void ParticleType::check_consistency() {
   }
 }
 
+void ParticleType::precompute_lazy_quantities() {
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    ptype.min_mass_kinematic();
+    ptype.min_mass_spectral();
+    ptype.isospin();
+    if (ptype.is_stable()) {
+      continue;
+    }
+    ptype.spectral_function(ptype.mass());
+    for (const auto &mode : ptype.decay_modes().decay_mode_list()) {
+      mode->threshold();
+      mode->type().width(ptype.mass(), ptype.width_at_pole(), ptype.mass());
+    }
+    ptype.width_tabulation();
+  }
+}
+
+void ParticleType::tabulate_widths(double mass_step, double max_error,
+                                   sha256::Hash hash,
+                                   const bf::path &tabulations_path) {
+  if (mass_step < 0.) {
+    throw std::invalid_argument(
+        "The mass step of the width tabulation must not be negative.");
+  }
+  if (!(max_error > 0.)) {
+    throw std::invalid_argument(
+        "The error bound of the width tabulation has to be positive.");
+  }
+  width_mass_step = mass_step;
+  width_max_error = max_error;
+  width_tabulations_dir = tabulations_path;
+  sha256::Context hash_context;
+  hash_context.update(hash.data(), hash.size());
+  hash_context.update(reinterpret_cast<const uint8_t *>(&mass_step),
+                      sizeof(mass_step));
+  hash_context.update(reinterpret_cast<const uint8_t *>(&max_error),
+                      sizeof(max_error));
+  width_hash = hash_context.finalize();
+  // Tabulations with other parameters have to be recreated
+  for (const ParticleType &ptype : list_all()) {
+    ptype.width_tabulation_.reset();
+  }
+}
+
+const ParticleType::WidthTabulation *ParticleType::width_tabulation() const {
+  if (!(width_mass_step > 0.) || is_stable()) {
+    return nullptr;
+  }
+  if (width_tabulation_) {
+    return width_tabulation_.get();
+  }
+  const auto &modes = decay_modes().decay_mode_list();
+  auto tabulation = std::make_shared<WidthTabulation>();
+  tabulation->partial.resize(modes.size());
+  const bool use_cache = !width_tabulations_dir.empty();
+  const bf::path path =
+      width_tabulations_dir / ("widths_" + pdgcode().string() + ".bin");
+  bool found = false;
+  if (use_cache && bf::exists(path)) {
+    std::ifstream file(path.string(), std::ios::binary);
+    found = read_widths(file, &tabulation->total, &tabulation->partial);
+  }
+  if (!found) {
+    const double m_max = mass() + std::max(2., 10. * width_at_pole());
+    double m_min = m_max;
+    for (unsigned int i = 0; i < modes.size(); i++) {
+      const DecayBranch *mode = modes[i].get();
+      m_min = std::min(m_min, mode->threshold());
+      tabulation->partial[i] = tabulate_width(
+          mode->threshold(), m_max, width_at_pole() * mode->weight(),
+          [&](double m) { return partial_width(m, mode); });
+    }
+    tabulation->total =
+        tabulate_width(m_min, m_max, width_at_pole(), [&](double m) {
+          double w = 0.;
+          for (const auto &mode : modes) {
+            w += partial_width(m, mode.get());
+          }
+          return w;
+        });
+    if (use_cache &&
+        !save_cache_file(path.string(), [&](std::ofstream &file) {
+          write_widths(file, tabulation->total, tabulation->partial);
+        })) {
+      logg[LParticleType].warn("Could not save the widths to ", path);
+    }
+  }
+  width_tabulation_ = tabulation;
+  return width_tabulation_.get();
+}
+
 bool ParticleType::wanted_decaymode(const DecayType &t,
                                     WhichDecaymodes wh) const {
   switch (wh) {
@@ -469,6 +763,48 @@ bool ParticleType::wanted_decaymode(const DecayType &t,
   }
 }
 
+namespace {
+/**
+ * Read the potentials at a position, which are zero if the potentials are
+ * not calculated on a lattice.
+ *
+ * \param[in] x The position.
+ * \param[out] UB The baryon potential.
+ * \param[out] UI3 The isospin potential.
+ */
+void potentials_at(const ThreeVector &x, FourVector *UB, FourVector *UI3) {
+  if (UB_lat_pointer != nullptr) {
+    UB_lat_pointer->value_at(x, *UB);
+  }
+  if (UI3_lat_pointer != nullptr) {
+    UI3_lat_pointer->value_at(x, *UI3);
+  }
+}
+}  // unnamed namespace
+
+double ParticleType::partial_width_in_potentials(const FourVector &p,
+                                                 const FourVector &UB,
+                                                 const FourVector &UI3,
+                                                 std::size_t mode_index) const {
+  /* Calculate the sqare root s of the final state particles. */
+  double scale_B = 0.0;
+  double scale_I3 = 0.0;
+  if (pot_pointer != nullptr) {
+    const auto &FinalTypes =
+        decay_modes().decay_mode_list()[mode_index]->type().particle_types();
+    scale_B += pot_pointer->force_scale(*this).first;
+    scale_I3 += pot_pointer->force_scale(*this).second * isospin3_rel();
+    for (const auto &finaltype : FinalTypes) {
+      scale_B -= pot_pointer->force_scale(*finaltype).first;
+      scale_I3 -= pot_pointer->force_scale(*finaltype).second *
+                  finaltype->isospin3_rel();
+    }
+  }
+  double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
+
+  return tabulated_partial_width(sqrt_s, mode_index);
+}
+
 DecayBranchList ParticleType::get_partial_widths(const FourVector p,
                                                  const ThreeVector x,
                                                  WhichDecaymodes wh) const {
@@ -478,32 +814,12 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
    * particle */
   FourVector UB = FourVector();
   FourVector UI3 = FourVector();
-  if (UB_lat_pointer != nullptr) {
-    UB_lat_pointer->value_at(x, UB);
-  }
-  if (UI3_lat_pointer != nullptr) {
-    UI3_lat_pointer->value_at(x, UI3);
-  }
+  potentials_at(x, &UB, &UI3);
   /* Loop over decay modes and calculate all partial widths. */
   DecayBranchList partial;
   partial.reserve(decay_mode_list.size());
   for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
-    /* Calculate the sqare root s of the final state particles. */
-    const auto FinalTypes = decay_mode_list[i]->type().particle_types();
-    double scale_B = 0.0;
-    double scale_I3 = 0.0;
-    if (pot_pointer != nullptr) {
-      scale_B += pot_pointer->force_scale(*this).first;
-      scale_I3 += pot_pointer->force_scale(*this).second * isospin3_rel();
-      for (const auto &finaltype : FinalTypes) {
-        scale_B -= pot_pointer->force_scale(*finaltype).first;
-        scale_I3 -= pot_pointer->force_scale(*finaltype).second *
-                    finaltype->isospin3_rel();
-      }
-    }
-    double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
-
-    const double w = partial_width(sqrt_s, decay_mode_list[i].get());
+    const double w = partial_width_in_potentials(p, UB, UI3, i);
     if (w > 0.) {
       if (wanted_decaymode(decay_mode_list[i]->type(), wh)) {
         partial.push_back(
@@ -514,6 +830,34 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   return partial;
 }
 
+bool ParticleType::get_dilepton_widths(
+    const FourVector p, const ThreeVector x,
+    std::vector<std::pair<std::size_t, double>> *widths) const {
+  widths->clear();
+  const DecayModes &modes = decay_modes();
+  const auto &dilepton_modes = modes.dilepton_mode_indices();
+  const auto &decay_mode_list = modes.decay_mode_list();
+  FourVector UB = FourVector();
+  FourVector UI3 = FourVector();
+  potentials_at(x, &UB, &UI3);
+  for (std::size_t i : dilepton_modes) {
+    const double w = partial_width_in_potentials(p, UB, UI3, i);
+    if (w > 0.) {
+      widths->emplace_back(i, w);
+    }
+  }
+  if (dilepton_modes.size() == decay_mode_list.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < decay_mode_list.size(); i++) {
+    if (!decay_mode_list[i]->type().is_dilepton_decay() &&
+        partial_width_in_potentials(p, UB, UI3, i) > 0.) {
+      return true;
+    }
+  }
+  return false;
+}
+
 double ParticleType::get_partial_width(const double m,
                                        const ParticleTypePtrList dlist) const {
   /* Get all decay modes. */
@@ -553,7 +897,7 @@ double ParticleType::spectral_function(double m) const {
   if (norm_factor_ < 0.) {
     /* Initialize the normalization factor
      * by integrating over the unnormalized spectral function. */
-    static /*thread_local (see #3075)*/ Integrator integrate;
+    static thread_local Integrator integrate;
     const double width = width_at_pole();
     const double m_pole = mass();
     // We transform the integral using m = m_min + width_pole * tan(x), to
@@ -593,6 +937,202 @@ double ParticleType::spectral_function_simple(double m) const {
   return breit_wigner_nonrel(m, mass(), width_at_pole());
 }
 
+void ParticleType::tabulate_mass_sampling(double sqrts_step,
+                                          int n_intervals) {
+  if (sqrts_step < 0.) {
+    throw std::invalid_argument(
+        "The sqrt(s) step of the mass sampling tabulation must not be "
+        "negative.");
+  }
+  if (n_intervals < 2) {
+    throw std::invalid_argument(
+        "The mass sampling tabulation needs at least 2 mass intervals.");
+  }
+  std::lock_guard<std::mutex> lock(mass_sampling_mutex);
+  mass_sampling_sqrts_step = sqrts_step;
+  mass_sampling_n_intervals = n_intervals;
+  // Tables with other parameters have to be recreated
+  for (const ParticleType &ptype : list_all()) {
+    std::atomic_store(&ptype.mass_sampling_tables_,
+                      std::shared_ptr<const MassSamplingTables>());
+  }
+}
+
+double ParticleType::mass_sampling_grid_position(const MassSamplingTable &table,
+                                                 double max_mass) const {
+  /* The grid points are equidistant in this coordinate, which combines the
+   * Cauchy variable and the mass, such that the sqrt(s) grid is dense where
+   * the mass distribution changes quickly with sqrt(s). The first grid point
+   * is at 1, since the mass distribution vanishes at the threshold. */
+  const double t_max = std::atan((max_mass - mass()) / (width_at_pole() / 2.));
+  return (t_max - table.t_min) / mass_sampling_angle_step +
+         (max_mass - table.m_min) / mass_sampling_sqrts_step - 1.;
+}
+
+std::shared_ptr<const ParticleType::MassSamplingTable>
+ParticleType::mass_sampling_table(double mass_stable, int L) const {
+  const auto key = std::make_pair(mass_stable, L);
+  auto tables = std::atomic_load(&mass_sampling_tables_);
+  if (tables) {
+    const auto found = tables->find(key);
+    if (found != tables->end()) {
+      return found->second;
+    }
+  }
+  /* The table is created without a lock, so that other threads can sample
+   * from the existing tables meanwhile. If two threads create the same table
+   * concurrently, the one published first is kept. */
+  auto table = create_mass_sampling_table(mass_stable, L);
+  std::lock_guard<std::mutex> lock(mass_sampling_mutex);
+  tables = std::atomic_load(&mass_sampling_tables_);
+  auto extended = tables ? std::make_shared<MassSamplingTables>(*tables)
+                         : std::make_shared<MassSamplingTables>();
+  const auto inserted = extended->emplace(key, table);
+  if (!inserted.second) {
+    return inserted.first->second;
+  }
+  std::atomic_store(&mass_sampling_tables_,
+                    std::shared_ptr<const MassSamplingTables>(extended));
+  return table;
+}
+
+std::shared_ptr<const ParticleType::MassSamplingTable>
+ParticleType::create_mass_sampling_table(double mass_stable, int L) const {
+  const double half_width = width_at_pole() / 2.;
+  const int n_intervals = mass_sampling_n_intervals;
+  const double m_max = mass() + std::max(2., 10. * width_at_pole());
+
+  auto table = std::make_shared<MassSamplingTable>();
+  table->mass_stable = mass_stable;
+  table->m_min = min_mass_spectral();
+  table->t_min = std::atan((table->m_min - mass()) / half_width);
+  const std::size_t n_nodes = static_cast<std::size_t>(
+      std::max(mass_sampling_grid_position(*table, m_max), 0.) + 1.);
+  table->nodes.resize(n_nodes);
+
+  std::vector<double> u_grid;
+  for (std::size_t i = 0; i < n_nodes; i++) {
+    // Find the largest mass of the grid point by bisection
+    double lower = table->m_min, upper = m_max;
+    for (int iteration = 0; iteration < 64; iteration++) {
+      const double middle = 0.5 * (lower + upper);
+      if (mass_sampling_grid_position(*table, middle) < i) {
+        lower = middle;
+      } else {
+        upper = middle;
+      }
+    }
+    const double max_mass = upper;
+    const double sqrts = max_mass + mass_stable;
+    const double t_max = std::atan((max_mass - mass()) / half_width);
+    /* The mass grid is equidistant in the Cauchy variable for one half and
+     * dense at the largest mass, where the mass distribution vanishes with a
+     * power of the momentum, for the other half. */
+    const int n_cauchy = n_intervals / 2;
+    const int n_edge = n_intervals - n_cauchy + 1;
+    u_grid.clear();
+    for (int j = 0; j <= n_cauchy; j++) {
+      u_grid.push_back(static_cast<double>(j) / n_cauchy);
+    }
+    for (int j = 1; j < n_edge; j++) {
+      const double distance = 1. - static_cast<double>(j) / n_edge;
+      const double m =
+          max_mass - (max_mass - table->m_min) * distance * distance;
+      u_grid.push_back((std::atan((m - mass()) / half_width) - table->t_min) /
+                       (t_max - table->t_min));
+    }
+    std::sort(u_grid.begin(), u_grid.end());
+
+    /* In the Cauchy variable, the mass distribution is proportional to the
+     * weight of the rejection sampling in sample_resonance_mass, which is
+     * integrated with the trapezoidal rule. */
+    MassSamplingTable::Node node;
+    node.u = u_grid;
+    node.density.resize(n_intervals + 1);
+    node.cdf.resize(n_intervals + 1);
+    for (int j = 0; j <= n_intervals; j++) {
+      const double t = table->t_min + node.u[j] * (t_max - table->t_min);
+      const double m = std::min(mass() + half_width * std::tan(t), max_mass);
+      const double pcm = pCM(sqrts, mass_stable, m);
+      node.density[j] = spectral_function(m) / spectral_function_simple(m) *
+                        pcm * blatt_weisskopf_sqr(pcm, L);
+      node.cdf[j] = j == 0 ? 0.
+                           : node.cdf[j - 1] + 0.5 *
+                                 (node.density[j - 1] + node.density[j]) *
+                                 (node.u[j] - node.u[j - 1]);
+    }
+    const double norm = node.cdf[n_intervals];
+    if (!(norm > 0.)) {
+      continue;
+    }
+    for (int j = 0; j <= n_intervals; j++) {
+      node.density[j] /= norm;
+      node.cdf[j] /= norm;
+    }
+    node.cdf[n_intervals] = 1.;
+    node.guide.resize(n_intervals);
+    std::uint32_t j = 0;
+    for (int k = 0; k < n_intervals; k++) {
+      const double p = static_cast<double>(k) / n_intervals;
+      while (j + 1 < static_cast<std::uint32_t>(n_intervals) &&
+             node.cdf[j + 1] <= p) {
+        j++;
+      }
+      node.guide[k] = j;
+    }
+    table->nodes[i] = std::move(node);
+  }
+  logg[LResonances].debug("Tabulated mass sampling of ", name(),
+                          " with partner mass ", mass_stable, " and L = ", L,
+                          " at ", n_nodes, " sqrt(s) values");
+  return table;
+}
+
+double ParticleType::sample_tabulated_mass(const MassSamplingTable &table,
+                                           double max_mass) const {
+  const double x = mass_sampling_grid_position(table, max_mass);
+  if (!(x >= 0.) || x >= table.nodes.size() - 1) {
+    return -1.;
+  }
+  /* Choose one of the neighboring grid points with the probability of the
+   * linear interpolation in sqrt(s). */
+  std::size_t i = static_cast<std::size_t>(x);
+  if (random::uniform(0., 1.) < x - i) {
+    i++;
+  }
+  const MassSamplingTable::Node &node = table.nodes[i];
+  if (node.guide.empty()) {
+    return -1.;
+  }
+  // Find the mass interval, starting at the guide table
+  const std::size_t n_intervals = node.guide.size();
+  const double r = random::uniform(0., 1.);
+  std::size_t j = node.guide[std::min(
+      static_cast<std::size_t>(r * n_intervals), n_intervals - 1)];
+  while (j + 1 < n_intervals && node.cdf[j + 1] < r) {
+    j++;
+  }
+  /* Invert the cumulative distribution of the linearly interpolated density
+   * within the interval, solving a x^2 + b x + c = 0 for x in [0, 1]. */
+  const double du = node.u[j + 1] - node.u[j];
+  const double a = 0.5 * (node.density[j + 1] - node.density[j]);
+  const double b = node.density[j];
+  const double c = du > 0. ? (node.cdf[j] - r) / du : 0.;
+  double f;
+  if (std::abs(a) > really_small * b) {
+    f = (std::sqrt(std::max(b * b - 4. * a * c, 0.)) - b) / (2. * a);
+  } else {
+    f = b > 0. ? -c / b : 0.5;
+  }
+  const double u = node.u[j] + std::min(std::max(f, 0.), 1.) * du;
+
+  const double half_width = width_at_pole() / 2.;
+  const double t_max = std::atan((max_mass - mass()) / half_width);
+  const double t = table.t_min + u * (t_max - table.t_min);
+  const double m = mass() + half_width * std::tan(t);
+  return std::min(std::max(m, table.m_min), max_mass);
+}
+
 /* Resonance mass sampling for 2-particle final state */
 double ParticleType::sample_resonance_mass(const double mass_stable,
                                            const double cms_energy,
@@ -601,6 +1141,14 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
    * physical limit by numerical error. */
   const double max_mass = std::nextafter(cms_energy - mass_stable, 0.);
 
+  if (mass_sampling_sqrts_step > 0. && !is_stable()) {
+    const auto table = mass_sampling_table(mass_stable, L);
+    const double mass_res = sample_tabulated_mass(*table, max_mass);
+    if (mass_res >= 0.) {
+      return mass_res;
+    }
+  }
+
   // smallest possible mass to find non-zero spectral function contributions
   const double min_mass = this->min_mass_spectral();
 
@@ -616,10 +1164,11 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
       std::max(1., this->spectral_function(max_mass) /
                        this->spectral_function_simple(max_mass));
 
+  double &max_factor = max_factor1();
   double mass_res, val;
   // outer loop: repeat if maximum is too small
   do {
-    const double q_max = sf_ratio_max * this->max_factor1_;
+    const double q_max = sf_ratio_max * max_factor;
     const double max = blw_max * q_max;  // maximum value for rejection sampling
     // inner loop: rejection sampling
     do {
@@ -639,9 +1188,9 @@ double ParticleType::sample_resonance_mass(const double mass_stable,
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_mass: ",
-          this->max_factor1_, " ", val / max, " ", this->pdgcode(), " ",
-          mass_stable, " ", cms_energy, " ", mass_res);
-      this->max_factor1_ *= val / max;
+          max_factor, " ", val / max, " ", this->pdgcode(), " ", mass_stable,
+          " ", cms_energy, " ", mass_res);
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -665,11 +1214,12 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
       pCM(cms_energy, t1.min_mass_spectral(), t2.min_mass_spectral());
   const double blw_max = pcm_max * blatt_weisskopf_sqr(pcm_max, L);
 
+  double &max_factor = t1.max_factor2();
   double mass_1, mass_2, val;
   // outer loop: repeat if maximum is too small
   do {
     // maximum value for rejection sampling (determined automatically)
-    const double max = blw_max * t1.max_factor2_;
+    const double max = blw_max * max_factor;
     // inner loop: rejection sampling
     do {
       // sample mass from a simple Breit-Wigner (aka Cauchy) distribution
@@ -691,9 +1241,9 @@ std::pair<double, double> ParticleType::sample_resonance_masses(
     if (val > max) {
       logg[LResonances].debug(
           "maximum is being increased in sample_resonance_masses: ",
-          t1.max_factor2_, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
+          max_factor, " ", val / max, " ", t1.pdgcode(), " ", t2.pdgcode(),
           " ", cms_energy, " ", mass_1, " ", mass_2);
-      t1.max_factor2_ *= val / max;
+      max_factor *= val / max;
     } else {
       break;  // maximum ok, exit loop
     }
@@ -8,6 +8,11 @@
  */
 
 #include "smash/pauliblocking.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
 #include "smash/constants.h"
 #include "smash/logging.h"
 
@@ -66,54 +71,226 @@ PauliBlocker::PauliBlocker(Configuration conf,
 
 PauliBlocker::~PauliBlocker() {}
 
-double PauliBlocker::phasespace_dens(const ThreeVector &r, const ThreeVector &p,
-                                     const std::vector<Particles> &ensembles,
-                                     const PdgCode pdg,
-                                     const ParticleList &disregard) const {
+double PauliBlocker::phasespace_weight(const ParticleData &part,
+                                       const ThreeVector &r,
+                                       const ThreeVector &p, const PdgCode pdg,
+                                       const ParticleList &disregard) const {
+  // Only consider identical particles
+  if (part.pdgcode() != pdg) {
+    return 0.0;
+  }
+  // Only consider momenta in sphere of radius rp_ with center at p
+  const double pdist_sqr = (part.momentum().threevec() - p).sqr();
+  if (pdist_sqr > rp_ * rp_) {
+    return 0.0;
+  }
+  const double rdist_sqr = (part.position().threevec() - r).sqr();
+  // Only consider coordinates in sphere of radius rr_+rc_ with center at r
+  if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
+    return 0.0;
+  }
+  // Do not count particles that should be disregarded.
+  for (const auto &disregard_part : disregard) {
+    if (part.id() == disregard_part.id()) {
+      return 0.0;
+    }
+  }
+  // 1st order interpolation using tabulated values
+  const double i_real = std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
+  const size_t i = std::floor(i_real);
+  const double rest = i_real - i;
+  if (likely(i + 1 < weights_.size())) {
+    return weights_[i] * rest + weights_[i + 1] * (1. - rest);
+  }
+  return 0.0;
+}
+
+template <typename ParticleContainer>
+double PauliBlocker::phasespace_weight_sum(const ThreeVector &r,
+                                           const ThreeVector &p,
+                                           const ParticleContainer &particles,
+                                           const PdgCode pdg,
+                                           const ParticleList &disregard) const {
   double f = 0.0;
+  for (const ParticleData &part : particles) {
+    f += phasespace_weight(part, r, p, pdg, disregard);
+  }
+  return f;
+}
 
-  /* TODO(oliiny): looping over all particles is inefficient,
-   * I need only particles within rp_ radius in momentum and
-   * within rr_+rc_ in coordinate space. Some search algorithm might help. */
-  for (const Particles &particles : ensembles) {
-    for (const ParticleData &part : particles) {
-      // Only consider identical particles
-      if (part.pdgcode() != pdg) {
-        continue;
-      }
-      // Only consider momenta in sphere of radius rp_ with center at p
-      const double pdist_sqr = (part.momentum().threevec() - p).sqr();
-      if (pdist_sqr > rp_ * rp_) {
-        continue;
+PauliBlocker::CellKey PauliBlocker::cell_of(const PdgCode pdg,
+                                            const ThreeVector &r) const {
+  const double cell_length = rr_ + rc_;
+  return {pdg.code(), static_cast<int>(std::floor(r.x1() / cell_length)),
+          static_cast<int>(std::floor(r.x2() / cell_length)),
+          static_cast<int>(std::floor(r.x3() / cell_length))};
+}
+
+void PauliBlocker::add_to_index(const ParticleData &part,
+                                EnsembleIndex *index) const {
+  const CellKey key = cell_of(part.pdgcode(), part.position().threevec());
+  index->cells[key].push_back(part);
+  index->cell_of_id[part.id()] = key;
+}
+
+template <typename CurrentState>
+double PauliBlocker::indexed_weight_sum(
+    const ThreeVector &r, const ThreeVector &p, const EnsembleIndex &index,
+    double reach, const PdgCode pdg, const ParticleList &disregard,
+    const CurrentState &current_state) const {
+  double f = 0.0;
+  auto add_cell = [&](const ParticleList &cell) {
+    for (const ParticleData &entry : cell) {
+      const ParticleData *part = current_state(entry);
+      if (part) {
+        f += phasespace_weight(*part, r, p, pdg, disregard);
       }
-      const double rdist_sqr = (part.position().threevec() - r).sqr();
-      // Only consider coordinates in sphere of radius rr_+rc_ with center at r
-      if (rdist_sqr >= (rr_ + rc_) * (rr_ + rc_)) {
-        continue;
+    }
+  };
+  const ThreeVector offset(reach, reach, reach);
+  const CellKey low = cell_of(pdg, r - offset);
+  const CellKey high = cell_of(pdg, r + offset);
+  const double n_cells_in_reach = static_cast<double>(high.x - low.x + 1) *
+                                  (high.y - low.y + 1) * (high.z - low.z + 1);
+  if (n_cells_in_reach > index.cells.size()) {
+    // Visiting the occupied cells is cheaper than looking up all cells in reach
+    for (const auto &cell : index.cells) {
+      const CellKey &key = cell.first;
+      if (key.pdg == low.pdg && key.x >= low.x && key.x <= high.x &&
+          key.y >= low.y && key.y <= high.y && key.z >= low.z &&
+          key.z <= high.z) {
+        add_cell(cell.second);
       }
-      // Do not count particles that should be disregarded.
-      bool to_disregard = false;
-      for (const auto &disregard_part : disregard) {
-        if (part.id() == disregard_part.id()) {
-          to_disregard = true;
+    }
+    return f;
+  }
+  CellKey key = low;
+  for (key.x = low.x; key.x <= high.x; key.x++) {
+    for (key.y = low.y; key.y <= high.y; key.y++) {
+      for (key.z = low.z; key.z <= high.z; key.z++) {
+        const auto cell = index.cells.find(key);
+        if (cell != index.cells.end()) {
+          add_cell(cell->second);
         }
       }
-      if (to_disregard) {
-        continue;
-      }
-      // 1st order interpolation using tabulated values
-      const double i_real =
-          std::sqrt(rdist_sqr) / (rr_ + rc_) * weights_.size();
-      const size_t i = std::floor(i_real);
-      const double rest = i_real - i;
-      if (likely(i + 1 < weights_.size())) {
-        f += weights_[i] * rest + weights_[i + 1] * (1. - rest);
-      }
-    }  // loop over particles in one ensemble
-  }    // loop over ensembles
+    }
+  }
+  return f;
+}
+
+double PauliBlocker::indexed_weight_sum(const ThreeVector &r,
+                                        const ThreeVector &p,
+                                        const Particles &particles,
+                                        const EnsembleIndex &index,
+                                        const PdgCode pdg,
+                                        const ParticleList &disregard) const {
+  /* The particles have moved by at most max_drift_ since they were sorted
+   * into their cells, so the cells within the larger reach have to be
+   * searched. The current state of the particles is used for the weights. */
+  return indexed_weight_sum(
+      r, p, index, rr_ + rc_ + max_drift_, pdg, disregard,
+      [&particles](const ParticleData &entry) -> const ParticleData * {
+        return particles.is_valid(entry) ? &particles.lookup(entry) : nullptr;
+      });
+}
+
+double PauliBlocker::phasespace_dens(const ThreeVector &r, const ThreeVector &p,
+                                     const std::vector<Particles> &ensembles,
+                                     const PdgCode pdg,
+                                     const ParticleList &disregard) const {
+  double f = 0.0;
+  const bool indexed = index_.size() == ensembles.size();
+  for (size_t i_ens = 0; i_ens < ensembles.size(); i_ens++) {
+    f += indexed ? indexed_weight_sum(r, p, ensembles[i_ens], index_[i_ens],
+                                      pdg, disregard)
+                 : phasespace_weight_sum(r, p, ensembles[i_ens], pdg,
+                                         disregard);
+  }
+  return f / ntest_ / n_ensembles_;
+}
+
+double PauliBlocker::phasespace_dens(
+    const ThreeVector &r, const ThreeVector &p, const Particles &own_ensemble,
+    int i_own_ensemble, const std::vector<ParticleList> &frozen_ensembles,
+    const PdgCode pdg, const ParticleList &disregard) const {
+  double f = 0.0;
+  const int n_frozen = frozen_ensembles.size();
+  const bool indexed = static_cast<int>(index_.size()) == n_frozen;
+  const bool frozen_indexed =
+      static_cast<int>(frozen_index_.size()) == n_frozen;
+  for (int i_ens = 0; i_ens < n_frozen; i_ens++) {
+    if (i_ens == i_own_ensemble) {
+      f += indexed ? indexed_weight_sum(r, p, own_ensemble, index_[i_ens], pdg,
+                                        disregard)
+                   : phasespace_weight_sum(r, p, own_ensemble, pdg, disregard);
+    } else if (frozen_indexed) {
+      // The frozen state does not move, the entries are the particles.
+      f += indexed_weight_sum(
+          r, p, frozen_index_[i_ens], rr_ + rc_, pdg, disregard,
+          [](const ParticleData &entry) { return &entry; });
+    } else {
+      f += phasespace_weight_sum(r, p, frozen_ensembles[i_ens], pdg, disregard);
+    }
+  }
   return f / ntest_ / n_ensembles_;
 }
 
+void PauliBlocker::build_index(const std::vector<Particles> &ensembles,
+                               double max_drift) {
+  index_.assign(ensembles.size(), EnsembleIndex());
+  for (size_t i_ens = 0; i_ens < ensembles.size(); i_ens++) {
+    for (const ParticleData &part : ensembles[i_ens]) {
+      add_to_index(part, &index_[i_ens]);
+    }
+  }
+  // Small margin against rounding in the propagation
+  max_drift_ = max_drift + really_small;
+}
+
+void PauliBlocker::build_frozen_index(
+    const std::vector<ParticleList> &frozen_ensembles) {
+  frozen_index_.assign(frozen_ensembles.size(), EnsembleIndex());
+  for (size_t i_ens = 0; i_ens < frozen_ensembles.size(); i_ens++) {
+    for (const ParticleData &part : frozen_ensembles[i_ens]) {
+      add_to_index(part, &frozen_index_[i_ens]);
+    }
+  }
+}
+
+void PauliBlocker::update_index(int i_ensemble, const ParticleList &removed,
+                                const ParticleList &added) {
+  if (index_.empty()) {
+    return;
+  }
+  EnsembleIndex &index = index_[i_ensemble];
+  for (const ParticleData &part : removed) {
+    const auto found = index.cell_of_id.find(part.id());
+    if (found == index.cell_of_id.end()) {
+      continue;
+    }
+    const auto cell = index.cells.find(found->second);
+    ParticleList &entries = cell->second;
+    const auto entry = std::find_if(
+        entries.begin(), entries.end(),
+        [&part](const ParticleData &e) { return e.id() == part.id(); });
+    assert(entry != entries.end());
+    *entry = entries.back();
+    entries.pop_back();
+    if (entries.empty()) {
+      index.cells.erase(cell);
+    }
+    index.cell_of_id.erase(found);
+  }
+  for (const ParticleData &part : added) {
+    add_to_index(part, &index);
+  }
+}
+
+void PauliBlocker::clear_index() {
+  index_.clear();
+  frozen_index_.clear();
+}
+
 void PauliBlocker::init_weights_analytical() {
   const double pi = M_PI;
   const double sqrt2 = std::sqrt(2.);
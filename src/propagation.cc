@@ -9,8 +9,16 @@
 
 #include "smash/propagation.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
+#include "smash/cxx14compat.h"
 #include "smash/listmodus.h"
 #include "smash/logging.h"
 #include "smash/spheremodus.h"
@@ -108,19 +116,111 @@ void expand_space_time(Particles *particles,
   }
 }
 
+namespace {
+/**
+ * Baryons and nuclei of all ensembles, sorted into cubic cells whose length
+ * is the cutoff radius of the Gaussian smearing. Only these particles
+ * contribute to the baryon and isospin densities, and only the ones in the
+ * cells around a point can be closer to it than the cutoff radius.
+ */
+class BaryonCells {
+ public:
+  /**
+   * Sort the baryons and nuclei into cells.
+   *
+   * \param[in] ensembles The particles of all ensembles. They must not be
+   *                      changed as long as this object is used.
+   * \param[in] r_cut Cutoff radius of the smearing [fm].
+   */
+  BaryonCells(const std::vector<Particles> &ensembles, double r_cut)
+      : r_cut_(r_cut) {
+    for (const Particles &particles : ensembles) {
+      for (const ParticleData &data : particles) {
+        if (data.type().baryon_number() == 0) {
+          continue;
+        }
+        const ThreeVector r = data.position().threevec();
+        cells_[cell_key(cell_index(r.x1()), cell_index(r.x2()),
+                        cell_index(r.x3()))]
+            .push_back(particles_.size());
+        particles_.push_back(&data);
+      }
+    }
+  }
+
+  /**
+   * Copy all baryons and nuclei within the cells around r, which include all
+   * particles closer to r than the cutoff radius. They are kept in the order
+   * of the ensembles, such that the densities are summed up in the same
+   * order as for the full list of particles.
+   *
+   * \param[in] r Point, at which the densities are needed.
+   * \param[out] neighbours The copies of the particles.
+   */
+  void collect_neighbours(const ThreeVector &r, ParticleList *neighbours) {
+    candidates_.clear();
+    // Small margin against rounding in the distance
+    const double reach = r_cut_ + really_small;
+    const int x_low = cell_index(r.x1() - reach),
+              x_high = cell_index(r.x1() + reach);
+    const int y_low = cell_index(r.x2() - reach),
+              y_high = cell_index(r.x2() + reach);
+    const int z_low = cell_index(r.x3() - reach),
+              z_high = cell_index(r.x3() + reach);
+    for (int x = x_low; x <= x_high; x++) {
+      for (int y = y_low; y <= y_high; y++) {
+        for (int z = z_low; z <= z_high; z++) {
+          const auto cell = cells_.find(cell_key(x, y, z));
+          if (cell != cells_.end()) {
+            candidates_.insert(candidates_.end(), cell->second.begin(),
+                               cell->second.end());
+          }
+        }
+      }
+    }
+    std::sort(candidates_.begin(), candidates_.end());
+    neighbours->clear();
+    for (const size_t i : candidates_) {
+      neighbours->push_back(*particles_[i]);
+    }
+  }
+
+ private:
+  /**
+   * \param[in] x Coordinate [fm].
+   * \return Index of the cell containing the coordinate.
+   */
+  int cell_index(double x) const {
+    return static_cast<int>(std::floor(x / r_cut_));
+  }
+
+  /**
+   * \param[in] x,y,z Cell indices.
+   * \return Key of the cell, unique for realistic system sizes.
+   */
+  static std::uint64_t cell_key(int x, int y, int z) {
+    constexpr std::uint64_t mask = (1u << 21) - 1;
+    return ((static_cast<std::uint64_t>(x) & mask) << 42) |
+           ((static_cast<std::uint64_t>(y) & mask) << 21) |
+           (static_cast<std::uint64_t>(z) & mask);
+  }
+
+  /// Cutoff radius of the smearing and length of the cells [fm]
+  const double r_cut_;
+  /// The baryons and nuclei in the order of the ensembles
+  std::vector<const ParticleData *> particles_;
+  /// Indices in particles_ of the particles in every non-empty cell
+  std::unordered_map<std::uint64_t, std::vector<size_t>> cells_;
+  /// Indices of the particles in the cells around the last requested point
+  std::vector<size_t> candidates_;
+};
+}  // unnamed namespace
+
 void update_momenta(
     std::vector<Particles> &ensembles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *EM_lat) {
-  // Copy particles from ALL ensembles to a single list before propagation
-  // and calculate potentials from this list
-  ParticleList plist;
-  for (Particles &particles : ensembles) {
-    const ParticleList tmp = particles.copy_to_vector();
-    plist.insert(plist.end(), tmp.begin(), tmp.end());
-  }
-
   bool possibly_use_lattice =
       (pot.use_skyrme() ? (FB_lat != nullptr) : true) &&
       (pot.use_vdf() ? (FB_lat != nullptr) : true) &&
@@ -128,14 +228,23 @@ void update_momenta(
   std::pair<ThreeVector, ThreeVector> FB, FI3, EM_fields;
   double min_time_scale = std::numeric_limits<double>::infinity();
 
-  for (Particles &particles : ensembles) {
-    for (ParticleData &data : particles) {
+  /* The forces are calculated from the particles before any momentum is
+   * updated. Densities without lattice only get contributions from the
+   * baryons around the point, which are looked up in cells that are only
+   * built if needed. */
+  std::unique_ptr<BaryonCells> baryon_cells;
+  ParticleList neighbours;
+  std::vector<ThreeVector> forces;
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &data : particles) {
+      const ParticleType &type = data.type();
       // Only baryons and nuclei will be affected by the potentials
       if (!(data.is_baryon() || data.is_nucleus())) {
         continue;
       }
-      const auto scale = pot.force_scale(data.type());
+      const auto scale = pot.force_scale(type);
       const ThreeVector r = data.position().threevec();
+      const ThreeVector velocity = data.momentum().velocity();
       /* Lattices can be used for calculation if 1-2 are fulfilled:
        * 1) Required lattices are not nullptr - possibly_use_lattice
        * 2) r is not out of required lattices */
@@ -151,24 +260,37 @@ void update_momenta(
         FI3 = std::make_pair(ThreeVector(0., 0., 0.), ThreeVector(0., 0., 0.));
       }
       if (!use_lattice) {
-        const auto tmp = pot.all_forces(r, plist);
+        if (!baryon_cells) {
+          baryon_cells = make_unique<BaryonCells>(
+              ensembles, pot.density_parameters().r_cut());
+        }
+        baryon_cells->collect_neighbours(r, &neighbours);
+        const auto tmp = pot.all_forces(r, neighbours);
         FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
         FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
       }
       ThreeVector Force =
-          scale.first *
-              (FB.first + data.momentum().velocity().cross_product(FB.second)) +
-          scale.second * data.type().isospin3_rel() *
-              (FI3.first +
-               data.momentum().velocity().cross_product(FI3.second));
+          scale.first * (FB.first + velocity.cross_product(FB.second)) +
+          scale.second * type.isospin3_rel() *
+              (FI3.first + velocity.cross_product(FI3.second));
       // Potentially add Lorentz force
       if (pot.use_coulomb() && EM_lat->value_at(r, EM_fields)) {
         // factor hbar*c to convert fields from 1/fm^2 to GeV/fm
-        Force += hbarc * data.type().charge() * elementary_charge *
-                 (EM_fields.first +
-                  data.momentum().velocity().cross_product(EM_fields.second));
+        Force += hbarc * type.charge() * elementary_charge *
+                 (EM_fields.first + velocity.cross_product(EM_fields.second));
       }
       logg[LPropagation].debug("Update momenta: F [GeV/fm] = ", Force);
+      forces.push_back(Force);
+    }
+  }
+
+  auto force = forces.cbegin();
+  for (Particles &particles : ensembles) {
+    for (ParticleData &data : particles) {
+      if (!(data.is_baryon() || data.is_nucleus())) {
+        continue;
+      }
+      const ThreeVector &Force = *(force++);
       data.set_4momentum(data.effective_mass(),
                          data.momentum().threevec() + Force * dt);
 
@@ -10,6 +10,7 @@
 #include "smash/scatteraction.h"
 
 #include <cmath>
+#include <mutex>
 
 #include "Pythia8/Pythia.h"
 
@@ -490,6 +491,8 @@ void ScatterAction::string_excitation() {
   // Disable floating point exception trap for Pythia
   {
     DisableFloatTraps guard;
+    // The PYTHIA objects are shared between concurrently evolved ensembles
+    std::lock_guard<std::mutex> lock(string_process_->mutex());
     /* initialize the string_process_ object for this particular collision */
     string_process_->init(incoming_particles_, time_of_execution_);
     /* implement collision */
@@ -11,6 +11,7 @@
 
 #include <gsl/gsl_sf_ellint.h>
 
+#include <cstdlib>
 #include <map>
 
 #include "smash/crosssections.h"
@@ -604,6 +605,30 @@ void ScatterActionMulti::n_to_two() {
                                   " -> ", outgoing_particles_);
 }
 
+bool ScatterActionMulti::can_be_incoming(
+    PdgCode pdg, std::size_t n_incoming,
+    const MultiParticleReactionsBitSet incl_multi) {
+  switch (n_incoming) {
+    case 3:
+      // 3pi -> omega/phi, eta2pi -> eta-prime and piNN, NNN -> (pi/N)d
+      return (incl_multi[IncludedMultiParticleReactions::Meson_3to1] == 1 &&
+              (pdg.is_pion() || pdg == pdg::eta)) ||
+             (incl_multi[IncludedMultiParticleReactions::Deuteron_3to2] == 1 &&
+              (pdg.is_pion() || pdg.is_nucleon()));
+    case 4:
+      // components of the nuclei and catalysts
+      return incl_multi[IncludedMultiParticleReactions::A3_Nuclei_4to2] == 1 &&
+             (pdg.is_pion() || pdg.is_nucleon() ||
+              std::abs(pdg.code()) == pdg::Lambda);
+    case 5:
+      // at the moment only pure pion 5-body reactions
+      return incl_multi[IncludedMultiParticleReactions::NNbar_5to2] == 1 &&
+             pdg.is_pion();
+    default:
+      return false;
+  }
+}
+
 bool ScatterActionMulti::three_different_pions(
     const ParticleData& data_a, const ParticleData& data_b,
     const ParticleData& data_c) const {
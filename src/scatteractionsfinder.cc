@@ -10,13 +10,16 @@
 #include "smash/scatteractionsfinder.h"
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <vector>
 
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
+#include "smash/kinematics.h"
 #include "smash/logging.h"
+#include "smash/potential_globals.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionmulti.h"
 #include "smash/scatteractionphoton.h"
@@ -227,6 +230,19 @@ static constexpr int LFindScatter = LogArea::FindScatter::id;
          Popcorn_Rate: 0.15
   \endverbatim
  *
+ * **Caching the Pythia initialization**\n
+ *
+ * The Pythia objects for hard string processes are initialized at the
+ * collision energy rounded up to a power of two. The initialization of their
+ * multiparton interactions is cached per pair of beam particles, energy and
+ * string parameters in the tabulations directory, unless \key --no-cache is
+ * used. The cache can be filled in advance for all hadron pairs up to a given
+ * \f$\sqrt{s}\f$ by running
+ *\verbatim
+ ./smash --pythia-init 200
+ \endverbatim
+ * with the same configuration as the later runs.
+ *
  *
  * \page collision_criterion Collision_Criterion
  * \key "Geometric" - Geometric collision criterion \n
@@ -403,6 +419,14 @@ ScatterActionsFinder::ScatterActionsFinder(
         subconfig.take({"Separate_Fragment_Baryon"}, true),
         subconfig.take({"Popcorn_Rate"}, 0.15));
   }
+
+  if (coll_crit_ != CollisionCriterion::Stochastic) {
+    xs_bound_table_ = make_unique<TotalCrossSectionTable>(
+        [this](const ParticleType& type_a, const ParticleType& type_b,
+               double sqrts) {
+          return pole_mass_cross_section(type_a, type_b, sqrts);
+        });
+  }
 }
 
 ActionPtr ScatterActionsFinder::check_collision_two_part(
@@ -471,6 +495,22 @@ ActionPtr ScatterActionsFinder::check_collision_two_part(
     return nullptr;
   }
 
+  /* Reject the pair early if even an upper bound of its cross section is too
+   * small. The bounds are sampled, so they do not cover pairs forming
+   * resonances narrower than about 4 MeV, and are only valid as long as the
+   * cross sections do not depend on the potentials. */
+  if (xs_bound_table_ && pot_pointer == nullptr) {
+    const double xs_bound =
+        xs_bound_table_->upper_bound(data_a.type(), data_b.type(),
+                                     act->sqrt_s()) *
+        fm2_mb / static_cast<double>(testparticles_) *
+        data_a.xsec_scaling_factor(time_until_collision) *
+        data_b.xsec_scaling_factor(time_until_collision);
+    if (distance_squared >= xs_bound * M_1_PI) {
+      return nullptr;
+    }
+  }
+
   // Add various subprocesses.
   act->add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
                            incl_multi_set_, low_snn_cut_, strings_switch_,
@@ -613,6 +653,71 @@ ActionPtr ScatterActionsFinder::check_collision_multi_part(
   return std::move(act);
 }
 
+double ScatterActionsFinder::pole_mass_cross_section(
+    const ParticleType& type_a, const ParticleType& type_b,
+    double sqrts) const {
+  const double m_a = type_a.mass(), m_b = type_b.mass();
+  const double momentum = pCM(sqrts, m_a, m_b);
+  ParticleData a_data(type_a), b_data(type_b);
+  a_data.set_4momentum(m_a, 0.0, 0.0, momentum);
+  b_data.set_4momentum(m_b, 0.0, 0.0, -momentum);
+  ScatterActionPtr act = make_unique<ScatterAction>(
+      a_data, b_data, 0., isotropic_, string_formation_time_);
+  if (strings_switch_) {
+    act->set_string_interface(string_process_interface_.get());
+  }
+  act->add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                           incl_multi_set_, low_snn_cut_, strings_switch_,
+                           use_AQM_, strings_with_probability_,
+                           nnbar_treatment_, scale_xs_, additional_el_xs_);
+  return act->cross_section();
+}
+
+namespace {
+/**
+ * Calls a function for every combination of \p k of the given particles. The
+ * particles keep their order within the combinations.
+ *
+ * \param[in] candidates The particles to be combined.
+ * \param[in] k Number of particles in a combination.
+ * \param[in] f Function to be called with every combination.
+ */
+void for_each_combination(
+    const std::vector<const ParticleData*>& candidates, std::size_t k,
+    const std::function<void(const ParticleList&)>& f) {
+  const std::size_t n = candidates.size();
+  if (k == 0 || k > n) {
+    return;
+  }
+  // the indices of the particles in the current combination, increasing
+  std::vector<std::size_t> index(k);
+  for (std::size_t j = 0; j < k; j++) {
+    index[j] = j;
+  }
+  ParticleList combination;
+  combination.reserve(k);
+  while (true) {
+    combination.clear();
+    for (const std::size_t i : index) {
+      combination.push_back(*candidates[i]);
+    }
+    f(combination);
+    // find the last index which can still be increased
+    std::size_t j = k;
+    while (j > 0 && index[j - 1] == n - k + j - 1) {
+      j--;
+    }
+    if (j == 0) {
+      return;
+    }
+    index[j - 1]++;
+    for (; j < k; j++) {
+      index[j] = index[j - 1] + 1;
+    }
+  }
+}
+}  // unnamed namespace
+
 ActionList ScatterActionsFinder::find_actions_in_cell(
     const ParticleList& search_list, double dt, const double gcell_vol,
     const std::vector<FourVector>& beam_momentum) const {
@@ -627,52 +732,33 @@ ActionList ScatterActionsFinder::find_actions_in_cell(
           actions.push_back(std::move(act));
         }
       }
-      if (incl_multi_set_.any()) {
-        // Also, check for 3 particle scatterings with stochastic criterion
-        for (const ParticleData& p3 : search_list) {
-          if (incl_multi_set_[IncludedMultiParticleReactions::Deuteron_3to2] ==
-                  1 ||
-              incl_multi_set_[IncludedMultiParticleReactions::Meson_3to1] ==
-                  1) {
-            if (p1.id() < p2.id() && p2.id() < p3.id()) {
-              ActionPtr act =
-                  check_collision_multi_part({p1, p2, p3}, dt, gcell_vol);
-              if (act) {
-                actions.push_back(std::move(act));
-              }
-            }
-          }
-          for (const ParticleData& p4 : search_list) {
-            if (incl_multi_set_
-                    [IncludedMultiParticleReactions::A3_Nuclei_4to2]) {
-              if (p1.id() < p2.id() && p2.id() < p3.id() && p3.id() < p4.id()) {
-                ActionPtr act =
-                    check_collision_multi_part({p1, p2, p3, p4}, dt, gcell_vol);
-                if (act) {
-                  actions.push_back(std::move(act));
-                }
-              }
-            }
-            if (incl_multi_set_[IncludedMultiParticleReactions::NNbar_5to2] ==
-                    1 &&
-                search_list.size() >= 5) {
-              for (const ParticleData& p5 : search_list) {
-                if ((p1.id() < p2.id() && p2.id() < p3.id() &&
-                     p3.id() < p4.id() && p4.id() < p5.id()) &&
-                    (p1.is_pion() && p2.is_pion() && p3.is_pion() &&
-                     p4.is_pion() && p5.is_pion())) {
-                  // at the moment only pure pion 5-body reactions
-                  ActionPtr act = check_collision_multi_part(
-                      {p1, p2, p3, p4, p5}, dt, gcell_vol);
-                  if (act) {
-                    actions.push_back(std::move(act));
-                  }
-                }
-              }
-            }
-          }
+    }
+  }
+  if (incl_multi_set_.any()) {
+    /* Also, check for 3, 4 and 5 particle scatterings with stochastic
+     * criterion. Only the particles that can take part in the enabled
+     * reactions are combined, each combination once and ordered by id. */
+    std::vector<const ParticleData*> candidates;
+    for (std::size_t n_incoming = 3; n_incoming <= 5; n_incoming++) {
+      candidates.clear();
+      for (const ParticleData& p : search_list) {
+        if (ScatterActionMulti::can_be_incoming(p.pdgcode(), n_incoming,
+                                                incl_multi_set_)) {
+          candidates.push_back(&p);
         }
       }
+      std::sort(candidates.begin(), candidates.end(),
+                [](const ParticleData* a, const ParticleData* b) {
+                  return a->id() < b->id();
+                });
+      for_each_combination(
+          candidates, n_incoming, [&](const ParticleList& incoming) {
+            ActionPtr act =
+                check_collision_multi_part(incoming, dt, gcell_vol);
+            if (act) {
+              actions.push_back(std::move(act));
+            }
+          });
     }
   }
   return actions;
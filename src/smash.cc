@@ -170,6 +170,14 @@ void usage(const int rc, const std::string &progname) {
       "                          This format is used in MUSIC and CLVisc\n"
       "                          relativistic hydro codes\n"
       "  -q, --quiet             Supress disclaimer print-out\n"
+      "  -P, --pythia-init <sqrts>\n"
+      "                          initialize Pythia for hard string processes "
+      "of all\n"
+      "                          hadron pairs up to sqrt(s) [GeV] and cache "
+      "it on disk\n"
+      "  -t, --tabulate-only     only tabulate the resonance integrals and "
+      "cache them\n"
+      "                          on disk\n"
       "  -n, --no-cache          Don't cache integrals on disk\n"
       "  -v, --version\n\n");
   std::exit(rc);
@@ -405,6 +413,8 @@ int main(int argc, char *argv[]) {
       {"version", no_argument, 0, 'v'},
       {"no-cache", no_argument, 0, 'n'},
       {"quiet", no_argument, 0, 'q'},
+      {"pythia-init", required_argument, 0, 'P'},
+      {"tabulate-only", no_argument, 0, 't'},
       {nullptr, 0, 0, 0}};
 
   // strip any path to progname
@@ -416,18 +426,19 @@ int main(int argc, char *argv[]) {
     std::string input_path("./config.yaml"), particles, decaymodes;
     std::vector<std::string> extra_config;
     char *modus = nullptr, *end_time = nullptr, *pdg_string = nullptr,
-         *cs_string = nullptr;
+         *cs_string = nullptr, *pythia_init_sqrts = nullptr;
     bool list2n_activated = false;
     bool resonance_dump_activated = false;
     bool cross_section_dump_activated = false;
     bool final_state_cross_sections = false;
     bool particles_dump_iSS_format = false;
     bool cache_integrals = true;
+    bool tabulate_only = false;
     bool suppress_disclaimer = false;
 
     // parse command-line arguments
     int opt;
-    while ((opt = getopt_long(argc, argv, "c:d:e:fhi:m:p:o:lr:s:S:xvnq",
+    while ((opt = getopt_long(argc, argv, "c:d:e:fhi:m:p:o:lr:s:S:xvnqP:t",
                               longopts, nullptr)) != -1) {
       switch (opt) {
         case 'c':
@@ -499,6 +510,12 @@ int main(int argc, char *argv[]) {
         case 'q':
           suppress_disclaimer = true;
           break;
+        case 'P':
+          pythia_init_sqrts = optarg;
+          break;
+        case 't':
+          tabulate_only = true;
+          break;
         default:
           usage(EXIT_FAILURE, progname);
       }
@@ -548,6 +565,38 @@ int main(int argc, char *argv[]) {
       scat_finder.dump_reactions();
       std::exit(EXIT_SUCCESS);
     }
+    if (tabulate_only) {
+      if (tabulations_path.empty()) {
+        throw std::invalid_argument(
+            "Tabulating in advance requires the cache on disk.");
+      }
+      initialize_particles_decays_and_tabulations(configuration, version,
+                                                  tabulations_path);
+      ignore_simulation_config_values(configuration);
+      check_for_unused_config_values(configuration);
+      std::exit(EXIT_SUCCESS);
+    }
+    if (pythia_init_sqrts) {
+      if (tabulations_path.empty()) {
+        throw std::invalid_argument(
+            "Initializing Pythia in advance requires the cache on disk.");
+      }
+      initialize_particles_decays_and_tabulations(configuration, version,
+                                                  tabulations_path);
+      auto scat_finder = actions_finder_for_dump(configuration);
+
+      ignore_simulation_config_values(configuration);
+      check_for_unused_config_values(configuration);
+
+      StringProcess *string_process = scat_finder.get_process_string_ptr();
+      if (!string_process) {
+        throw std::invalid_argument(
+            "Initializing Pythia in advance requires string processes.");
+      }
+      string_process->prepare_mpi_initialization(
+          std::stod(pythia_init_sqrts));
+      std::exit(EXIT_SUCCESS);
+    }
     if (particles_dump_iSS_format) {
       initialize_particles_decays_and_tabulations(configuration, version,
                                                   tabulations_path);
@@ -7,7 +7,17 @@
  *
  */
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
 
 #include "smash/angles.h"
 #include "smash/kinematics.h"
@@ -18,6 +28,13 @@
 namespace smash {
 static constexpr int LOutput = LogArea::Output::id;
 
+namespace {
+/// Directory where the MPI initializations are cached
+bf::path mpi_tabulations_dir;
+/// Hash of the particle properties, on which the MPI initializations depend
+sha256::Hash mpi_hash;
+}  // unnamed namespace
+
 StringProcess::StringProcess(
     double string_tension, double time_formation, double gluon_beta,
     double gluon_pmin, double quark_alpha, double quark_beta,
@@ -147,6 +164,116 @@ void StringProcess::common_setup_pythia(Pythia8::Pythia *pythia_in,
   pythia_in->readString("Check:epTolWarn = 1e-8");
 }
 
+void StringProcess::cache_mpi_initialization(
+    sha256::Hash hash, const bf::path &tabulations_path) {
+  mpi_tabulations_dir = tabulations_path;
+  mpi_hash = hash;
+}
+
+double StringProcess::mpi_init_energy(double sqrts) {
+  const double min_energy = 4.;
+  if (sqrts <= min_energy) {
+    return min_energy;
+  }
+  return std::exp2(std::ceil(std::log2(sqrts)));
+}
+
+std::unique_ptr<Pythia8::Pythia> StringProcess::create_hard_pythia(
+    const std::pair<int, int> &idAB, double sqrts) {
+  auto pythia = make_unique<Pythia8::Pythia>(PYTHIA_XML_DIR, false);
+  pythia->readString("SoftQCD:nonDiffractive = on");
+  pythia->readString("MultipartonInteractions:pTmin = 1.5");
+  pythia->readString("HadronLevel:all = off");
+
+  common_setup_pythia(pythia.get(), strange_supp_, diquark_supp_,
+                      popcorn_rate_, stringz_a_produce_, stringz_b_produce_,
+                      string_sigma_T_);
+
+  pythia->settings.flag("Beams:allowVariableEnergy", true);
+
+  const double init_energy = mpi_init_energy(sqrts);
+  pythia->settings.mode("Beams:idA", idAB.first);
+  pythia->settings.mode("Beams:idB", idAB.second);
+  pythia->settings.parm("Beams:eCM", init_energy);
+
+  /* Pythia writes the initialization file itself, so unlike the other cache
+   * files it cannot be saved with save_cache_file. A missing initialization
+   * is written to a temporary file instead, which replaces the cache file
+   * after Pythia has been initialized successfully, so that concurrent runs
+   * only ever read complete files. */
+  bf::path path;
+  std::string temporary_name;
+  if (!mpi_tabulations_dir.empty()) {
+    const double parameters[] = {PYTHIA_VERSION,     init_energy,
+                                 strange_supp_,      diquark_supp_,
+                                 popcorn_rate_,      stringz_a_produce_,
+                                 stringz_b_produce_, string_sigma_T_};
+    sha256::Context hash_context;
+    hash_context.update(mpi_hash.data(), mpi_hash.size());
+    hash_context.update(reinterpret_cast<const uint8_t *>(parameters),
+                        sizeof(parameters));
+    path = mpi_tabulations_dir /
+           ("mpi_" + std::to_string(idAB.first) + "_" +
+            std::to_string(idAB.second) + "_" +
+            sha256::hash_to_string(hash_context.finalize()) + ".dat");
+    logg[LPythia].debug("Multiparton interactions initialization file: ",
+                        path);
+    if (bf::exists(path)) {
+      // Read the stored initialization
+      pythia->settings.mode("MultipartonInteractions:reuseInit", 2);
+      pythia->settings.word("MultipartonInteractions:initFile", path.string());
+    } else {
+      // Initialize and store the initialization
+      std::ostringstream suffix;
+      suffix << ".tmp" << getpid() << "_" << std::this_thread::get_id();
+      temporary_name = path.string() + suffix.str();
+      pythia->settings.mode("MultipartonInteractions:reuseInit", 1);
+      pythia->settings.word("MultipartonInteractions:initFile",
+                            temporary_name);
+    }
+  }
+
+  logg[LPythia].debug("Pythia object initialized with ", idAB.first, " + ",
+                      idAB.second, " at CM energy [GeV] ", init_energy);
+
+  if (!pythia->init()) {
+    if (!temporary_name.empty()) {
+      std::remove(temporary_name.c_str());
+    }
+    throw std::runtime_error("Pythia failed to initialize.");
+  }
+  if (!temporary_name.empty() &&
+      std::rename(temporary_name.c_str(), path.string().c_str())) {
+    std::remove(temporary_name.c_str());
+  }
+  return pythia;
+}
+
+void StringProcess::prepare_mpi_initialization(double sqrts_max) {
+  if (mpi_tabulations_dir.empty()) {
+    throw std::runtime_error(
+        "Preparing the Pythia initialization requires a cache directory.");
+  }
+  std::set<int> beam_ids;
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    if (ptype.is_hadron()) {
+      PdgCode pdg = ptype.pdgcode();
+      beam_ids.insert(pdg_map_for_pythia(pdg));
+    }
+  }
+  const double energy_max = mpi_init_energy(sqrts_max);
+  for (double energy = mpi_init_energy(0.); energy <= energy_max;
+       energy *= 2.) {
+    logg[LPythia].info("Initializing Pythia for all beam particles at ",
+                       energy, " GeV");
+    for (int idA : beam_ids) {
+      for (int idB : beam_ids) {
+        create_hard_pythia({idA, idB}, energy);
+      }
+    }
+  }
+}
+
 // compute the formation time and fill the arrays with final-state particles
 int StringProcess::append_final_state(ParticleList &intermediate_particles,
                                       const FourVector &uString,
@@ -205,6 +332,9 @@ int StringProcess::append_final_state(ParticleList &intermediate_particles,
 }
 
 void StringProcess::init(const ParticleList &incoming, double tcoll) {
+  if (reseed_per_collision_) {
+    init_pythia_hadron_rndm();
+  }
   PDGcodes_[0] = incoming[0].pdgcode();
   PDGcodes_[1] = incoming[1].pdgcode();
   massA_ = incoming[0].effective_mass();
@@ -558,28 +688,7 @@ bool StringProcess::next_NDiffHard() {
   // If an entry for the calculated particle IDs does not exist, create one and
   // initialize it accordingly
   if (hard_map_.count(idAB) == 0) {
-    hard_map_[idAB] = make_unique<Pythia8::Pythia>(PYTHIA_XML_DIR, false);
-    hard_map_[idAB]->readString("SoftQCD:nonDiffractive = on");
-    hard_map_[idAB]->readString("MultipartonInteractions:pTmin = 1.5");
-    hard_map_[idAB]->readString("HadronLevel:all = off");
-
-    common_setup_pythia(hard_map_[idAB].get(), strange_supp_, diquark_supp_,
-                        popcorn_rate_, stringz_a_produce_, stringz_b_produce_,
-                        string_sigma_T_);
-
-    hard_map_[idAB]->settings.flag("Beams:allowVariableEnergy", true);
-
-    hard_map_[idAB]->settings.mode("Beams:idA", idAB.first);
-    hard_map_[idAB]->settings.mode("Beams:idB", idAB.second);
-    hard_map_[idAB]->settings.parm("Beams:eCM", sqrtsAB_);
-
-    logg[LPythia].debug("Pythia object initialized with ", pdg_for_pythia[0],
-                        " + ", pdg_for_pythia[1], " at CM energy [GeV] ",
-                        sqrtsAB_);
-
-    if (!hard_map_[idAB]->init()) {
-      throw std::runtime_error("Pythia failed to initialize.");
-    }
+    hard_map_[idAB] = create_hard_pythia(idAB, sqrtsAB_);
   }
 
   const int seed_new = random::uniform_int(1, maximum_rndm_seed_in_pythia);
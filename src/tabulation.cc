@@ -7,7 +7,14 @@
 
 #include "smash/tabulation.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#include "smash/cachefile.h"
+#include "smash/logging.h"
+
 namespace smash {
+static constexpr int LParticleType = LogArea::ParticleType::id;
 
 Tabulation::Tabulation(double x_min, double range, size_t num,
                        std::function<double(double)> f)
@@ -15,11 +22,19 @@ Tabulation::Tabulation(double x_min, double range, size_t num,
   if (num < 2) {
     throw std::runtime_error("Tabulation needs at least two values");
   }
-  values_.resize(num + 1);
+  std::vector<double> values(num + 1);
   const double dx = range / num;
   for (size_t i = 0; i <= num; i++) {
-    values_[i] = f(x_min_ + i * dx);
+    values[i] = f(x_min_ + i * dx);
   }
+  assign_values(std::move(values));
+}
+
+void Tabulation::assign_values(std::vector<double>&& values) {
+  auto owned = std::make_shared<std::vector<double>>(std::move(values));
+  values_ = owned->data();
+  n_values_ = owned->size();
+  storage_ = std::move(owned);
 }
 
 double Tabulation::get_value_step(double x) const {
@@ -28,8 +43,8 @@ double Tabulation::get_value_step(double x) const {
   }
   // this rounds correctly because double -> int conversion truncates
   const unsigned int n = (x - x_min_) * inv_dx_ + 0.5;
-  if (n >= values_.size()) {
-    return values_.back();
+  if (n >= n_values_) {
+    return values_[n_values_ - 1];
   } else {
     return values_[n];
   }
@@ -43,12 +58,12 @@ double Tabulation::get_value_linear(double x, Extrapolation extrapol) const {
     return 0.0;
   }
   if (extrapol == Extrapolation::Const && x > x_max_) {
-    return values_.back();
+    return values_[n_values_ - 1];
   }
   const double index_double = (x - x_min_) * inv_dx_;
   // here n is the lower index
   const size_t n =
-      std::min(static_cast<size_t>(index_double), values_.size() - 2);
+      std::min(static_cast<size_t>(index_double), n_values_ - 2);
   const double r = index_double - n;
   return values_[n] + (values_[n + 1] - values_[n]) * r;
 }
@@ -105,16 +120,16 @@ static size_t sread_size(std::ifstream& stream) {
 }
 
 /**
- * Write binary representation to stream.
+ * Write binary representation of an array of doubles to stream.
  *
  * \param stream Output stream.
- * \param x Value to be written.
+ * \param x Values to be written.
+ * \param n Number of values.
  */
-static void swrite(std::ofstream& stream, const std::vector<double> x) {
-  swrite(stream, x.size());
-  if (x.size() > 0) {
-    stream.write(reinterpret_cast<const char*>(x.data()),
-                 sizeof(x[0]) * x.size());
+static void swrite(std::ofstream& stream, const double* x, size_t n) {
+  swrite(stream, n);
+  if (n > 0) {
+    stream.write(reinterpret_cast<const char*>(x), sizeof(x[0]) * n);
   }
 }
 
@@ -161,7 +176,7 @@ void Tabulation::write(std::ofstream& stream, sha256::Hash hash) const {
   swrite(stream, x_min_);
   swrite(stream, x_max_);
   swrite(stream, inv_dx_);
-  swrite(stream, values_);
+  swrite(stream, values_, n_values_);
 }
 
 Tabulation Tabulation::from_file(std::ifstream& stream, sha256::Hash hash) {
@@ -173,8 +188,114 @@ Tabulation Tabulation::from_file(std::ifstream& stream, sha256::Hash hash) {
   t.x_min_ = sread_double(stream);
   t.x_max_ = sread_double(stream);
   t.inv_dx_ = sread_double(stream);
-  t.values_ = sread_vector(stream);
+  t.assign_values(sread_vector(stream));
   return t;
 }
 
+namespace {
+/// Identifies tabulation archives
+constexpr char archive_magic[8] = {'S', 'M', 'A', 'S', 'H', 'T', 'A', 'B'};
+/// Version of the tabulation archive format
+constexpr std::uint32_t archive_version = 1;
+
+/**
+ * Header of a tabulation archive. It is followed by one ArchiveEntry per
+ * tabulation and then by the tabulated values of all tabulations.
+ */
+struct ArchiveHeader {
+  /// Common header with archive_magic and archive_version
+  CacheFileHeader common;
+  /// Number of tabulations
+  std::uint64_t n_tabulations;
+};
+
+/// Index entry of one tabulation in an archive
+struct ArchiveEntry {
+  /// lower bound of the tabulation
+  double x_min;
+  /// upper bound of the tabulation
+  double x_max;
+  /// inverse step size of the tabulation
+  double inv_dx;
+  /// Index of the first value in the values of the archive
+  std::uint64_t offset;
+  /// Number of values
+  std::uint64_t n_values;
+};
+static_assert(sizeof(ArchiveHeader) % sizeof(double) == 0 &&
+                  sizeof(ArchiveEntry) % sizeof(double) == 0,
+              "The tabulated values in the archive have to be aligned.");
+}  // unnamed namespace
+
+std::vector<Tabulation> Tabulation::map_archive(const std::string& file_name,
+                                                sha256::Hash hash,
+                                                size_t n_tabulations) {
+  const std::size_t index_size =
+      sizeof(ArchiveHeader) + n_tabulations * sizeof(ArchiveEntry);
+  std::size_t size;
+  std::shared_ptr<const void> mapping = map_cache_file(
+      file_name,
+      CacheFileHeader::create(archive_magic, archive_version, sizeof(double),
+                              hash),
+      index_size, &size);
+  if (!mapping) {
+    return {};
+  }
+  const ArchiveHeader* header =
+      static_cast<const ArchiveHeader*>(mapping.get());
+  if (header->n_tabulations != n_tabulations) {
+    return {};
+  }
+  const ArchiveEntry* entries =
+      reinterpret_cast<const ArchiveEntry*>(header + 1);
+  const double* values = reinterpret_cast<const double*>(entries +
+                                                         n_tabulations);
+  const std::size_t n_values = (size - index_size) / sizeof(double);
+  std::vector<Tabulation> tabulations(n_tabulations);
+  for (size_t i = 0; i < n_tabulations; i++) {
+    const ArchiveEntry& entry = entries[i];
+    if (entry.n_values < 2 || entry.offset > n_values ||
+        entry.n_values > n_values - entry.offset) {
+      return {};
+    }
+    Tabulation& t = tabulations[i];
+    t.x_min_ = entry.x_min;
+    t.x_max_ = entry.x_max;
+    t.inv_dx_ = entry.inv_dx;
+    t.values_ = values + entry.offset;
+    t.n_values_ = entry.n_values;
+    t.storage_ = mapping;
+  }
+  return tabulations;
+}
+
+bool Tabulation::save_archive(const std::string& file_name,
+                              sha256::Hash hash,
+                              const std::vector<Tabulation>& tabulations) {
+  ArchiveHeader header;
+  header.common = CacheFileHeader::create(archive_magic, archive_version,
+                                          sizeof(double), hash);
+  header.n_tabulations = tabulations.size();
+  std::vector<ArchiveEntry> entries;
+  entries.reserve(tabulations.size());
+  std::uint64_t offset = 0;
+  for (const Tabulation& t : tabulations) {
+    entries.push_back({t.x_min_, t.x_max_, t.inv_dx_, offset, t.n_values_});
+    offset += t.n_values_;
+  }
+  const bool saved = save_cache_file(file_name, [&](std::ofstream& file) {
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               entries.size() * sizeof(ArchiveEntry));
+    for (const Tabulation& t : tabulations) {
+      file.write(reinterpret_cast<const char*>(t.values_),
+                 t.n_values_ * sizeof(double));
+    }
+  });
+  if (!saved) {
+    logg[LParticleType].warn("Could not save the tabulations to ", file_name);
+  }
+  return saved;
+}
+
 }  // namespace smash
@@ -0,0 +1,107 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include "../include/smash/actionarena.h"
+#include "../include/smash/actions.h"
+#include "../include/smash/decayaction.h"
+#include "../include/smash/deferredoutput.h"
+
+using namespace smash;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(heap_outside_of_scope) {
+  ActionArena arena;
+  {
+    const ActionPtr action = make_unique<DecayAction>(Test::smashon(), 1.);
+    const CollisionBranchPtr branch = make_unique<CollisionBranch>(
+        ParticleType::find(0x661), 1., ProcessType::Elastic);
+  }
+  COMPARE(arena.stats().allocations, 0u);
+  COMPARE(arena.capacity(), 0u);
+}
+
+TEST(allocate_reuse_and_release) {
+  ActionArena arena;
+  const ParticleType &type = ParticleType::find(0x661);
+  {
+    ActionArena::Scope scope(&arena);
+    ActionPtr first = make_unique<DecayAction>(Test::smashon(), 1.);
+    const CollisionBranchPtr branch =
+        make_unique<CollisionBranch>(type, 2., ProcessType::Elastic);
+    COMPARE(arena.stats().allocations, 2u);
+    COMPARE(arena.stats().reused, 0u);
+    COMPARE(arena.capacity(), ActionArena::block_size);
+    COMPARE(branch->weight(), 2.);
+
+    // The memory of a freed action is reused for the next one
+    const void *memory = first.get();
+    first.reset();
+    const ActionPtr second = make_unique<DecayAction>(Test::smashon(), 2.);
+    COMPARE(static_cast<const void *>(second.get()), memory);
+    COMPARE(arena.stats().reused, 1u);
+    COMPARE(second->time_of_execution(), 2.);
+
+    // Recorded actions are kept on the heap
+    const ActionPtr recorded = make_unique<RecordedAction>(*second);
+    COMPARE(arena.stats().allocations, 3u);
+  }
+  // Outside of the scope, the arena is not used
+  const ActionPtr heap = make_unique<DecayAction>(Test::smashon(), 1.);
+  COMPARE(arena.stats().allocations, 3u);
+
+  arena.release();
+  COMPARE(arena.stats().allocations, 0u);
+  COMPARE(arena.stats().bytes, 0u);
+  COMPARE(arena.capacity(), ActionArena::block_size);
+}
+
+TEST(many_actions) {
+  ActionArena arena;
+  for (int step = 0; step < 3; step++) {
+    ActionArena::Scope scope(&arena);
+    Actions actions(&arena);
+    actions.clear();
+    for (int i = 0; i < 1000; i++) {
+      actions.insert(make_unique<DecayAction>(Test::smashon(), 0.001 * i));
+    }
+    COMPARE(arena.stats().allocations, 1000u);
+    VERIFY(arena.capacity() >= arena.stats().bytes);
+    COMPARE(actions.pop()->time_of_execution(), 0.);
+  }
+  // The blocks of the first step are reused by the following ones
+  const std::size_t capacity = arena.capacity();
+  {
+    ActionArena::Scope scope(&arena);
+    Actions actions(&arena);
+    actions.clear();
+    actions.insert(make_unique<DecayAction>(Test::smashon(), 1.));
+  }
+  COMPARE(arena.capacity(), capacity);
+}
+
+TEST(nested_scopes) {
+  ActionArena outer, inner;
+  ActionArena::Scope outer_scope(&outer);
+  {
+    ActionArena::Scope inner_scope(&inner);
+    const ActionPtr action = make_unique<DecayAction>(Test::smashon(), 1.);
+    {
+      ActionArena::Scope heap_scope(nullptr);
+      const ActionPtr on_heap = make_unique<DecayAction>(Test::smashon(), 1.);
+    }
+  }
+  const ActionPtr action = make_unique<DecayAction>(Test::smashon(), 1.);
+  COMPARE(inner.stats().allocations, 1u);
+  COMPARE(outer.stats().allocations, 1u);
+}
@@ -15,6 +15,7 @@
 
 #include "../include/smash/actions.h"
 #include "../include/smash/decayaction.h"
+#include "../include/smash/particles.h"
 
 using namespace smash;
 
@@ -65,3 +66,86 @@ TEST(construct_and_insert) {
 
   VERIFY(actions.is_empty());
 }
+
+TEST(invalidate) {
+  Particles particles;
+  const ParticleData a = particles.insert(Test::smashon());
+  const ParticleData b = particles.insert(Test::smashon());
+
+  Actions actions;
+  actions.insert(make_unique<DecayAction>(a, 1.));
+  actions.insert(make_unique<DecayAction>(b, 2.));
+  actions.insert(make_unique<DecayAction>(a, 3.));
+  actions.insert(make_unique<DecayAction>(b, 4.));
+  COMPARE(actions.size(), 4u);
+
+  // Nothing is invalidated, as long as the particles are valid
+  COMPARE(actions.invalidate({a, b}, particles), 0u);
+  COMPARE(actions.size(), 4u);
+
+  particles.remove(a);
+  COMPARE(actions.invalidate({a, b}, particles), 2u);
+  // The actions of the removed particle are never popped
+  COMPARE(actions.size(), 2u);
+  COMPARE(actions.earliest_time(), 2.);
+  COMPARE(actions.pop()->time_of_execution(), 2.);
+  COMPARE(actions.pop()->time_of_execution(), 4.);
+  VERIFY(actions.is_empty());
+  // Invalidating a particle again has no effect
+  COMPARE(actions.invalidate({a}, particles), 0u);
+
+  const Actions::Stats &stats = actions.stats();
+  COMPARE(stats.inserted, 4u);
+  COMPARE(stats.invalidated, 2u);
+  COMPARE(stats.compactions, 0u);
+  COMPARE(stats.max_heap_size, 4u);
+  COMPARE(stats.discard_ratio(), 0.5);
+}
+
+TEST(invalidate_count_until) {
+  Particles particles;
+  const ParticleData a = particles.insert(Test::smashon());
+  const ParticleData b = particles.insert(Test::smashon());
+
+  Actions actions;
+  actions.insert(make_unique<DecayAction>(a, 1.));
+  actions.insert(make_unique<DecayAction>(a, 2.));
+  actions.insert(make_unique<DecayAction>(b, 3.));
+  particles.remove(a);
+  // Only the actions up to the given time are counted, but all are dropped
+  COMPARE(actions.invalidate({a}, particles, 1.5), 1u);
+  COMPARE(actions.size(), 1u);
+  COMPARE(actions.stats().invalidated, 2u);
+  COMPARE(actions.pop()->time_of_execution(), 3.);
+}
+
+TEST(compact) {
+  Particles particles;
+  const ParticleData removed = particles.insert(Test::smashon());
+  const ParticleData kept = particles.insert(Test::smashon());
+
+  Actions actions;
+  for (int i = 0; i < 10; i++) {
+    actions.insert(make_unique<DecayAction>(kept, 1. + i));
+  }
+  // The actions of the removed particle are not on top of the heap
+  for (int i = 0; i < 200; i++) {
+    actions.insert(make_unique<DecayAction>(removed, 100. + i));
+  }
+  particles.remove(removed);
+  COMPARE(actions.invalidate({removed}, particles), 200u);
+  COMPARE(actions.size(), 10u);
+  COMPARE(actions.stats().compactions, 1u);
+  COMPARE(actions.stats().max_heap_size, 210u);
+
+  // Freed slots are reused by new actions
+  actions.insert(make_unique<DecayAction>(kept, 0.5));
+  for (int i = 0; i < 11; i++) {
+    VERIFY(!actions.is_empty());
+    actions.pop();
+  }
+  VERIFY(actions.is_empty());
+
+  actions.clear();
+  COMPARE(actions.stats().inserted, 0u);
+}
@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "../include/smash/asciibuffer.h"
+#include "../include/smash/file.h"
+#include "../include/smash/random.h"
+
+using namespace smash;
+
+static const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  bf::create_directories(testoutputpath);
+  VERIFY(bf::exists(testoutputpath));
+}
+
+/// Compare format_g to std::printf.
+static void compare_g(double x, int precision) {
+  char expected[64];
+  std::snprintf(expected, sizeof(expected), "%.*g", precision, x);
+  char result[max_formatted_length];
+  char *end = format_g(x, precision, result);
+  COMPARE(std::string(result, end), std::string(expected))
+      << "precision " << precision;
+}
+
+TEST(special_values) {
+  const double inf = std::numeric_limits<double>::infinity();
+  for (const double x :
+       {0., -0., 1., -1., 0.5, 2.5, 1e-5, 0.00012345, 9.999995, 99999.95,
+        999999.5, 123456789., 1e22, 1e-22, 1e300, 5e-324, inf, -inf,
+        std::numeric_limits<double>::quiet_NaN()}) {
+    for (int precision = 0; precision <= 12; precision++) {
+      compare_g(x, precision);
+    }
+  }
+}
+
+TEST(random_values) {
+  for (int i = 0; i < 100000; i++) {
+    const double x =
+        random::uniform(-1., 1.) * std::pow(10., random::uniform_int(-30, 30));
+    compare_g(x, 6);
+    compare_g(x, 9);
+    // Numbers with few decimal digits are often ties
+    const double decimal = std::round(x * 1e4) / 1e4;
+    compare_g(decimal, 3);
+    compare_g(decimal, 6);
+  }
+}
+
+TEST(integers) {
+  for (const int x : {0, 1, -1, 42, -1000, std::numeric_limits<int>::max(),
+                      std::numeric_limits<int>::min()}) {
+    char result[max_formatted_length];
+    char *end = format_int(x, result);
+    COMPARE(std::string(result, end), std::to_string(x));
+  }
+}
+
+TEST(buffer) {
+  const bf::path path = testoutputpath / "asciibuffer.txt";
+  std::string expected;
+  {
+    FilePtr file = fopen(path, "w");
+    AsciiBuffer buffer(file.get());
+    // More text than fits into the buffer
+    for (int i = 0; i < 20000; i++) {
+      buffer.append(i);
+      buffer.append(' ');
+      buffer.append_g(0.1 * i, 6);
+      buffer.printf(" %s\n", "line");
+      char line[64];
+      std::snprintf(line, sizeof(line), "%i %g line\n", i, 0.1 * i);
+      expected += line;
+    }
+    const std::string long_string(2 * AsciiBuffer::capacity, 'x');
+    buffer.append(long_string);
+    buffer.printf("%s", long_string.c_str());
+    expected += long_string + long_string;
+  }
+  FilePtr file = fopen(path, "r");
+  std::string content;
+  char c;
+  while (std::fread(&c, 1, 1, file.get()) == 1) {
+    content += c;
+  }
+  COMPARE(content, expected);
+}
@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "../include/smash/asyncfilewriter.h"
+#include "../include/smash/file.h"
+
+using namespace smash;
+
+static const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+
+TEST(directory_is_created) {
+  bf::create_directories(testoutputpath);
+  VERIFY(bf::exists(testoutputpath));
+}
+
+/// Read the whole file.
+static std::vector<char> read_file(const bf::path &path) {
+  FilePtr file = fopen(path, "rb");
+  std::vector<char> content;
+  char c;
+  while (std::fread(&c, 1, 1, file.get()) == 1) {
+    content.push_back(c);
+  }
+  return content;
+}
+
+TEST(same_content) {
+  const bf::path path = testoutputpath / "asyncfilewriter.bin";
+  std::vector<char> expected;
+  {
+    FilePtr file = fopen(path, "wb");
+    // Small blocks and few pending blocks make the writer wait
+    AsyncFileWriter writer(file.get(), 64, 2);
+    for (std::int32_t i = 0; i < 10000; i++) {
+      writer.write(&i, sizeof(i));
+      const char *bytes = reinterpret_cast<const char *>(&i);
+      expected.insert(expected.end(), bytes, bytes + sizeof(i));
+      if (i % 1000 == 0) {
+        writer.flush();
+      }
+    }
+    // Data larger than a block
+    const std::vector<char> large(1000, 'x');
+    writer.write(large.data(), large.size());
+    expected.insert(expected.end(), large.begin(), large.end());
+    writer.sync();
+    COMPARE(read_file(path), expected);
+
+    writer.write("end", 3);
+    expected.insert(expected.end(), {'e', 'n', 'd'});
+  }
+  COMPARE(read_file(path), expected);
+}
+
+TEST_CATCH(zero_block_size, std::invalid_argument) {
+  FilePtr file = fopen(testoutputpath / "asyncfilewriter.bin", "wb");
+  AsyncFileWriter writer(file.get(), 0);
+}
+
+TEST_CATCH(write_error, std::runtime_error) {
+  // Writing to a file opened for reading fails
+  FilePtr file = fopen(testoutputpath / "asyncfilewriter.bin", "rb");
+  AsyncFileWriter writer(file.get());
+  writer.write("x", 1);
+  writer.sync();
+}
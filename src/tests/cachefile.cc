@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2020
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include "../include/smash/cachefile.h"
+
+using namespace smash;
+
+static const bf::path testoutputpath = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+
+static constexpr char test_magic[8] = {'S', 'M', 'A', 'S', 'H', 'T', 'S', 'T'};
+
+TEST(directory_is_created) {
+  bf::create_directories(testoutputpath);
+  VERIFY(bf::exists(testoutputpath));
+}
+
+TEST(save_and_map) {
+  const std::string path = (testoutputpath / "cachefile.bin").native();
+  sha256::Hash hash;
+  hash.fill(7);
+  const CacheFileHeader header =
+      CacheFileHeader::create(test_magic, 1, sizeof(double), hash);
+  const double values[] = {1., 2., 3.};
+  VERIFY(save_cache_file(path, [&](std::ofstream &file) {
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(values), sizeof(values));
+  }));
+  // The temporary file has been renamed
+  COMPARE(std::distance(bf::directory_iterator(testoutputpath),
+                        bf::directory_iterator()),
+          1);
+
+  std::size_t size = 0;
+  std::shared_ptr<const void> mapping =
+      map_cache_file(path, header, sizeof(header), &size);
+  VERIFY(mapping != nullptr);
+  COMPARE(size, sizeof(header) + sizeof(values));
+  const double *mapped = reinterpret_cast<const double *>(
+      static_cast<const CacheFileHeader *>(mapping.get()) + 1);
+  COMPARE(mapped[0], 1.);
+  COMPARE(mapped[2], 3.);
+
+  // Too small, other version or other hash
+  VERIFY(!map_cache_file(path, header, size + 1, &size));
+  VERIFY(!map_cache_file(
+      path, CacheFileHeader::create(test_magic, 2, sizeof(double), hash),
+      sizeof(header), &size));
+  sha256::Hash other_hash = hash;
+  other_hash[0] = 0;
+  VERIFY(!map_cache_file(
+      path, CacheFileHeader::create(test_magic, 1, sizeof(double), other_hash),
+      sizeof(header), &size));
+  bf::remove(path);
+}
+
+TEST(missing_file) {
+  sha256::Hash hash;
+  hash.fill(7);
+  std::size_t size = 0;
+  VERIFY(!map_cache_file(
+      (testoutputpath / "missing.bin").native(),
+      CacheFileHeader::create(test_magic, 1, sizeof(double), hash), 0, &size));
+}
+
+TEST(failed_save) {
+  VERIFY(!save_cache_file((testoutputpath / "missing" / "file.bin").native(),
+                          [](std::ofstream &file) { file << "content"; }));
+  VERIFY(!bf::exists(testoutputpath / "missing"));
+}
@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <string>
+#include <vector>
+
+#include "../include/smash/clock.h"
+#include "../include/smash/deferredoutput.h"
+#include "../include/smash/wallcrossingaction.h"
+
+using namespace smash;
+using smash::Test::Position;
+
+namespace {
+/// Output that logs the calls it receives as strings.
+class LoggingOutput : public OutputInterface {
+ public:
+  explicit LoggingOutput(std::string name) : OutputInterface(name) {}
+
+  void at_eventstart(const Particles &particles, const int event_number,
+                     const EventInfo &) override {
+    calls.push_back("start " + std::to_string(event_number) + ids(particles));
+  }
+  void at_eventend(const Particles &particles, const int event_number,
+                   const EventInfo &) override {
+    calls.push_back("end " + std::to_string(event_number) + ids(particles));
+  }
+  void at_interaction(const Action &action, const double density) override {
+    calls.push_back("interaction " +
+                    std::to_string(action.incoming_particles()[0].id()) + " " +
+                    std::to_string(density));
+  }
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &,
+                            const EventInfo &) override {
+    calls.push_back("time " + std::to_string(clock->current_time()) +
+                    ids(particles));
+  }
+
+  std::vector<std::string> calls;
+
+ private:
+  static std::string ids(const Particles &particles) {
+    std::string result;
+    for (const ParticleData &p : particles) {
+      result += " " + std::to_string(p.id());
+    }
+    return result;
+  }
+};
+}  // unnamed namespace
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(recording_output_replays_calls) {
+  LoggingOutput direct("Particles"), replayed("Particles");
+  RecordingOutput recorder(replayed);
+
+  Particles particles;
+  particles.insert(Test::smashon(Position{0., 1., 0., 0.}));
+  particles.insert(Test::smashon(Position{0., 2., 0., 0.}));
+  particles.insert(Test::smashon(Position{0., 3., 0., 0.}));
+  // Make sure that the ids are not simply renumbered when replaying
+  particles.remove(particles.front());
+  const EventInfo info = Test::default_event_info();
+  const ExperimentParameters parameters = Test::default_parameters();
+  const DensityParameters dens_param(parameters);
+  const std::unique_ptr<Clock> clock = make_unique<UniformClock>(1.5, 0.1);
+  const ParticleData &first = particles.front();
+  WallcrossingAction action(first, first);
+
+  for (OutputInterface *out :
+       std::vector<OutputInterface *>{&direct, &recorder}) {
+    out->at_eventstart(particles, 3, info);
+    out->at_interaction(action, 0.25);
+    out->at_intermediate_time(particles, clock, dens_param, info);
+    out->at_eventend(particles, 3, info);
+  }
+  COMPARE(replayed.calls.size(), 0u);
+
+  const auto calls = recorder.release_recorded();
+  RecordingOutput::replay(calls, &replayed);
+  COMPARE(direct.calls.size(), 4u);
+  COMPARE(replayed.calls.size(), direct.calls.size());
+  for (size_t i = 0; i < direct.calls.size(); i++) {
+    COMPARE(replayed.calls[i], direct.calls[i]);
+  }
+  COMPARE(direct.calls[0], "start 3 1 2");
+
+  // Everything was handed over
+  COMPARE(recorder.release_recorded().size(), 0u);
+}
+
+TEST(recording_output_imitates_category) {
+  LoggingOutput dileptons("Dileptons"), photons("Photons"), ic("SMASH_IC"),
+      particles("Particles");
+  VERIFY(RecordingOutput(dileptons).is_dilepton_output());
+  VERIFY(RecordingOutput(photons).is_photon_output());
+  VERIFY(RecordingOutput(ic).is_IC_output());
+  const RecordingOutput other(particles);
+  VERIFY(!other.is_dilepton_output());
+  VERIFY(!other.is_photon_output());
+  VERIFY(!other.is_IC_output());
+}
+
+TEST(deferred_output_flushes_interactions) {
+  LoggingOutput target("Collisions");
+  DeferredOutput deferred(&target);
+  const ParticleData a = Test::smashon(Position{0., 1., 0., 0.}, 5);
+  const ParticleData b = Test::smashon(Position{0., 2., 0., 0.}, 7);
+  WallcrossingAction first(a, a), second(b, b);
+  deferred.at_interaction(first, 0.5);
+  deferred.at_interaction(second, 1.5);
+  COMPARE(target.calls.size(), 0u);
+  deferred.flush();
+  COMPARE(target.calls.size(), 2u);
+  COMPARE(target.calls[0], "interaction 5 " + std::to_string(0.5));
+  COMPARE(target.calls[1], "interaction 7 " + std::to_string(1.5));
+  deferred.flush();
+  COMPARE(target.calls.size(), 2u);
+}
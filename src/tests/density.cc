@@ -24,6 +24,7 @@
 #include "../include/smash/modusdefault.h"
 #include "../include/smash/nucleus.h"
 #include "../include/smash/thermodynamicoutput.h"
+#include "../include/smash/threadpool.h"
 
 using namespace smash;
 
@@ -326,6 +327,129 @@ TEST(current_curl_in_rotating_box) {
   COMPARE_ABSOLUTE_ERROR(rot_j_T_over_z, 0., 0.01);
 }
 
+TEST(currents_at_cell_centers) {
+  // Particles of several types, partly outside of the lattice
+  auto random_position = random::make_uniform_distribution(-6.0, 6.0);
+  auto random_momentum = random::make_uniform_distribution(-1.0, 1.0);
+  const std::vector<PdgCode> pdgs = {0x2212, -0x2212, 0x2112, 0x211, -0x211};
+  std::vector<Particles> ensembles(2);
+  for (int i = 0; i < 100; i++) {
+    ParticleData p{ParticleType::find(pdgs[i % pdgs.size()])};
+    p.set_4position(
+        {0., random_position(), random_position(), random_position()});
+    p.set_4momentum(p.pole_mass(), {random_momentum(), random_momentum(),
+                                    random_momentum()});
+    ensembles[i % 2].insert(p);
+  }
+  const ExperimentParameters exp_par = smash::Test::default_parameters();
+  const DensityParameters par(exp_par);
+  const std::array<DensityType, 3> dens_types = {
+      DensityType::Charge, DensityType::Baryon, DensityType::Pion};
+  for (const bool periodic : {false, true}) {
+    const RectangularLattice<DensityOnLattice> lattice(
+        {8., 6., 10.}, {8, 4, 10}, {-4., -3., -5.}, periodic,
+        LatticeUpdate::AtOutput);
+    for (const bool smearing : {true, false}) {
+      const auto currents = currents_at_cell_centers(lattice, ensembles, par,
+                                                     dens_types, smearing);
+      COMPARE(currents.size(), lattice.size());
+      for (size_t cell = 0; cell < lattice.size(); cell++) {
+        const ThreeVector r = lattice.cell_center(cell);
+        for (size_t i = 0; i < dens_types.size(); i++) {
+          FourVector expected;
+          for (const Particles &particles : ensembles) {
+            expected += std::get<1>(current_eckart(r, particles, par,
+                                                   dens_types[i], false,
+                                                   smearing));
+          }
+          for (int l = 0; l < 4; l++) {
+            COMPARE_ABSOLUTE_ERROR(currents[cell][i][l], expected[l], 1.e-12)
+                << "cell " << cell << ", type " << i << ", smearing "
+                << smearing;
+          }
+        }
+      }
+    }
+  }
+}
+
+// create experiment parameters with the given smearing mode
+static ExperimentParameters parameters_with_smearing(SmearingMode smearing) {
+  return ExperimentParameters{
+      make_unique<UniformClock>(0., 0.1),    // labclock
+      make_unique<UniformClock>(0., 1.),     // outputclock
+      1,                                     // ensembles
+      1,                                     // ensemble threads
+      1,                                     // testparticles
+      DerivativesMode::CovariantGaussian,    // derivatives mode
+      RestFrameDensityDerivativesMode::Off,  // rest frame derivatives mode
+      FieldDerivativesMode::ChainRule,       // field derivatives mode
+      smearing,                              // smearing mode
+      1.0,                                   // Gaussian smearing width
+      4.0,                                   // Gaussian smearing cut-off
+      0.333333,                              // discrete smearing weight
+      2.0,                                   // triangular smearing range
+      CollisionCriterion::Geometric,
+      true,  // two_to_one
+      Test::all_reactions_included(),
+      Test::no_multiparticle_reactions(),
+      false,  // strings switch
+      false,  // use_AQM
+      1.0,
+      false,  // string_with_probability
+      NNbarTreatment::NoAnnihilation,
+      0.,     // low energy sigma_NN cut-off
+      false,  // potential_affect_threshold
+      -1.0,   // box_length
+      200.0,  // max. cross section
+      2.5,    // fixed min. cell length
+      false,  // allow collisions within nucleus
+      1.0,    // cross section scaling
+      0.0,    // additional elastic cross section
+      false,  // in thermodynamics outputs spectators are included
+      false   // do weak decays
+  };
+}
+
+TEST(update_lattice_with_threads) {
+  auto random_position = random::make_uniform_distribution(-2.5, 2.5);
+  auto random_momentum = random::make_uniform_distribution(-1.0, 1.0);
+  const std::vector<PdgCode> pdgs = {0x2212, -0x2212, 0x2112};
+  std::vector<Particles> ensembles(2);
+  for (int i = 0; i < 200; i++) {
+    ParticleData p{ParticleType::find(pdgs[i % pdgs.size()])};
+    // Cluster half of the particles in z to get slabs of different sizes
+    const double z = i % 2 ? random_position() : 0.2 * random_position();
+    p.set_4position({0., random_position(), random_position(), z});
+    p.set_4momentum(p.pole_mass(), {random_momentum(), random_momentum(),
+                                    random_momentum()});
+    ensembles[i % 2].insert(p);
+  }
+  ThreadPool pool(3);
+  for (const SmearingMode smearing :
+       {SmearingMode::CovariantGaussian, SmearingMode::Discrete,
+        SmearingMode::Triangular}) {
+    const DensityParameters par(parameters_with_smearing(smearing));
+    for (const bool periodic : {false, true}) {
+      DensityLattice serial({8., 6., 10.}, {8, 6, 20}, {-4., -3., -5.},
+                            periodic, LatticeUpdate::EveryTimestep);
+      DensityLattice threaded({8., 6., 10.}, {8, 6, 20}, {-4., -3., -5.},
+                              periodic, LatticeUpdate::EveryTimestep);
+      update_lattice(&serial, LatticeUpdate::EveryTimestep,
+                     DensityType::Baryon, par, ensembles, true);
+      update_lattice(&threaded, LatticeUpdate::EveryTimestep,
+                     DensityType::Baryon, par, ensembles, true, &pool);
+      // Every node is filled in the same order, so the results are identical
+      for (size_t i = 0; i < serial.size(); i++) {
+        COMPARE(threaded[i].jmu_net(), serial[i].jmu_net()) << i;
+        for (int nu = 0; nu < 4; nu++) {
+          COMPARE(threaded[i].djmu_dxnu()[nu], serial[i].djmu_dxnu()[nu]) << i;
+        }
+      }
+    }
+  }
+}
+
 /*
    This test does not compare anything. It only prints density map versus
    time to vtk files, so that one can open it with paraview and make sure
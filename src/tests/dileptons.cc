@@ -39,6 +39,26 @@ TEST(init_decay_modes) {
       "6.9e-3  0  e⁻ e⁺ γ\n");
 }
 
+TEST(dilepton_widths) {
+  const ParticleType &type_etaz = ParticleType::find(0x221);
+  VERIFY(type_etaz.decay_modes().has_dilepton_modes());
+  COMPARE(type_etaz.decay_modes().dilepton_mode_indices().size(), 1u);
+  VERIFY(!ParticleType::find(0x22).decay_modes().has_dilepton_modes());
+
+  ParticleData etaz{type_etaz};
+  etaz.set_4momentum(type_etaz.mass(), ThreeVector(0.1, 0., 0.));
+  DecayBranchList dil_modes = type_etaz.get_partial_widths(
+      etaz.momentum(), etaz.position().threevec(), WhichDecaymodes::Dileptons);
+  std::vector<std::pair<std::size_t, double>> dil_widths;
+  const bool has_hadronic_modes = type_etaz.get_dilepton_widths(
+      etaz.momentum(), etaz.position().threevec(), &dil_widths);
+  VERIFY(has_hadronic_modes);
+  COMPARE(dil_widths.size(), dil_modes.size());
+  const DecayBranchList &modes = type_etaz.decay_modes().decay_mode_list();
+  COMPARE(&modes[dil_widths[0].first]->type(), &dil_modes[0]->type());
+  COMPARE(dil_widths[0].second, dil_modes[0]->weight());
+}
+
 TEST(pion_decay) {
   // set up a π⁰ at rest
   const ParticleType &type_piz = ParticleType::find(0x111);
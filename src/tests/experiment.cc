@@ -11,12 +11,21 @@
 
 #include <boost/filesystem.hpp>
 
+#include "../include/smash/boxmodus.h"
 #include "../include/smash/collidermodus.h"
+#include "../include/smash/isoparticletype.h"
 #include "setup.h"
 
 using namespace smash;
 
-TEST(init_particle_types) { Test::create_actual_particletypes(); }
+TEST(init_particle_types) {
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+  ParticleType::check_consistency();
+  sha256::Hash hash;
+  hash.fill(0);
+  IsoParticleType::tabulate_integrals(hash, "");
+}
 
 TEST(create_box) {
   VERIFY(!!Test::experiment(
@@ -87,3 +96,47 @@ TEST(access_particles) {
   ParticleList part_list = part->copy_to_vector();
   VERIFY(part_list.size() == 1);
 }
+
+/**
+ * Run one event of a pion box and return the number of discarded actions.
+ *
+ * \param[in] output_interval Time between the intermediate outputs [fm].
+ */
+static uint64_t discarded_in_box(const std::string &output_interval) {
+  const std::string yaml =
+      "General:\n"
+      "  Modus: Box\n"
+      "  End_Time: 10.0\n"
+      "  Delta_Time: 1.0\n"
+      "  Nevents: 1\n"
+      "  Randomseed: 1\n"
+      "Output:\n"
+      "  Output_Interval: " +
+      output_interval +
+      "\n"
+      "Collision_Term:\n"
+      "  Strings: False\n"
+      "Modi: \n"
+      "  Box:\n"
+      "    Initial_Condition: \"thermal momenta\"\n"
+      "    Length: 5.0\n"
+      "    Temperature: 0.2\n"
+      "    Start_Time: 0.0\n"
+      "    Init_Multiplicities:\n"
+      "      211: 200\n"
+      "      -211: 200\n"
+      "      111: 200\n";
+  boost::filesystem::path output_path(".");
+  Experiment<BoxModus> exp(Configuration(yaml.c_str()), output_path);
+  exp.initialize_new_event();
+  exp.run_time_evolution(10.0);
+  return exp.discarded_interactions_total();
+}
+
+TEST(discarded_with_output_within_timestep) {
+  /* Output times in the middle of the time steps must not change the number
+   * of discarded actions, which are counted up to the end of the time step. */
+  const uint64_t discarded = discarded_in_box("1.0");
+  VERIFY(discarded > 0u);
+  COMPARE(discarded_in_box("0.5"), discarded);
+}
@@ -85,10 +85,41 @@ TEST(rest_frame_transformation) {
       node.nq(), eos.net_charge_density(T, mub, mus, muq) * gamma, tolerance);
 }
 
+TEST(rest_frame_transformation_warm_start) {
+  // The rest frame quantities do not depend on the initial approximation
+  Particles P;
+  ExperimentParameters par = smash::Test::default_parameters();
+  par.box_length = 10.0;
+  BoxModus b = create_box_for_tests(par);
+  b.initial_conditions(&P, par);
+
+  HadronGasEos eos = HadronGasEos(false, false);
+  ThermLatticeNode node = ThermLatticeNode();
+  const ThreeVector v_boost(0.3, -0.1, 0.6);
+  const double L = par.box_length;
+  for (auto& part : P) {
+    part.boost(v_boost);
+    node.add_particle(part, std::sqrt(1.0 - v_boost.sqr()) / (L * L * L));
+  }
+  ThermLatticeNode warm_node = node;
+  node.compute_rest_frame_quantities(eos);
+  std::array<double, 4> eos_guess = {0.15, 0.3, 0.05, -0.01};
+  warm_node.compute_rest_frame_quantities(eos, &eos_guess);
+
+  const double tolerance = 1.e-3;
+  COMPARE_ABSOLUTE_ERROR(warm_node.e(), node.e(), tolerance);
+  COMPARE_ABSOLUTE_ERROR(warm_node.p(), node.p(), tolerance);
+  COMPARE_ABSOLUTE_ERROR(warm_node.T(), node.T(), tolerance);
+  COMPARE_ABSOLUTE_ERROR(warm_node.mub(), node.mub(), tolerance);
+  COMPARE_ABSOLUTE_ERROR(warm_node.v().x3(), node.v().x3(), tolerance);
+  COMPARE(eos_guess[0], warm_node.T());
+  COMPARE(eos_guess[1], warm_node.mub());
+}
+
 // Disabled because runtime exceeds maximum test runtime.
 // It can however be executed if the hadron gas EoS table is pre-compiled. To do
 // so, run SMASH once enabling the grandcanonical thermalizer (instructions can
-// be found in the user guide). This produces the file 'hadrongas_eos.dat' in
+// be found in the user guide). This produces the file 'hadgas_eos.bin' in
 // the build directory. From now on, the EoS is read from this specific file
 // whenever the thermalizer is used. You can execute all tests normally,
 // including the `thermalization_action` test below, once the hadron gas file
@@ -469,3 +469,66 @@ TEST(max_positions_normal_grid) {
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0,
                                   CellNumberLimitation::None);
 }
+
+// the ids of the particles in the search cells and neighbor pairs, in order
+template <GridOptions O>
+static std::vector<std::vector<int>> visited_ids(const Grid<O> &grid) {
+  std::vector<std::vector<int>> visited;
+  grid.iterate_cells(
+      [&](const ParticleList &search) {
+        visited.emplace_back();
+        for (const auto &p : search) {
+          visited.back().push_back(p.id());
+        }
+      },
+      [&](const ParticleList &search, const ParticleList &n) {
+        for (const auto &p : search) {
+          for (const auto &p2 : n) {
+            visited.push_back({p.id(), p2.id()});
+          }
+        }
+      });
+  return visited;
+}
+
+TEST(grid_update) {
+  const double min_cell_length = minimal_cell_length(1);
+  using Test::Position;
+  Particles list;
+  for (int i = 0; i < 27; i++) {
+    list.insert(Test::smashon(Position{0., 1.5 * min_cell_length * (i % 3),
+                                       1.5 * min_cell_length * (i / 3 % 3),
+                                       1.5 * min_cell_length * (i / 9)}));
+  }
+  Grid<GridOptions::Normal> grid(list, min_cell_length, timestep,
+                                 CellNumberLimitation::None);
+  const std::pair<std::array<double, 3>, std::array<double, 3>> box = {
+      {0., 0., 0.}, {4. * min_cell_length, 4. * min_cell_length, 10.}};
+  Grid<GridOptions::PeriodicBoundaries> periodic_grid(
+      box, list, min_cell_length, timestep, CellNumberLimitation::None);
+  // the particles move, some of them into other cells, and a few are removed
+  for (int step = 0; step < 3; step++) {
+    for (ParticleData &p : list) {
+      p.set_4position(p.position() +
+                      FourVector(0., 0.4 * min_cell_length, 0.,
+                                 (p.id() % 2) * 0.3 * min_cell_length));
+    }
+    for (ParticleData &p : list) {
+      FourVector position = p.position();
+      for (int i = 1; i < 4; i++) {
+        position[i] = std::fmod(position[i], box.second[i - 1]);
+      }
+      p.set_4position(position);
+    }
+    list.remove(list.front());
+    grid.update(list, min_cell_length, timestep);
+    COMPARE(visited_ids(grid),
+            visited_ids(Grid<GridOptions::Normal>(
+                list, min_cell_length, timestep, CellNumberLimitation::None)));
+    periodic_grid.update(list, min_cell_length, timestep);
+    COMPARE(visited_ids(periodic_grid),
+            visited_ids(Grid<GridOptions::PeriodicBoundaries>(
+                box, list, min_cell_length, timestep,
+                CellNumberLimitation::None)));
+  }
+}
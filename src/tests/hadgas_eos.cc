@@ -40,6 +40,30 @@ TEST(td_simple_gas) {
                          0.7252341309, 1.e-6);
 }
 
+TEST(thermodynamic_sums) {
+  const HadronGasEos eos(false, false);
+  const double T_values[] = {0.02, 0.1, 0.3};
+  for (const double T : T_values) {
+    const double mub = 0.8;
+    const double mus = 0.1;
+    const double muq = -0.05;
+    const HadronGasEos::ThermodynamicSums sums =
+        eos.thermodynamic_sums(T, mub, mus, muq);
+    const double e = HadronGasEos::energy_density(T, mub, mus, muq);
+    const double nb = HadronGasEos::net_baryon_density(T, mub, mus, muq);
+    const double ns = HadronGasEos::net_strange_density(T, mub, mus, muq);
+    const double nq = HadronGasEos::net_charge_density(T, mub, mus, muq);
+    COMPARE_RELATIVE_ERROR(sums.e, e, 1.e-8) << "T = " << T;
+    COMPARE_RELATIVE_ERROR(sums.nb, nb, 1.e-8) << "T = " << T;
+    COMPARE_RELATIVE_ERROR(sums.ns, ns, 1.e-7) << "T = " << T;
+    COMPARE_RELATIVE_ERROR(sums.nq, nq, 1.e-7) << "T = " << T;
+  }
+  const HadronGasEos::ThermodynamicSums zero =
+      eos.thermodynamic_sums(0.0, 0.0, 0.0, 0.0);
+  COMPARE(zero.e, 0.0);
+  COMPARE(zero.nb, 0.0);
+}
+
 TEST(mu_zero_net_strangeness) {
   const double mub = 0.6;
   const double muq = 0.1;
@@ -66,6 +90,31 @@ TEST(solve_EoS_substitute) {
   COMPARE_ABSOLUTE_ERROR(sol[3], muq, 1.e-4);
 }
 
+TEST(solve_EoS_warm_start) {
+  const double mub = 0.2;
+  const double muq = 0.1;
+  const double mus = 0.0;
+  const double T = 0.30;
+  const double e = HadronGasEos::energy_density(T, mub, mus, muq);
+  const double nb = HadronGasEos::net_baryon_density(T, mub, mus, muq);
+  const double ns = HadronGasEos::net_strange_density(T, mub, mus, muq);
+  const double nq = HadronGasEos::net_charge_density(T, mub, mus, muq);
+  HadronGasEos eos = HadronGasEos(false, false);
+  // The copy has its own solver workspace
+  HadronGasEos eos_copy(eos);
+  const std::array<double, 4> guesses[] = {{0.29, 0.21, 0.01, 0.09},
+                                           {0.0, 0.0, 0.0, 0.0},
+                                           {1.5, -1.0, 1.0, 0.5}};
+  for (const std::array<double, 4>& guess : guesses) {
+    const std::array<double, 4> sol =
+        eos_copy.solve_eos_warm_start(e, nb, ns, nq, guess);
+    COMPARE_ABSOLUTE_ERROR(sol[0], T, 1.e-4);
+    COMPARE_ABSOLUTE_ERROR(sol[1], mub, 1.e-4);
+    COMPARE_ABSOLUTE_ERROR(sol[2], mus, 1.e-4);
+    COMPARE_ABSOLUTE_ERROR(sol[3], muq, 1.e-4);
+  }
+}
+
 TEST(EoS_table) {
   // make a small table of EoS
   HadronGasEos eos = HadronGasEos(false, false);
@@ -84,6 +133,33 @@ TEST(EoS_table) {
   remove("small_test_table_eos.dat");
 }
 
+TEST(EoS_table_file) {
+  // A saved table is mapped from the file instead of being recompiled
+  HadronGasEos eos = HadronGasEos(false, false);
+  EosTable table = EosTable(0.1, 0.05, 0.05, 5, 5, 5);
+  table.compile_table(eos, "small_test_table_eos.bin", 2);
+  EosTable mapped_table = EosTable(0.1, 0.05, 0.05, 5, 5, 5);
+  mapped_table.compile_table(eos, "small_test_table_eos.bin", 2);
+  // A table with another grid does not match the file
+  EosTable other_table = EosTable(0.1, 0.05, 0.05, 4, 5, 5);
+  other_table.compile_table(eos, "small_test_table_eos.bin", 1);
+  for (const double e : {0.15, 0.27}) {
+    for (const double nb : {0.01, 0.09}) {
+      EosTable::table_element x, y, z;
+      table.get(x, e, nb, 0.06);
+      mapped_table.get(y, e, nb, 0.06);
+      other_table.get(z, e, nb, 0.06);
+      COMPARE(x.p, y.p);
+      COMPARE(x.T, y.T);
+      COMPARE(x.mub, y.mub);
+      COMPARE(x.mus, y.mus);
+      COMPARE(x.muq, y.muq);
+      COMPARE(x.T, z.T);
+    }
+  }
+  remove("small_test_table_eos.bin");
+}
+
 /*
 TEST(make_test_table) {
   // To switch on these tests, comment out the previous ones.
@@ -543,3 +543,64 @@ TEST(try_create_particle_func) {
     COMPARE(a.pdgcode(), b.pdgcode());
   }
 }
+
+TEST(particle_list_file_events) {
+  const bf::path filepath = testoutputpath / "particle_list_file";
+  {
+    bf::ofstream file(filepath);
+    file << "#!OSCAR2013 particle_lists t x y z mass p0 px py pz pdg ID "
+            "charge\n"
+         << "# event 0\n"
+         << "0.1 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 0 0\n"
+         << "# event 0 end\n"
+         << "# event 1\n"
+         << "0.2 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 1 0\n"
+         << "0.3 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 2 0\n"
+         << "# event 1 end\n"
+         << "# event 2\n"
+         << "# event 2 end\n";
+  }
+  ParticleListFile file(filepath);
+  COMPARE(file.n_events(), 3u);
+  // The events can be accessed in any order
+  const ParticleListFile::Event &event1 = file.event(1);
+  COMPARE(std::string(event1.begin, event1.end),
+          "# event 1\n"
+          "0.2 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 1 0\n"
+          "0.3 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 2 0\n");
+  COMPARE(event1.first_line, 5);
+  const ParticleListFile::Event &event0 = file.event(0);
+  COMPARE(event0.first_line, 1);
+  COMPARE(std::string(event0.begin, event0.end).substr(0, 11),
+          "#!OSCAR2013");
+  const ParticleListFile::Event &event2 = file.event(2);
+  COMPARE(std::string(event2.begin, event2.end), "# event 2\n");
+
+  // Files without "end" lines contain one event, empty files none
+  {
+    bf::ofstream no_end(filepath);
+    no_end << "0.1 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 0 0";
+  }
+  COMPARE(ParticleListFile(filepath).n_events(), 1u);
+  { bf::ofstream empty(filepath); }
+  COMPARE(ParticleListFile(filepath).n_events(), 0u);
+}
+
+TEST_CATCH(malformed_particle_line, ListModus::LoadFailure) {
+  const bf::path filepath = testoutputpath / "malformed0";
+  {
+    bf::ofstream file(filepath);
+    file << "0.1 1 2 3 0.138 0.2 0.1 -0.1 0.09 111 0 0\n"
+         << "0.1 1 2 3 0.138 0.2 0.1 -0.1 x 111 0 0\n";
+  }
+  std::string list_conf_str = "List:\n";
+  list_conf_str += "    File_Directory: \"";
+  list_conf_str += testoutputpath.native() + "\"\n";
+  list_conf_str += "    File_Prefix: \"malformed\"\n";
+  list_conf_str += "    Shift_Id: 0\n";
+  auto config = Configuration(list_conf_str.c_str());
+  auto par = Test::default_parameters();
+  ListModus list_modus(config, par);
+  Particles particles;
+  list_modus.initial_conditions(&particles, par);
+}
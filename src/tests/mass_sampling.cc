@@ -101,3 +101,31 @@ TEST(omega_decay) {
                     //,"masses_rho_charged.dat"
   );
 }
+
+TEST(tabulated_mass_sampling) {
+  ParticleType::tabulate_mass_sampling(0.02, 128);
+  const ParticleType &type_rho = ParticleType::find(0x113);
+  const double mass_stable = ParticleType::find(0x111).mass();
+
+  // below the pole, at the pole and far above it
+  for (const double srts : {0.85, 0.92, 1.5}) {
+    Histogram1d hist(0.001);
+    const int N_samples = 1E6;
+    for (int i = 0; i < N_samples; i++) {
+      const double m = type_rho.sample_resonance_mass(mass_stable, srts, 1);
+      VERIFY(m >= type_rho.min_mass_spectral());
+      VERIFY(m < srts - mass_stable);
+      hist.add(m);
+    }
+    printf("testing tabulated ρ⁰ distribution at sqrt(s) = %g ...\n", srts);
+    hist.test([&](double m) {
+      double pcm = pCM(srts, mass_stable, m);
+      return type_rho.spectral_function(m) * pcm * blatt_weisskopf_sqr(pcm, 1);
+    });
+  }
+  ParticleType::tabulate_mass_sampling(0., 128);
+}
+
+TEST_CATCH(tabulated_mass_sampling_invalid, std::invalid_argument) {
+  ParticleType::tabulate_mass_sampling(0.02, 1);
+}
@@ -11,10 +11,14 @@
 
 #include <map>
 
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/nucleus.h"
 #include "../include/smash/particles.h"
 #include "../include/smash/pdgcode.h"
 #include "../include/smash/pow.h"
+#include "../include/smash/random.h"
+#include "../include/smash/threadpool.h"
 #include "../include/smash/threevector.h"
 
 namespace particles_txt {
@@ -258,6 +262,64 @@ TEST(Fermi_motion) {
   COMPARE_ABSOLUTE_ERROR(ptot.x3(), 0.0, 1.0e-15) << ptot.x3();
 }
 
+/// Check that two nuclei have the same nucleon positions.
+static void compare_positions(Nucleus &a, Nucleus &b) {
+  auto pb = b.begin();
+  for (auto pa = a.begin(); pa != a.end(); ++pa, ++pb) {
+    COMPARE(pa->position(), pb->position());
+  }
+}
+
+TEST(configuration_pool) {
+  Nucleus lead(list, 2);
+  COMPARE(lead.configuration_pool_size(), 0u);
+  random::set_seed(42);
+  lead.create_configuration_pool(8, nullptr, "");
+  COMPARE(lead.configuration_pool_size(), 8u);
+
+  // The pool does not depend on the number of threads
+  Nucleus lead_threads(list, 2);
+  ThreadPool threads(4);
+  random::set_seed(42);
+  lead_threads.create_configuration_pool(8, &threads, "");
+  random::set_seed(7);
+  lead.arrange_nucleons();
+  random::set_seed(7);
+  lead_threads.arrange_nucleons();
+  compare_positions(lead, lead_threads);
+
+  // The drawn configurations are centered and randomly rotated
+  for (int i = 0; i < 20; i++) {
+    lead.arrange_nucleons();
+    const FourVector middle = lead.center();
+    COMPARE_ABSOLUTE_ERROR(middle.x1(), 0.0, 1e-12);
+    COMPARE_ABSOLUTE_ERROR(middle.x2(), 0.0, 1e-12);
+    COMPARE_ABSOLUTE_ERROR(middle.x3(), 0.0, 1e-12);
+  }
+}
+
+TEST(configuration_pool_file) {
+  const bf::path directory =
+      bf::absolute(SMASH_TEST_OUTPUT_PATH) / "nucleus_pool";
+  bf::create_directories(directory);
+  Nucleus lead(list, 1);
+  random::set_seed(42);
+  lead.create_configuration_pool(4, nullptr, directory.native());
+  VERIFY(!bf::is_empty(directory));
+
+  // Read from the file, so the seed does not matter
+  Nucleus lead_read(list, 1);
+  random::set_seed(43);
+  lead_read.create_configuration_pool(4, nullptr, directory.native());
+  COMPARE(lead_read.configuration_pool_size(), 4u);
+  random::set_seed(7);
+  lead.arrange_nucleons();
+  random::set_seed(7);
+  lead_read.arrange_nucleons();
+  compare_positions(lead, lead_read);
+  bf::remove_all(directory);
+}
+
 TEST(nucleon_density_norm) {
   const std::map<PdgCode, int> deuteron = {{0x2212, 1}, {0x2112, 1}};
   const std::map<PdgCode, int> carbon = {{0x2212, 6}, {0x2112, 6}};
@@ -56,6 +56,81 @@ TEST(phase_space_density) {
   COMPARE_RELATIVE_ERROR(f, f_expected, 1.e-3) << f << " ?= " << f_expected;
 }
 
+/* The phase-space density with the spatial index has to agree with the one
+ * obtained by looping over all particles, also after the particles moved and
+ * were replaced. */
+TEST(indexed_phase_space_density) {
+  Configuration conf = Test::configuration();
+  std::map<PdgCode, int> list = {{0x2212, 79}, {0x2112, 118}};
+  const int Ntest = 10;
+  std::vector<Particles> ensembles(2);
+  for (Particles &particles : ensembles) {
+    Nucleus Au(list, Ntest);
+    Au.set_parameters_automatic();
+    Au.arrange_nucleons();
+    Au.generate_fermi_momenta();
+    Au.copy_particles(&particles);
+  }
+  ExperimentParameters param = smash::Test::default_parameters(Ntest);
+  param.n_ensembles = ensembles.size();
+  PauliBlocker looping(conf["Collision_Term"]["Pauli_Blocking"], param);
+  PauliBlocker indexed(conf["Collision_Term"]["Pauli_Blocking"], param);
+  const PdgCode pdg = 0x2212;
+  const ParticleList disregard = {ensembles[0].front()};
+
+  auto compare_densities = [&]() {
+    for (double x : {0., 2.5, 7., 12.}) {
+      for (double pz : {0., 0.1, 0.2}) {
+        const ThreeVector r(x, 0.5 * x, 0.0), p(0.0, 0.0, pz);
+        const double f = looping.phasespace_dens(r, p, ensembles, pdg,
+                                                 disregard);
+        COMPARE_ABSOLUTE_ERROR(
+            indexed.phasespace_dens(r, p, ensembles, pdg, disregard), f,
+            1.e-12)
+            << "r = " << r << ", p = " << p;
+      }
+    }
+  };
+
+  indexed.build_index(ensembles, 2.);
+  compare_densities();
+
+  // Move the particles less than the allowed drift
+  for (Particles &particles : ensembles) {
+    for (ParticleData &part : particles) {
+      part.set_4position(part.position() + FourVector(1., 1.9, 0., 0.));
+    }
+  }
+  compare_densities();
+
+  // Replace a particle by one at a different place
+  const ParticleList to_remove = {ensembles[1].back()};
+  ParticleData replacement{ParticleType::find(pdg)};
+  replacement.set_4position(FourVector(1., 2.5, 1.25, 0.));
+  replacement.set_4momentum(0.938, 0., 0., 0.1);
+  ParticleList to_add = {replacement};
+  ensembles[1].replace(to_remove, to_add);
+  indexed.update_index(1, to_remove, to_add);
+  compare_densities();
+
+  // The frozen state of the other ensemble during concurrent evolution
+  const std::vector<ParticleList> frozen = {ensembles[0].copy_to_vector(),
+                                            ensembles[1].copy_to_vector()};
+  indexed.build_frozen_index(frozen);
+  const ThreeVector r(2.5, 1.25, 0.), p(0., 0., 0.1);
+  for (int i_ens = 0; i_ens < 2; i_ens++) {
+    COMPARE_ABSOLUTE_ERROR(
+        indexed.phasespace_dens(r, p, ensembles[i_ens], i_ens, frozen, pdg,
+                                disregard),
+        looping.phasespace_dens(r, p, ensembles[i_ens], i_ens, frozen, pdg,
+                                disregard),
+        1.e-12);
+  }
+
+  indexed.clear_index();
+  compare_densities();
+}
+
 /*TEST(phase_space_density_box) {
   Configuration conf(TEST_CONFIG_PATH);
   conf["Modi"]["Box"]["Initial_Condition"] = 1;
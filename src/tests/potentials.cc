@@ -328,6 +328,77 @@ TEST(ensembles_vs_testparticles) {
   VERIFY(a == b) << a << " " << b;
 }
 
+/*
+ * Without lattice, update_momenta only passes the baryons near each particle
+ * to all_forces. The resulting momenta have to be the same as with the forces
+ * from all particles of all ensembles.
+ */
+TEST(update_momenta_from_nearby_particles) {
+  auto random_value = random::make_uniform_distribution(-12.0, +12.0);
+  auto random_momentum = random::make_uniform_distribution(-0.5, +0.5);
+  const std::vector<PdgCode> pdgs = {0x2212, 0x2112, 0x211};
+  std::vector<Particles> ensembles(2);
+  for (int i = 0; i < 600; i++) {
+    ParticleData p{ParticleType::find(pdgs[i % pdgs.size()])};
+    p.set_4position({0., random_value(), random_value(), random_value()});
+    p.set_4momentum(p.pole_mass(), {random_momentum(), random_momentum(),
+                                    random_momentum()});
+    ensembles[i % 2].insert(p);
+  }
+
+  std::string conf_pot =
+      "Potentials:\n"
+      "    Skyrme:\n"
+      "        Skyrme_A: -209.2\n"
+      "        Skyrme_B: 156.4\n"
+      "        Skyrme_Tau: 1.35\n"
+      "    Symmetry:\n"
+      "        S_Pot: 18.0\n";
+  Configuration conf = Test::configuration(conf_pot);
+  ExperimentParameters param = smash::Test::default_parameters();
+  param.n_ensembles = ensembles.size();
+  Potentials pot(conf["Potentials"], param);
+
+  ParticleList all_particles;
+  for (const Particles &particles : ensembles) {
+    const ParticleList list = particles.copy_to_vector();
+    all_particles.insert(all_particles.end(), list.begin(), list.end());
+  }
+  const double dt = 0.1;
+  std::vector<FourVector> expected;
+  for (const ParticleData &p : all_particles) {
+    if (!p.is_baryon()) {
+      expected.push_back(p.momentum());
+      continue;
+    }
+    const auto forces = pot.all_forces(p.position().threevec(), all_particles);
+    const auto scale = pot.force_scale(p.type());
+    const ThreeVector v = p.momentum().velocity();
+    const ThreeVector force =
+        scale.first *
+            (std::get<0>(forces) + v.cross_product(std::get<1>(forces))) +
+        scale.second * p.type().isospin3_rel() *
+            (std::get<2>(forces) + v.cross_product(std::get<3>(forces)));
+    ParticleData updated = p;
+    updated.set_4momentum(p.effective_mass(),
+                          p.momentum().threevec() + force * dt);
+    expected.push_back(updated.momentum());
+  }
+
+  update_momenta(ensembles, dt, pot, nullptr, nullptr, nullptr);
+  auto expected_momentum = expected.begin();
+  for (const Particles &particles : ensembles) {
+    for (const ParticleData &p : particles) {
+      for (int i = 0; i < 4; i++) {
+        COMPARE_ABSOLUTE_ERROR(p.momentum()[i], (*expected_momentum)[i],
+                               1.e-12)
+            << p;
+      }
+      ++expected_momentum;
+    }
+  }
+}
+
 // create experiment parameters for tests with VDF
 static ExperimentParameters default_parameters_vdf(
     int testparticles = 1, double dt = 0.1,
@@ -336,6 +407,7 @@ static ExperimentParameters default_parameters_vdf(
       make_unique<UniformClock>(0., dt),  // labclock
       make_unique<UniformClock>(0., 1.),  // outputclock
       1,                                  // ensembles
+      1,                                  // ensemble threads
       testparticles,                      // testparticles
       DerivativesMode::FiniteDifference,  // derivatives mode
       // both the rest frame and the direct derivatives need to be on for the
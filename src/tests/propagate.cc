@@ -92,3 +92,48 @@ TEST(hubble) {
   ExpansionProperties metric4(ExpansionMode::Exponential, 15);
   COMPARE(calc_hubble(10, metric4), 150);
 }
+
+TEST(propagate_with_holes_and_frozen_fermi_motion) {
+  auto P = create_box_particles();
+  // leave a hole in the particle storage
+  P->remove(*(++P->begin()));
+  // the particles with id 0 and 1 (removed above) are initial nucleons
+  const std::vector<FourVector> beam_momentum = {
+      FourVector(5.0, 0.0, 0.0, 4.0), FourVector(5.0, 0.0, 0.0, -4.0)};
+  const ParticleList before = P->copy_to_vector();
+  const double dt = propagate_straight_line(P.get(), 2.0, beam_momentum);
+  COMPARE(dt, 2.0);
+  COMPARE(P->size(), before.size());
+  auto it = P->begin();
+  for (const ParticleData &old : before) {
+    COMPARE(it->id(), old.id());
+    COMPARE(it->momentum(), old.momentum());
+    const ThreeVector v =
+        old.id() < 2 ? beam_momentum[old.id()].velocity() : old.velocity();
+    COMPARE(it->position(),
+            FourVector(2.0, old.position().threevec() + 2.0 * v));
+    ++it;
+  }
+}
+
+TEST(expand_space_time) {
+  auto P = create_box_particles();
+  P->remove(*(++P->begin()));
+  const ExperimentParameters param = Test::default_parameters();
+  ExpansionProperties metric(ExpansionMode::MasslessFRW, 0.5);
+  const double h = calc_hubble(param.labclock->current_time(), metric);
+  const double dt = param.labclock->timestep_duration();
+  const ParticleList before = P->copy_to_vector();
+  expand_space_time(P.get(), param, metric);
+  auto it = P->begin();
+  for (const ParticleData &old : before) {
+    const ThreeVector x = old.position().threevec();
+    const ThreeVector p = old.momentum().threevec() * (1. - h * dt);
+    COMPARE(it->position(),
+            FourVector(old.position().x0(), x + h * x * dt));
+    COMPARE(it->momentum(),
+            FourVector(std::sqrt(old.pole_mass() * old.pole_mass() + p * p),
+                       p));
+    ++it;
+  }
+}
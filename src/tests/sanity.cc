@@ -11,6 +11,7 @@
 
 #include "setup.h"
 
+#include "../include/smash/algorithms.h"
 #include "../include/smash/boxmodus.h"
 #include "../include/smash/collidermodus.h"
 #include "../include/smash/configuration.h"
@@ -134,3 +135,39 @@ TEST(sanity_sphere) {
   create_particle_list(P);
   COMPARE(s.impose_boundary_conditions(&P), 0);
 }
+
+TEST(sanity_box_positions) {
+  Configuration conf = Test::configuration();
+  conf["Modi"]["Box"]["Initial_Condition"] = "peaked momenta";
+  conf["Modi"]["Box"]["Length"] = 5.0;
+  conf["Modi"]["Box"]["Temperature"] = 0.13;
+  conf["Modi"]["Box"]["Start_Time"] = 0.2;
+  conf["Modi"]["Box"]["Init_Multiplicities"]["661"] = 10;
+  ExperimentParameters param = smash::Test::default_parameters();
+  param.box_length = 5.0;
+  BoxModus b(conf["Modi"], param);
+  Particles P;
+  create_particle_list(P);
+  // leave a hole in the particle storage (the slow particle is not wrapped)
+  auto slow = P.begin();
+  ++slow;
+  ++slow;
+  P.remove(*slow);
+  ParticleList expected = P.copy_to_vector();
+  int expected_wraps = 0;
+  for (ParticleData &data : expected) {
+    FourVector position = data.position();
+    if (enforce_periodic_boundaries(position.begin() + 1, position.end(),
+                                    5.0)) {
+      expected_wraps++;
+    }
+    data.set_4position(position);
+  }
+  COMPARE(b.impose_boundary_conditions(&P), expected_wraps);
+  COMPARE(expected_wraps, 4);
+  auto it = expected.begin();
+  for (const ParticleData &data : P) {
+    COMPARE(data.position(), it->position());
+    ++it;
+  }
+}
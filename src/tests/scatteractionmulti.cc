@@ -141,6 +141,50 @@ TEST(deuteron_three_to_two) {
          ProcessType::MultiParticleThreeToTwo);
 }
 
+TEST(can_be_incoming) {
+  const MultiParticleReactionsBitSet incl_all_multi_set =
+      MultiParticleReactionsBitSet().set();
+  std::vector<ParticleData> particles;
+  for (const PdgCode pdg :
+       {PdgCode(0x211), PdgCode(-0x211), PdgCode(0x111), PdgCode(0x2212),
+        PdgCode(0x2112), PdgCode(-0x2212), PdgCode(-0x2112), PdgCode(0x3122),
+        PdgCode(0x221), PdgCode(0x223), pdg::d}) {
+    particles.emplace_back(ParticleType::find(pdg));
+    particles.back().set_4momentum(Momentum{2.1, 1.0, 0.3, -0.5});
+  }
+  // whenever reactions are found, all particles have to be accepted
+  int n_reactive = 0;
+  for (const ParticleData &a : particles) {
+    for (const ParticleData &b : particles) {
+      for (const ParticleData &c : particles) {
+        ScatterActionMulti act({a, b, c}, 0.05);
+        act.add_possible_reactions(0.1, 8.0, incl_all_multi_set);
+        if (!act.reaction_channels().empty()) {
+          n_reactive++;
+          for (const ParticleData &data : {a, b, c}) {
+            VERIFY(ScatterActionMulti::can_be_incoming(data.pdgcode(), 3,
+                                                       incl_all_multi_set));
+          }
+        }
+      }
+    }
+  }
+  VERIFY(n_reactive > 0);
+
+  const PdgCode pi_p = 0x211, p = 0x2212, Lambda = 0x3122, eta = 0x221,
+                omega = 0x223;
+  MultiParticleReactionsBitSet only_5to2;
+  only_5to2.set(IncludedMultiParticleReactions::NNbar_5to2);
+  VERIFY(ScatterActionMulti::can_be_incoming(pi_p, 5, only_5to2));
+  VERIFY(!ScatterActionMulti::can_be_incoming(p, 5, only_5to2));
+  VERIFY(!ScatterActionMulti::can_be_incoming(pi_p, 3, only_5to2));
+  VERIFY(!ScatterActionMulti::can_be_incoming(pi_p, 4, only_5to2));
+  VERIFY(ScatterActionMulti::can_be_incoming(Lambda, 4, incl_all_multi_set));
+  VERIFY(!ScatterActionMulti::can_be_incoming(eta, 4, incl_all_multi_set));
+  VERIFY(ScatterActionMulti::can_be_incoming(eta, 3, incl_all_multi_set));
+  VERIFY(!ScatterActionMulti::can_be_incoming(omega, 3, incl_all_multi_set));
+}
+
 TEST(threebody_integral_I3) {
   // Make sure incoming particles got their masses set
   // calculate_I3 uses effective mass , not type mass
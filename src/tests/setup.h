@@ -263,6 +263,7 @@ inline ExperimentParameters default_parameters(
       make_unique<UniformClock>(0., dt),     // labclock
       make_unique<UniformClock>(0., 1.),     // outputclock
       1,                                     // ensembles
+      1,                                     // ensemble threads
       testparticles,                         // testparticles
       DerivativesMode::CovariantGaussian,    // derivatives mode
       RestFrameDensityDerivativesMode::Off,  // rest frame derivatives mode
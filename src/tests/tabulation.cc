@@ -9,6 +9,8 @@
 
 #include <vir/test.h>  // This include has to be first
 
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/tabulation.h"
 
 using namespace smash;
@@ -89,3 +91,34 @@ TEST(quadratic) {
   // check extrapolated values
   COMPARE_ABSOLUTE_ERROR(tab.get_value_linear(3.), 7.8, error);
 }
+
+TEST(archive) {
+  const bf::path directory = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(directory);
+  const std::string file = (directory / "integrals.bin").native();
+  sha256::Hash hash;
+  hash.fill(1);
+  const std::vector<Tabulation> tabs = {
+      Tabulation(0., 10., 10, [](double x) { return x; }),
+      Tabulation(-2., 4., 20, [](double x) { return x * x; })};
+  VERIFY(Tabulation::save_archive(file, hash, tabs));
+
+  // Tabulations with other properties are not found
+  sha256::Hash other_hash;
+  other_hash.fill(2);
+  VERIFY(Tabulation::map_archive(file, other_hash, 2).empty());
+  VERIFY(Tabulation::map_archive(file, hash, 3).empty());
+
+  std::vector<Tabulation> mapped = Tabulation::map_archive(file, hash, 2);
+  COMPARE(mapped.size(), 2u);
+  // The mapped tabulations are kept valid by their copies
+  const Tabulation quadratic = mapped[1];
+  mapped.clear();
+  bf::remove(file);
+  for (double x : {-3., -1.5, 0.3, 1.2, 2., 3.}) {
+    COMPARE(quadratic.get_value_linear(x), tabs[1].get_value_linear(x));
+    COMPARE(quadratic.get_value_step(x), tabs[1].get_value_step(x));
+  }
+  VERIFY(quadratic.covers(1.));
+  VERIFY(!quadratic.covers(3.));
+}
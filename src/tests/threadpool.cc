@@ -0,0 +1,91 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include <stdexcept>
+#include <vector>
+
+#include "../include/smash/threadpool.h"
+
+using namespace smash;
+
+TEST(size) {
+  ThreadPool serial(1);
+  COMPARE(serial.size(), 1);
+  ThreadPool pool(3);
+  COMPARE(pool.size(), 3);
+  ThreadPool automatic(0);
+  VERIFY(automatic.size() >= 1);
+}
+
+TEST(every_task_once) {
+  ThreadPool pool(4);
+  for (int n_tasks : {0, 1, 3, 4, 17, 1000}) {
+    std::vector<int> calls(n_tasks, 0);
+    pool.parallel_for(n_tasks, [&](int i) { calls[i]++; });
+    for (int i = 0; i < n_tasks; i++) {
+      COMPARE(calls[i], 1) << "task " << i << " of " << n_tasks;
+    }
+  }
+}
+
+TEST(repeated_loops) {
+  // The pool is reused many times, as for the time steps of an event.
+  ThreadPool pool(3);
+  std::vector<double> sums(5, 0.);
+  for (int step = 0; step < 500; step++) {
+    pool.parallel_for(5, [&](int i) { sums[i] += i; });
+  }
+  for (int i = 0; i < 5; i++) {
+    COMPARE(sums[i], 500. * i);
+  }
+}
+
+TEST(exception_is_rethrown) {
+  ThreadPool pool(2);
+  std::vector<int> calls(8, 0);
+  bool thrown = false;
+  try {
+    pool.parallel_for(8, [&](int i) {
+      calls[i]++;
+      if (i == 5) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+  // the remaining tasks are still executed
+  for (int i = 0; i < 8; i++) {
+    COMPARE(calls[i], 1);
+  }
+  // and the pool is still usable afterwards
+  int n = 0;
+  pool.parallel_for(1, [&](int) { n++; });
+  COMPARE(n, 1);
+}
+
+TEST(make_thread_pool) {
+  COMPARE(number_of_threads(3, "Threads"), 3);
+  VERIFY(number_of_threads(0, "Threads") >= 1);
+  VERIFY(make_thread_pool(1, "Threads") == nullptr);
+  COMPARE(make_thread_pool(3, "Threads")->size(), 3);
+  // the number of threads is limited by the maximum
+  COMPARE(make_thread_pool(3, "Threads", 2)->size(), 2);
+  VERIFY(make_thread_pool(3, "Threads", 1) == nullptr);
+  bool thrown = false;
+  try {
+    make_thread_pool(-1, "Threads");
+  } catch (std::invalid_argument &) {
+    thrown = true;
+  }
+  VERIFY(thrown);
+}
@@ -0,0 +1,166 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "../include/smash/pdgcode.h"
+#include "../include/smash/threadpool.h"
+#include "../include/smash/totalcrosssectiontable.h"
+
+using namespace smash;
+
+namespace {
+/// A cross section that rises with sqrt(s) and depends on the species.
+double fake_cross_section(const ParticleType &a, const ParticleType &b,
+                          double sqrts) {
+  return 10. * a.mass() + b.mass() + std::sqrt(sqrts);
+}
+}  // unnamed namespace
+
+TEST(init_particle_types) {
+  Test::create_actual_particletypes();
+  Test::create_actual_decaymodes();
+}
+
+TEST(bounds_cross_section) {
+  TotalCrossSectionTable table(fake_cross_section);
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  for (double sqrts = 1.2; sqrts < 5.; sqrts += 0.0123) {
+    const double bound = table.upper_bound(pion, proton, sqrts);
+    const double xs = fake_cross_section(pion, proton, sqrts);
+    VERIFY(bound >= xs) << sqrts;
+    VERIFY(bound <= TotalCrossSectionTable::safety_factor *
+                        fake_cross_section(pion, proton, sqrts +
+                                           TotalCrossSectionTable::bin_width))
+        << sqrts;
+    // The order of the species matters
+    VERIFY(table.upper_bound(proton, pion, sqrts) >=
+           fake_cross_section(proton, pion, sqrts))
+        << sqrts;
+  }
+}
+
+TEST(bounds_broad_peaks) {
+  /* Narrowest Breit-Wigner peak, which the bounds cover, see the
+   * documentation of TotalCrossSectionTable */
+  const double sample_distance = TotalCrossSectionTable::bin_width /
+                                 TotalCrossSectionTable::samples_per_bin;
+  const double width =
+      1.001 * sample_distance /
+      std::sqrt(TotalCrossSectionTable::safety_factor - 1.);
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  // Move the peak through a whole bin
+  for (int k = 0; k < 50; k++) {
+    const double peak = 1.5 + 0.0001 * k;
+    auto peaked_cross_section = [&](const ParticleType &, const ParticleType &,
+                                    double sqrts) {
+      const double x = 2. * (sqrts - peak) / width;
+      return 10. / (1. + x * x);
+    };
+    TotalCrossSectionTable table(peaked_cross_section);
+    for (double sqrts = peak - 0.02; sqrts < peak + 0.02; sqrts += 0.0001) {
+      VERIFY(table.upper_bound(pion, proton, sqrts) >=
+             peaked_cross_section(pion, proton, sqrts))
+          << "peak " << peak << ", sqrt(s) " << sqrts;
+    }
+  }
+}
+
+TEST(bins_are_evaluated_once) {
+  int n_calls = 0;
+  TotalCrossSectionTable table(
+      [&](const ParticleType &a, const ParticleType &b, double sqrts) {
+        n_calls++;
+        return fake_cross_section(a, b, sqrts);
+      });
+  const ParticleType &proton = ParticleType::find(0x2212);
+  const double first = table.upper_bound(proton, proton, 3.0001);
+  COMPARE(n_calls, TotalCrossSectionTable::samples_per_bin + 1);
+  COMPARE(table.upper_bound(proton, proton, 3.0002), first);
+  COMPARE(n_calls, TotalCrossSectionTable::samples_per_bin + 1);
+  table.upper_bound(proton, proton, 4.);
+  COMPARE(n_calls, 2 * (TotalCrossSectionTable::samples_per_bin + 1));
+}
+
+TEST(uncovered_pairs) {
+  int n_calls = 0;
+  TotalCrossSectionTable table(
+      [&](const ParticleType &a, const ParticleType &b, double sqrts) {
+        n_calls++;
+        return fake_cross_section(a, b, sqrts);
+      });
+  const ParticleType &proton = ParticleType::find(0x2212);
+  const ParticleType &delta = ParticleType::find(0x2224);
+  VERIFY(!delta.is_stable());
+  const double threshold = 2. * proton.mass();
+  // Unstable particles
+  VERIFY(std::isinf(table.upper_bound(delta, proton, 3.)));
+  VERIFY(std::isinf(table.upper_bound(proton, delta, 3.)));
+  // Close to the threshold
+  VERIFY(std::isinf(table.upper_bound(proton, proton, threshold + 0.001)));
+  VERIFY(std::isinf(table.upper_bound(
+      proton, proton, threshold + TotalCrossSectionTable::threshold_distance)));
+  // Beyond the tabulated range
+  VERIFY(std::isinf(
+      table.upper_bound(proton, proton, TotalCrossSectionTable::max_sqrts)));
+  VERIFY(std::isinf(table.upper_bound(proton, proton, 200.)));
+  COMPARE(n_calls, 0);
+  VERIFY(!std::isinf(table.upper_bound(
+      proton, proton,
+      threshold + TotalCrossSectionTable::threshold_distance +
+          TotalCrossSectionTable::bin_width)));
+}
+
+TEST(narrow_resonances_not_covered) {
+  TotalCrossSectionTable table(fake_cross_section);
+  // The eta' is narrower than the covered peaks and decays into two photons
+  const ParticleType &photon = ParticleType::find(0x22);
+  const ParticleType &eta_prime = ParticleType::find(0x331);
+  const ParticleType &pion = ParticleType::find(0x211);
+  VERIFY(photon.is_stable());
+  VERIFY(!eta_prime.is_stable());
+  VERIFY(std::isinf(table.upper_bound(photon, photon, eta_prime.mass())));
+  VERIFY(std::isinf(table.upper_bound(photon, photon, 3.)));
+  // Other pairs of the photon are still covered
+  VERIFY(!std::isinf(table.upper_bound(photon, pion, 3.)));
+}
+
+TEST(concurrent_lookups) {
+  std::atomic<int> n_calls{0};
+  TotalCrossSectionTable table(
+      [&](const ParticleType &a, const ParticleType &b, double sqrts) {
+        n_calls++;
+        return fake_cross_section(a, b, sqrts);
+      });
+  const ParticleType &pion = ParticleType::find(0x211);
+  const ParticleType &proton = ParticleType::find(0x2212);
+  ThreadPool pool(4);
+  std::atomic<int> n_violations{0};
+  pool.parallel_for(4000, [&](int i) {
+    const double sqrts = 1.5 + 0.001 * (i % 1000);
+    if (table.upper_bound(pion, proton, sqrts) <
+        fake_cross_section(pion, proton, sqrts)) {
+      n_violations++;
+    }
+  });
+  COMPARE(n_violations.load(), 0);
+  // Bins may be evaluated concurrently, but not again afterwards
+  const int n_calls_after_filling = n_calls.load();
+  pool.parallel_for(1000, [&](int i) {
+    table.upper_bound(pion, proton, 1.5 + 0.001 * i);
+  });
+  COMPARE(n_calls.load(), n_calls_after_filling);
+}
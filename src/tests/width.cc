@@ -11,6 +11,11 @@
 
 #include "setup.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/integrate.h"
 
 using namespace smash;
@@ -137,3 +142,75 @@ TEST(photon_widths) {
   COMPARE_ABSOLUTE_ERROR(phi.get_partial_width(phi.mass(), {&pi0, &photon}),
                          5.4068538571729e-6, err);
 }
+
+/* Compare the tabulated total and partial widths with the exact ones for a
+ * given resonance type, allowing for twice the error bound, which is only
+ * checked at the centers of the grid intervals. */
+static void compare_tabulated_widths(const ParticleType &t,
+                                     const double max_error) {
+  const auto &modes = t.decay_modes().decay_mode_list();
+  std::vector<double> masses, exact;
+  std::vector<DecayBranchList> exact_partial;
+  ParticleType::tabulate_widths(0., max_error, {}, "");
+  for (int i = 0; i < 300; i++) {
+    const double m = t.min_mass_kinematic() + i * 0.00731;
+    masses.push_back(m);
+    exact.push_back(t.total_width(m));
+    exact_partial.push_back(t.get_partial_widths(
+        FourVector(m, 0., 0., 0.), ThreeVector(), WhichDecaymodes::All));
+  }
+
+  ParticleType::tabulate_widths(0.005, max_error, {}, "");
+  for (size_t i = 0; i < masses.size(); i++) {
+    const double m = masses[i];
+    const double bound = 2 * max_error * std::max(exact[i], t.width_at_pole());
+    COMPARE_ABSOLUTE_ERROR(t.total_width(m), exact[i], bound)
+        << t.name() << " at m = " << m;
+    const DecayBranchList partial = t.get_partial_widths(
+        FourVector(m, 0., 0., 0.), ThreeVector(), WhichDecaymodes::All);
+    COMPARE(partial.size(), exact_partial[i].size());
+    for (size_t j = 0; j < partial.size(); j++) {
+      const double w = exact_partial[i][j]->weight();
+      const double on_shell = t.width_at_pole() * modes[j]->weight();
+      COMPARE_ABSOLUTE_ERROR(partial[j]->weight(), w,
+                             2 * max_error * std::max(w, on_shell))
+          << t.name() << " mode " << j << " at m = " << m;
+    }
+  }
+  ParticleType::tabulate_widths(0., max_error, {}, "");
+}
+
+TEST(tabulated_widths) {
+  compare_tabulated_widths(ParticleType::find(0x2214), 1e-3);   // Δ
+  compare_tabulated_widths(ParticleType::find(0x12212), 1e-3);  // N(1440)
+  compare_tabulated_widths(ParticleType::find(0x223), 1e-3);    // ω
+  compare_tabulated_widths(ParticleType::find(0x113), 1e-4);    // ρ
+}
+
+TEST(cached_widths) {
+  const bf::path dir = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(dir);
+  const ParticleType &t = ParticleType::find(0x12212);  // N(1440)
+  const bf::path path = dir / ("widths_" + t.pdgcode().string() + ".bin");
+  bf::remove(path);
+  sha256::Hash hash = {};
+  hash[0] = 1;
+
+  ParticleType::tabulate_widths(0.005, 1e-3, hash, dir);
+  const double created = t.total_width(1.2345);
+  VERIFY(bf::exists(path));
+  VERIFY(!bf::exists(dir / "tabulations.lock"));
+
+  // The cached tabulation is read instead of being recreated
+  ParticleType::tabulate_widths(0.005, 1e-3, hash, dir);
+  COMPARE(t.total_width(1.2345), created);
+
+  // Another mass step leads to a new tabulation
+  ParticleType::tabulate_widths(0.007, 1e-3, hash, dir);
+  COMPARE_RELATIVE_ERROR(t.total_width(1.2345), created, 2e-3);
+  ParticleType::tabulate_widths(0., 1e-3, {}, "");
+}
+
+TEST_CATCH(negative_width_mass_step, std::invalid_argument) {
+  ParticleType::tabulate_widths(-0.005, 1e-3, {}, "");
+}
@@ -547,8 +547,6 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
   double result;
   const auto dim = lattice.n_cells();
   std::shared_ptr<std::ofstream> fp(nullptr);
-  FourVector jQ = FourVector(), jB = FourVector(), jS = FourVector();
-  constexpr bool compute_gradient = false;
   if (enable_ascii_) {
     fp = output_ascii_files_[ThermodynamicQuantity::j_QBS];
     *fp << std::setprecision(14);
@@ -560,23 +558,17 @@ void ThermodynamicLatticeOutput::thermodynamics_lattice_output(
     assert(sizeof(ctime) == sizeof(double));
     fp->write(reinterpret_cast<char *>(&ctime), sizeof(ctime));
   }
+  // All three currents are deposited in one pass over the particles.
+  const std::array<DensityType, 3> dens_types = {
+      DensityType::Charge, DensityType::Baryon, DensityType::Strangeness};
+  const std::vector<std::array<FourVector, 3>> currents =
+      currents_at_cell_centers(lattice, ensembles, dens_param, dens_types,
+                               out_par_.td_smearing);
   lattice.iterate_sublattice(
       {0, 0, 0}, dim, [&](DensityOnLattice &, int ix, int iy, int iz) {
-        const ThreeVector position = lattice.cell_center(ix, iy, iz);
-        jQ.reset();
-        jB.reset();
-        jS.reset();
-        for (const Particles &particles : ensembles) {
-          jQ += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Charge,
-              compute_gradient, out_par_.td_smearing));
-          jB += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Baryon,
-              compute_gradient, out_par_.td_smearing));
-          jS += std::get<1>(current_eckart(
-              position, particles, dens_param, DensityType::Strangeness,
-              compute_gradient, out_par_.td_smearing));
-        }
+        const std::array<FourVector, 3> &jQBS =
+            currents[ix + dim[0] * (iy + iz * dim[1])];
+        const FourVector &jQ = jQBS[0], &jB = jQBS[1], &jS = jQBS[2];
         if (enable_ascii_) {
           *fp << jQ[0];
           for (int l = 1; l < 4; l++) {
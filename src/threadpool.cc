@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threadpool.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "smash/cxx14compat.h"
+
+namespace smash {
+
+ThreadPool::ThreadPool(int n_threads) {
+  if (n_threads < 1) {
+    n_threads =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  workers_.reserve(n_threads - 1);
+  for (int i = 1; i < n_threads; i++) {
+    workers_.emplace_back(&ThreadPool::worker_loop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_condition_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallel_for(int n_tasks,
+                              const std::function<void(int)> &task) {
+  if (n_tasks <= 0) {
+    return;
+  }
+  if (workers_.empty() || n_tasks == 1) {
+    for (int i = 0; i < n_tasks; i++) {
+      task(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    n_tasks_ = n_tasks;
+    next_task_ = 0;
+    exception_ = nullptr;
+    busy_workers_ = static_cast<int>(workers_.size());
+    generation_++;
+  }
+  start_condition_.notify_all();
+  work_on_tasks();
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_condition_.wait(lock, [this] { return busy_workers_ == 0; });
+    task_ = nullptr;
+    exception = exception_;
+    exception_ = nullptr;
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::work_on_tasks() {
+  for (int i = next_task_++; i < n_tasks_; i = next_task_++) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_) {
+        exception_ = std::current_exception();
+      }
+    }
+  }
+}
+
+void ThreadPool::worker_loop() {
+  unsigned seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_condition_.wait(lock, [&] {
+        return stop_ || generation_ != seen_generation;
+      });
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+    work_on_tasks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_workers_--;
+    }
+    done_condition_.notify_one();
+  }
+}
+
+int number_of_threads(int n_threads, const char *option) {
+  if (n_threads < 0) {
+    throw std::invalid_argument(std::string(option) +
+                                " cannot be negative.");
+  }
+  if (n_threads == 0) {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  return n_threads;
+}
+
+std::unique_ptr<ThreadPool> make_thread_pool(int n_threads, const char *option,
+                                             int max_threads) {
+  n_threads = std::min(number_of_threads(n_threads, option), max_threads);
+  if (n_threads <= 1) {
+    return nullptr;
+  }
+  return make_unique<ThreadPool>(n_threads);
+}
+
+}  // namespace smash
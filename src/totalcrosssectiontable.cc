@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2022
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/totalcrosssectiontable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "smash/decaymodes.h"
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LFindScatter = LogArea::FindScatter::id;
+
+constexpr double TotalCrossSectionTable::bin_width;
+constexpr double TotalCrossSectionTable::max_sqrts;
+constexpr double TotalCrossSectionTable::threshold_distance;
+constexpr int TotalCrossSectionTable::samples_per_bin;
+constexpr double TotalCrossSectionTable::safety_factor;
+
+TotalCrossSectionTable::TotalCrossSectionTable(
+    TotalCrossSection total_cross_section)
+    : total_cross_section_(std::move(total_cross_section)),
+      n_bins_(static_cast<int>(std::ceil(max_sqrts / bin_width))) {
+  const ParticleTypeList &types = ParticleType::list_all();
+  stable_index_.reserve(types.size());
+  for (const ParticleType &type : types) {
+    stable_index_.push_back(type.is_stable() ? n_stable_++ : -1);
+  }
+  rows_.reset(new std::atomic<Row *>[n_stable_ * n_stable_]);
+  for (int i = 0; i < n_stable_ * n_stable_; i++) {
+    rows_[i].store(nullptr);
+  }
+
+  /* A resonance narrower than the covered peaks, which a pair of stable
+   * species forms within the tabulated range, can exceed the bounds of the
+   * pair. Such pairs are not covered. */
+  const double min_peak_width = bin_width / samples_per_bin /
+                                std::sqrt(safety_factor - 1.);
+  narrow_peak_.assign(n_stable_ * n_stable_, false);
+  const ParticleType *first_type = std::addressof(types[0]);
+  for (const ParticleType &resonance : types) {
+    if (resonance.is_stable() || resonance.width_at_pole() >= min_peak_width ||
+        resonance.mass() >= max_sqrts) {
+      continue;
+    }
+    for (const auto &mode : resonance.decay_modes().decay_mode_list()) {
+      const ParticleTypePtrList &daughters = mode->particle_types();
+      if (daughters.size() != 2) {
+        continue;
+      }
+      const int stable_a =
+          stable_index_[std::addressof(*daughters[0]) - first_type];
+      const int stable_b =
+          stable_index_[std::addressof(*daughters[1]) - first_type];
+      const double threshold =
+          daughters[0]->mass() + daughters[1]->mass() + threshold_distance;
+      if (stable_a < 0 || stable_b < 0 ||
+          resonance.mass() + bin_width <= threshold) {
+        continue;
+      }
+      logg[LFindScatter].info(
+          "The cross section of ", daughters[0]->name(), " + ",
+          daughters[1]->name(), " is not bounded, because the resonance ",
+          resonance.name(), " is narrower than ", min_peak_width, " GeV.");
+      narrow_peak_[stable_a * n_stable_ + stable_b] = true;
+      narrow_peak_[stable_b * n_stable_ + stable_a] = true;
+    }
+  }
+}
+
+double TotalCrossSectionTable::upper_bound(const ParticleType &type_a,
+                                           const ParticleType &type_b,
+                                           double sqrts) {
+  constexpr double not_covered = std::numeric_limits<double>::infinity();
+  const ParticleType *first_type = std::addressof(ParticleType::list_all()[0]);
+  const int stable_a = stable_index_[std::addressof(type_a) - first_type];
+  const int stable_b = stable_index_[std::addressof(type_b) - first_type];
+  if (stable_a < 0 || stable_b < 0 || sqrts >= max_sqrts ||
+      narrow_peak_[stable_a * n_stable_ + stable_b]) {
+    return not_covered;
+  }
+  const int bin = static_cast<int>(sqrts / bin_width);
+  const double bin_start = bin * bin_width;
+  if (bin_start < type_a.mass() + type_b.mass() + threshold_distance) {
+    return not_covered;
+  }
+
+  std::atomic<double> &bound = row(stable_a, stable_b)[bin];
+  double value = bound.load(std::memory_order_relaxed);
+  if (value < 0.) {
+    /* Several threads might evaluate the same bin at the same time, but they
+     * all store the same value. */
+    value = 0.;
+    for (int i = 0; i <= samples_per_bin; i++) {
+      const double sample =
+          bin_start + bin_width * i / static_cast<double>(samples_per_bin);
+      value = std::max(value, total_cross_section_(type_a, type_b, sample));
+    }
+    value *= safety_factor;
+    bound.store(value, std::memory_order_relaxed);
+  }
+  return value;
+}
+
+TotalCrossSectionTable::Row &TotalCrossSectionTable::row(int stable_a,
+                                                         int stable_b) {
+  std::atomic<Row *> &slot = rows_[stable_a * n_stable_ + stable_b];
+  Row *found = slot.load(std::memory_order_acquire);
+  if (found == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    found = slot.load(std::memory_order_relaxed);
+    if (found == nullptr) {
+      created_rows_.emplace_back(new Row(n_bins_));
+      found = created_rows_.back().get();
+      for (std::atomic<double> &bound : *found) {
+        bound.store(-1., std::memory_order_relaxed);
+      }
+      slot.store(found, std::memory_order_release);
+    }
+  }
+  return *found;
+}
+
+}  // namespace smash